@@ -10,20 +10,31 @@
 #include <string.h>
 #include <time.h>
 #include "algoritmos.h"
+#include "hitos.h"
+#include "contadores.h"
+#include "memoria.h"
+#include "medicion.h"
 #include "config.h"
 
+// Rango de nodos para las tablas de estado (-1 = todos)
+static int rango_desde = -1;
+static int rango_hasta = -1;
+
 // ==================== DIJKSTRA CON ESTADOS ====================
 
 /*
- * dijkstra_con_estados
- * Implementa Dijkstra mostrando estados intermedios.
+ * dijkstra_interno
+ * Dijkstra común: muestra estados y/o registra eventos en la traza.
  */
-int* dijkstra_con_estados(grafo_matriz* grafo, int inicio, int fin, 
-                         int* distancia_total, int mostrar_estados) {
+static int* dijkstra_interno(grafo_matriz* grafo, int inicio, int fin, 
+                             int* distancia_total, int mostrar_estados,
+                             traza_dijkstra* traza, int* nodos_expandidos) {
     static int anterior[MAX_NODOS];        // Array de nodos anteriores
     int distancia[MAX_NODOS];              // Distancias mínimas
     int visitado[MAX_NODOS] = {0};         // Nodos procesados
     int iteracion = 0;                     // Contador de iteraciones
+    int expandidos = 0;                    // Nodos procesados
+    INICIAR_FASE(inicio_busqueda);
     
     // Inicializa arrays
     for (int i = 0; i < grafo->num_nodos; i++) {
@@ -58,6 +69,10 @@ int* dijkstra_con_estados(grafo_matriz* grafo, int inicio, int fin,
         
         // Termina si no hay nodos o se llegó al destino
         if (u == -1 || u == fin) {
+            if (traza != NULL) {
+                int d = (u == -1) ? INFINITO : distancia[u];
+                registrar_evento(traza, EVENTO_TERMINAR, u, d, -1, d, -1);
+            }
             if (mostrar_estados) {
                 printf("\n" COLOR_VERDE "=== TERMINANDO TEMPRANO ===\n" COLOR_RESET);
                 printf("Nodo actual: %d, Nodo destino alcanzado: %s\n", 
@@ -67,6 +82,14 @@ int* dijkstra_con_estados(grafo_matriz* grafo, int inicio, int fin,
         }
         
         visitado[u] = 1;    // Marca nodo como procesado
+        expandidos++;
+        CONTAR(nodos_expandidos);
+        CONTAR(operaciones_cola);    // Extracción del mínimo
+        
+        if (traza != NULL) {
+            registrar_evento(traza, EVENTO_SELECCIONAR, u, distancia[u], anterior[u],
+                             distancia[u], anterior[u]);
+        }
         
         // Muestra información de iteración
         if (mostrar_estados) {
@@ -77,17 +100,29 @@ int* dijkstra_con_estados(grafo_matriz* grafo, int inicio, int fin,
         
         // Actualiza distancias de vecinos
         int vecinos_actualizados = 0;    // Contador de actualizaciones
+        int cambiados[MAX_NODOS];        // Nodos modificados en la iteración
+        int num_cambiados = 0;
+        
+        cambiados[num_cambiados++] = u;  // El seleccionado pasa a procesado
         
         for (int v = 0; v < grafo->num_nodos; v++) {
             // Si hay arista y nodo no visitado
             if (!visitado[v] && grafo->matriz[u][v] != 0) {
                 int nueva_distancia = distancia[u] + grafo->matriz[u][v];
+                CONTAR(aristas_examinadas);
                 
                 // Encontró camino más corto
                 if (nueva_distancia < distancia[v]) {
+                    CONTAR(aristas_relajadas);
+                    CONTAR(operaciones_cola);    // Mejora de prioridad
+                    if (traza != NULL) {
+                        registrar_evento(traza, EVENTO_RELAJAR, v, nueva_distancia, u,
+                                         distancia[v], anterior[v]);
+                    }
                     distancia[v] = nueva_distancia;    // Actualiza distancia
                     anterior[v] = u;                   // Actualiza anterior
                     vecinos_actualizados++;            // Incrementa contador
+                    cambiados[num_cambiados++] = v;    // Fila a mostrar
                     
                     // Muestra actualización
                     if (mostrar_estados) {
@@ -103,9 +138,9 @@ int* dijkstra_con_estados(grafo_matriz* grafo, int inicio, int fin,
             if (vecinos_actualizados == 0) {
                 printf("  No se actualizaron vecinos en esta iteración\n");
             }
-            printf("\nEstado después de iteración %d:\n", iteracion);
-            imprimir_estado_dijkstra(grafo->num_nodos, distancia, anterior, 
-                                    visitado, u, iteracion);
+            printf("\nCambios en iteración %d:\n", iteracion);
+            imprimir_cambios_dijkstra(distancia, anterior, visitado, u, iteracion,
+                                      cambiados, num_cambiados);
             
             printf("\nPresione Enter para continuar...");
             getchar();    // Pausa para visualización
@@ -114,6 +149,8 @@ int* dijkstra_con_estados(grafo_matriz* grafo, int inicio, int fin,
     
     // Calcula distancia total
     *distancia_total = (distancia[fin] == INFINITO) ? -1 : distancia[fin];
+    if (nodos_expandidos != NULL) *nodos_expandidos = expandidos;
+    TERMINAR_FASE(FASE_BUSQUEDA, inicio_busqueda);
     
     // Muestra resultado final
     if (mostrar_estados) {
@@ -135,6 +172,111 @@ int* dijkstra_con_estados(grafo_matriz* grafo, int inicio, int fin,
     return anterior;    // Retorna array de anteriores
 }
 
+/*
+ * dijkstra_con_estados
+ * Implementa Dijkstra mostrando estados intermedios.
+ */
+int* dijkstra_con_estados(grafo_matriz* grafo, int inicio, int fin, 
+                         int* distancia_total, int mostrar_estados) {
+    return dijkstra_interno(grafo, inicio, fin, distancia_total, mostrar_estados, NULL, NULL);
+}
+
+/*
+ * dijkstra_con_traza
+ * Ejecuta Dijkstra a velocidad completa registrando eventos binarios.
+ * La traza se reproduce después con reproducir_traza.
+ */
+int* dijkstra_con_traza(grafo_matriz* grafo, int inicio, int fin,
+                        int* distancia_total, traza_dijkstra* traza) {
+    return dijkstra_interno(grafo, inicio, fin, distancia_total, 0, traza, NULL);
+}
+
+/*
+ * establecer_rango_estados
+ * Limita las tablas de estado a los nodos [desde, hasta].
+ * Con desde < 0 se muestran todos los nodos.
+ */
+void establecer_rango_estados(int desde, int hasta) {
+    rango_desde = desde;
+    rango_hasta = hasta;
+}
+
+/*
+ * nodo_en_rango
+ * Indica si un nodo pasa el filtro de las tablas de estado.
+ */
+static int nodo_en_rango(int nodo) {
+    return rango_desde < 0 || (nodo >= rango_desde && nodo <= rango_hasta);
+}
+
+/*
+ * imprimir_fila_estado
+ * Imprime la fila de un nodo en las tablas de estado.
+ */
+static void imprimir_fila_estado(int i, int distancia[], int anterior[],
+                                 int visitado[], int nodo_actual) {
+    char visitado_str[10];     // String para visitado
+    char distancia_str[12];    // String para distancia
+    char anterior_str[12];     // String para anterior
+    char estado_str[20];       // String para estado (incluye color)
+    
+    // Convierte valores a strings
+    sprintf(visitado_str, "%s", visitado[i] ? "SÍ" : "NO");
+    
+    if (distancia[i] == INFINITO) {
+        sprintf(distancia_str, "INF");    // Infinito
+    } else {
+        sprintf(distancia_str, "%d", distancia[i]);    // Distancia numérica
+    }
+    
+    sprintf(anterior_str, "%d", anterior[i]);    // Nodo anterior
+    if (anterior[i] == -1) strcpy(anterior_str, "-");    // Sin anterior
+    
+    // Determina estado del nodo
+    if (i == nodo_actual) {
+        sprintf(estado_str, COLOR_VERDE "ACTUAL" COLOR_RESET);    // Nodo actual
+    } else if (visitado[i]) {
+        sprintf(estado_str, "PROCESADO");    // Ya procesado
+    } else if (distancia[i] != INFINITO) {
+        sprintf(estado_str, "EN COLA");      // En cola de procesamiento
+    } else {
+        sprintf(estado_str, "NO VISITADO");  // Sin visitar
+    }
+    
+    // Imprime fila de la tabla
+    printf("│ %3d │ %-9s │ %-10s │ %-8s │ %-9s │\n", 
+           i, visitado_str, distancia_str, anterior_str, estado_str);
+}
+
+/*
+ * imprimir_linea_caja
+ * Imprime texto dentro de la caja de 51 columnas.
+ * Cuenta caracteres UTF-8 (no bytes) para que los acentos no corran el borde.
+ */
+static void imprimir_linea_caja(const char* texto) {
+    int visibles = 0;    // Caracteres que ocupan una columna
+    
+    for (const unsigned char* c = (const unsigned char*)texto; *c; c++) {
+        if ((*c & 0xC0) != 0x80) visibles++;    // No es byte de continuación
+    }
+    
+    printf("│ %s", texto);
+    for (int i = visibles; i < 51; i++) putchar(' ');
+    printf(" │\n");
+}
+
+/*
+ * imprimir_encabezado_estado
+ * Imprime título y columnas de las tablas de estado.
+ */
+static void imprimir_encabezado_estado(const char* titulo) {
+    printf("┌─────────────────────────────────────────────────────┐\n");
+    imprimir_linea_caja(titulo);
+    printf("├─────┬───────────┬────────────┬──────────┬───────────┤\n");
+    printf("│ Nodo│ Visitado  │ Distancia  │ Anterior │ Estado    │\n");
+    printf("├─────┼───────────┼────────────┼──────────┼───────────┤\n");
+}
+
 /*
  * imprimir_estado_dijkstra
  * Muestra tabla con estado actual del algoritmo.
@@ -142,51 +284,57 @@ int* dijkstra_con_estados(grafo_matriz* grafo, int inicio, int fin,
  */
 void imprimir_estado_dijkstra(int num_nodos, int distancia[], int anterior[], 
                               int visitado[], int nodo_actual, int iteracion) {
-    printf("┌─────────────────────────────────────────────────────┐\n");
-    printf("│ %-51s │\n", (iteracion == 0) ? "ESTADO INICIAL" : "ESTADO INTERMEDIO");
-    printf("├─────┬───────────┬────────────┬──────────┬───────────┤\n");
-    printf("│ Nodo│ Visitado  │ Distancia  │ Anterior │ Estado    │\n");
-    printf("├─────┼───────────┼────────────┼──────────┼───────────┤\n");
+    int mostrados = 0;    // Filas impresas
     
-    // Muestra primeros 15 nodos (para no saturar pantalla)
-    for (int i = 0; i < num_nodos && i < 15; i++) {
-        char visitado_str[10];     // String para visitado
-        char distancia_str[12];    // String para distancia
-        char anterior_str[10];     // String para anterior
-        char estado_str[15];       // String para estado
-        
-        // Convierte valores a strings
-        sprintf(visitado_str, "%s", visitado[i] ? "SÍ" : "NO");
-        
-        if (distancia[i] == INFINITO) {
-            sprintf(distancia_str, "INF");    // Infinito
-        } else {
-            sprintf(distancia_str, "%d", distancia[i]);    // Distancia numérica
-        }
-        
-        sprintf(anterior_str, "%d", anterior[i]);    // Nodo anterior
-        if (anterior[i] == -1) strcpy(anterior_str, "-");    // Sin anterior
-        
-        // Determina estado del nodo
-        if (i == nodo_actual) {
-            sprintf(estado_str, COLOR_VERDE "ACTUAL" COLOR_RESET);    // Nodo actual
-        } else if (visitado[i]) {
-            sprintf(estado_str, "PROCESADO");    // Ya procesado
-        } else if (distancia[i] != INFINITO) {
-            sprintf(estado_str, "EN COLA");      // En cola de procesamiento
-        } else {
-            sprintf(estado_str, "NO VISITADO");  // Sin visitar
-        }
+    imprimir_encabezado_estado((iteracion == 0) ? "ESTADO INICIAL" : "ESTADO INTERMEDIO");
+    
+    // Sin rango: primeros 15 nodos (para no saturar pantalla)
+    for (int i = 0; i < num_nodos; i++) {
+        if (!nodo_en_rango(i)) continue;
+        if (rango_desde < 0 && mostrados == 15) break;
         
-        // Imprime fila de la tabla
-        printf("│ %3d │ %-9s │ %-10s │ %-8s │ %-9s │\n", 
-               i, visitado_str, distancia_str, anterior_str, estado_str);
+        imprimir_fila_estado(i, distancia, anterior, visitado, nodo_actual);
+        mostrados++;
     }
     
     // Mensaje para grafos grandes
-    if (num_nodos > 15) {
+    if (mostrados < num_nodos) {
+        char resumen[52];
+        sprintf(resumen, "... (mostrando %d de %d nodos)", mostrados, num_nodos);
+        printf("├─────┴───────────┴────────────┴──────────┴───────────┤\n");
+        imprimir_linea_caja(resumen);
+    }
+    
+    printf("└─────────────────────────────────────────────────────┘\n");
+}
+
+/*
+ * imprimir_cambios_dijkstra
+ * Muestra solo las filas de los nodos que cambiaron en la iteración
+ * (el seleccionado y los vecinos actualizados), filtradas por rango.
+ */
+void imprimir_cambios_dijkstra(int distancia[], int anterior[], int visitado[],
+                               int nodo_actual, int iteracion,
+                               const int cambiados[], int num_cambiados) {
+    char titulo[52];      // Título de la tabla
+    int ocultos = 0;      // Cambios fuera del rango
+    
+    sprintf(titulo, "CAMBIOS EN ITERACIÓN %d", iteracion);
+    imprimir_encabezado_estado(titulo);
+    
+    for (int k = 0; k < num_cambiados; k++) {
+        if (!nodo_en_rango(cambiados[k])) {
+            ocultos++;
+            continue;
+        }
+        imprimir_fila_estado(cambiados[k], distancia, anterior, visitado, nodo_actual);
+    }
+    
+    if (ocultos > 0) {
+        char resumen[52];
+        sprintf(resumen, "... (%d cambios fuera del rango)", ocultos);
         printf("├─────┴───────────┴────────────┴──────────┴───────────┤\n");
-        printf("│ ... (mostrando 15 de %d nodos)                     │\n", num_nodos);
+        imprimir_linea_caja(resumen);
     }
     
     printf("└─────────────────────────────────────────────────────┘\n");
@@ -264,6 +412,7 @@ arista_prim* prim(grafo_matriz* grafo, int* num_aristas) {
     int clave[MAX_NODOS];                       // Claves mínimas
     int padre[MAX_NODOS];                       // Padres en árbol
     int en_arbol[MAX_NODOS] = {0};              // Nodos en árbol
+    INICIAR_FASE(inicio_arbol);
     
     // Inicializa arrays
     for (int i = 0; i < grafo->num_nodos; i++) {
@@ -290,12 +439,18 @@ arista_prim* prim(grafo_matriz* grafo, int* num_aristas) {
         if (u == -1) break;    // Termina si no hay nodos
         
         en_arbol[u] = 1;    // Agrega nodo al árbol
+        CONTAR(nodos_expandidos);
+        CONTAR(operaciones_cola);    // Extracción del mínimo
         
         // Actualiza claves de vecinos
         for (int v = 0; v < grafo->num_nodos; v++) {
+            if (grafo->matriz[u][v] != 0 && !en_arbol[v]) CONTAR(aristas_examinadas);
+            
             // Si hay arista, nodo no en árbol y peso menor
             if (grafo->matriz[u][v] != 0 && !en_arbol[v] && 
                 grafo->matriz[u][v] < clave[v]) {
+                CONTAR(aristas_relajadas);
+                CONTAR(operaciones_cola);    // Mejora de prioridad
                 clave[v] = grafo->matriz[u][v];    // Actualiza clave
                 padre[v] = u;                      // Actualiza padre
             }
@@ -314,6 +469,7 @@ arista_prim* prim(grafo_matriz* grafo, int* num_aristas) {
         }
     }
     
+    TERMINAR_FASE(FASE_ARBOL, inicio_arbol);
     return arbol;    // Retorna árbol generador mínimo
 }
 
@@ -331,44 +487,31 @@ int comparar_aristas(const void* a, const void* b) {
 }
 
 /*
- * kruskal
- * Implementa algoritmo de Kruskal para árbol generador mínimo.
- * Usa conjuntos disjuntos para evitar ciclos.
+ * kruskal_aristas
+ * Kruskal sobre una lista de aristas (se ordena en sitio) entre
+ * num_nodos nodos. Sirve para grafos que no están en matriz.
  */
-arista* kruskal(grafo_matriz* grafo, int* num_aristas) {
-    arista* arbol = malloc(MAX_ARISTAS * sizeof(arista));    // Array dinámico
+arista* kruskal_aristas(arista* aristas, int total_aristas, int num_nodos, int* num_aristas) {
+    arista* arbol = (arista*)reservar_memoria(MEM_ALGORITMOS,
+                                              (num_nodos > 1 ? num_nodos - 1 : 1) * sizeof(arista));
+    *num_aristas = 0;    // Inicializa contador
     if (!arbol) return NULL;    // Verifica asignación
     
     conjunto_disjunto cd;                    // Conjuntos disjuntos
-    arista aristas[MAX_ARISTAS];             // Array de aristas
-    int total_aristas = 0;                   // Contador total
-    
-    // Recolecta todas las aristas del grafo
-    for (int i = 0; i < grafo->num_nodos; i++) {
-        for (int j = i + 1; j < grafo->num_nodos; j++) {
-            if (grafo->matriz[i][j] > 0) {    // Si hay arista
-                aristas[total_aristas].origen = i;        // Origen
-                aristas[total_aristas].destino = j;       // Destino
-                aristas[total_aristas].peso = grafo->matriz[i][j]; // Peso
-                total_aristas++;                          // Incrementa contador
-            }
-        }
-    }
     
     // Ordena aristas por peso (ascendente)
     qsort(aristas, total_aristas, sizeof(arista), comparar_aristas);
     
     // Inicializa conjuntos disjuntos
-    for (int i = 0; i < grafo->num_nodos; i++) {
+    for (int i = 0; i < num_nodos; i++) {
         hacer_conjunto(&cd, i);    // Cada nodo en su propio conjunto
     }
     
     // Construye árbol generador mínimo
-    *num_aristas = 0;    // Inicializa contador
-    
-    for (int i = 0; i < total_aristas && *num_aristas < grafo->num_nodos - 1; i++) {
+    for (int i = 0; i < total_aristas && *num_aristas < num_nodos - 1; i++) {
         int origen = aristas[i].origen;     // Origen de arista
         int destino = aristas[i].destino;   // Destino de arista
+        CONTAR(aristas_examinadas);
         
         // Si están en conjuntos diferentes (no crea ciclo)
         if (encontrar(&cd, origen) != encontrar(&cd, destino)) {
@@ -381,6 +524,33 @@ arista* kruskal(grafo_matriz* grafo, int* num_aristas) {
     return arbol;    // Retorna árbol generador mínimo
 }
 
+/*
+ * kruskal
+ * Implementa algoritmo de Kruskal para árbol generador mínimo.
+ * Usa conjuntos disjuntos para evitar ciclos.
+ */
+arista* kruskal(grafo_matriz* grafo, int* num_aristas) {
+    arista aristas[MAX_ARISTAS];             // Array de aristas
+    int total_aristas = 0;                   // Contador total
+    INICIAR_FASE(inicio_arbol);
+    
+    // Recolecta todas las aristas del grafo
+    for (int i = 0; i < grafo->num_nodos; i++) {
+        for (int j = i + 1; j < grafo->num_nodos; j++) {
+            if (grafo->matriz[i][j] > 0) {    // Si hay arista
+                aristas[total_aristas].origen = i;        // Origen
+                aristas[total_aristas].destino = j;       // Destino
+                aristas[total_aristas].peso = grafo->matriz[i][j]; // Peso
+                total_aristas++;                          // Incrementa contador
+            }
+        }
+    }
+    
+    arista* arbol = kruskal_aristas(aristas, total_aristas, grafo->num_nodos, num_aristas);
+    TERMINAR_FASE(FASE_ARBOL, inicio_arbol);
+    return arbol;    // Retorna árbol generador mínimo
+}
+
 // ==================== BÚSQUEDA EN ANCHURA ====================
 
 /*
@@ -393,6 +563,7 @@ int* bfs(grafo_matriz* grafo, int inicio) {
     int cola[MAX_NODOS];               // Cola para BFS
     int visitado[MAX_NODOS] = {0};     // Nodos visitados
     int frente = 0, final = 0;         // Índices de cola
+    INICIAR_FASE(inicio_busqueda);
     
     // Inicializa array de anteriores
     for (int i = 0; i < grafo->num_nodos; i++) {
@@ -404,11 +575,16 @@ int* bfs(grafo_matriz* grafo, int inicio) {
     
     while (frente < final) {   // Mientras haya nodos en cola
         int actual = cola[frente++];    // Saca nodo de cola
+        CONTAR(nodos_expandidos);
+        CONTAR(operaciones_cola);
         
         // Procesa vecinos del nodo actual
         for (int v = 0; v < grafo->num_nodos; v++) {
             // Si hay arista y nodo no visitado
             if (grafo->matriz[actual][v] > 0 && !visitado[v]) {
+                CONTAR(aristas_examinadas);
+                CONTAR(aristas_relajadas);
+                CONTAR(operaciones_cola);
                 visitado[v] = 1;           // Marca como visitado
                 anterior[v] = actual;      // Establece anterior
                 cola[final++] = v;         // Agrega a cola
@@ -416,9 +592,200 @@ int* bfs(grafo_matriz* grafo, int inicio) {
         }
     }
     
+    TERMINAR_FASE(FASE_BUSQUEDA, inicio_busqueda);
     return anterior;    // Retorna array de anteriores
 }
 
+// ==================== A* ====================
+
+/*
+ * crear_monticulo
+ * Reserva los arreglos para n nodos. Retorna 0 si no hay memoria.
+ */
+int crear_monticulo(monticulo* m, int n) {
+    m->nodos = (int*)reservar_memoria(MEM_ALGORITMOS, n * sizeof(int));
+    m->posicion = (int*)reservar_memoria(MEM_ALGORITMOS, n * sizeof(int));
+    m->prioridad = (int*)reservar_memoria(MEM_ALGORITMOS, n * sizeof(int));
+    m->tamano = 0;
+    
+    if (!m->nodos || !m->posicion || !m->prioridad) {
+        liberar_memoria(m->nodos);
+        liberar_memoria(m->posicion);
+        liberar_memoria(m->prioridad);
+        return 0;
+    }
+    for (int i = 0; i < n; i++) m->posicion[i] = -1;
+    return 1;
+}
+
+void destruir_monticulo(monticulo* m) {
+    liberar_memoria(m->nodos);
+    liberar_memoria(m->posicion);
+    liberar_memoria(m->prioridad);
+}
+
+/*
+ * intercambiar_monticulo
+ * Intercambia dos posiciones y mantiene el índice inverso.
+ */
+static void intercambiar_monticulo(monticulo* m, int a, int b) {
+    int temp = m->nodos[a];
+    m->nodos[a] = m->nodos[b];
+    m->nodos[b] = temp;
+    m->posicion[m->nodos[a]] = a;
+    m->posicion[m->nodos[b]] = b;
+}
+
+static void subir_monticulo(monticulo* m, int i) {
+    while (i > 0) {
+        int padre = (i - 1) / 2;
+        if (m->prioridad[m->nodos[padre]] <= m->prioridad[m->nodos[i]]) break;
+        intercambiar_monticulo(m, i, padre);
+        i = padre;
+    }
+}
+
+static void bajar_monticulo(monticulo* m, int i) {
+    for (;;) {
+        int menor = i;
+        int izquierdo = 2 * i + 1;
+        int derecho = izquierdo + 1;
+        
+        if (izquierdo < m->tamano &&
+            m->prioridad[m->nodos[izquierdo]] < m->prioridad[m->nodos[menor]]) menor = izquierdo;
+        if (derecho < m->tamano &&
+            m->prioridad[m->nodos[derecho]] < m->prioridad[m->nodos[menor]]) menor = derecho;
+        if (menor == i) break;
+        
+        intercambiar_monticulo(m, i, menor);
+        i = menor;
+    }
+}
+
+/*
+ * insertar_o_mejorar
+ * Inserta el nodo o baja su prioridad si ya está en el montículo.
+ */
+void insertar_o_mejorar(monticulo* m, int nodo, int prioridad) {
+    CONTAR(operaciones_cola);
+    m->prioridad[nodo] = prioridad;
+    
+    if (m->posicion[nodo] == -1) {
+        m->nodos[m->tamano] = nodo;
+        m->posicion[nodo] = m->tamano;
+        m->tamano++;
+    }
+    subir_monticulo(m, m->posicion[nodo]);
+}
+
+/*
+ * extraer_minimo
+ * Saca el nodo de menor prioridad.
+ */
+int extraer_minimo(monticulo* m) {
+    CONTAR(operaciones_cola);
+    int nodo = m->nodos[0];
+    
+    m->tamano--;
+    if (m->tamano > 0) {
+        m->nodos[0] = m->nodos[m->tamano];
+        m->posicion[m->nodos[0]] = 0;
+        bajar_monticulo(m, 0);
+    }
+    m->posicion[nodo] = -1;
+    return nodo;
+}
+
+/*
+ * heuristica_manhattan
+ * Distancia Manhattan en la cuadrícula FILAS x COLUMNAS.
+ * contexto apunta a un factor entero (NULL = 1), ver factor_manhattan_admisible.
+ */
+int heuristica_manhattan(int nodo, int fin, const void* contexto) {
+    int factor = (contexto != NULL) ? *(const int*)contexto : 1;
+    int df = nodo / COLUMNAS - fin / COLUMNAS;
+    int dc = nodo % COLUMNAS - fin % COLUMNAS;
+    return factor * ((df < 0 ? -df : df) + (dc < 0 ? -dc : dc));
+}
+
+/*
+ * factor_manhattan_admisible
+ * Mayor k tal que k * Manhattan(u, v) <= peso(u, v) en toda arista.
+ * Con ese factor la heurística es consistente; 0 la anula (A* = Dijkstra).
+ */
+int factor_manhattan_admisible(grafo_matriz* grafo) {
+    int factor = INFINITO;
+    
+    for (int u = 0; u < grafo->num_nodos; u++) {
+        for (int v = u + 1; v < grafo->num_nodos; v++) {
+            if (grafo->matriz[u][v] != 0) {
+                int k = grafo->matriz[u][v] / heuristica_manhattan(u, v, NULL);
+                if (k < factor) factor = k;
+            }
+        }
+    }
+    return (factor == INFINITO) ? 0 : factor;
+}
+
+/*
+ * a_estrella
+ * A* con montículo binario indexado y heurística intercambiable.
+ * La heurística debe ser consistente: un nodo cerrado no se reabre.
+ */
+int* a_estrella(grafo_matriz* grafo, int inicio, int fin, int* distancia_total,
+                heuristica_nodo heuristica, const void* contexto, int* nodos_expandidos) {
+    static int anterior[MAX_NODOS];           // Árbol de caminos
+    int costo[MAX_NODOS];                     // Costo g desde inicio
+    unsigned char cerrado[MAX_NODOS] = {0};   // Nodos ya expandidos
+    int expandidos = 0;
+    monticulo abiertos;                       // Frontera ordenada por g + h
+    INICIAR_FASE(inicio_busqueda);
+    
+    *distancia_total = -1;
+    if (nodos_expandidos != NULL) *nodos_expandidos = 0;
+    if (!crear_monticulo(&abiertos, grafo->num_nodos)) return NULL;
+    
+    for (int i = 0; i < grafo->num_nodos; i++) {
+        costo[i] = INFINITO;
+        anterior[i] = -1;
+    }
+    
+    costo[inicio] = 0;
+    insertar_o_mejorar(&abiertos, inicio, heuristica(inicio, fin, contexto));
+    
+    while (abiertos.tamano > 0) {
+        int u = extraer_minimo(&abiertos);
+        
+        if (u == fin) {    // Destino alcanzado con costo óptimo
+            *distancia_total = costo[u];
+            break;
+        }
+        
+        cerrado[u] = 1;
+        expandidos++;
+        CONTAR(nodos_expandidos);
+        
+        for (int v = 0; v < grafo->num_nodos; v++) {
+            int peso = grafo->matriz[u][v];
+            if (peso == 0 || cerrado[v]) continue;
+            CONTAR(aristas_examinadas);
+            
+            int nuevo_costo = costo[u] + peso;
+            if (nuevo_costo < costo[v]) {
+                CONTAR(aristas_relajadas);
+                costo[v] = nuevo_costo;
+                anterior[v] = u;
+                insertar_o_mejorar(&abiertos, v, nuevo_costo + heuristica(v, fin, contexto));
+            }
+        }
+    }
+    
+    destruir_monticulo(&abiertos);
+    if (nodos_expandidos != NULL) *nodos_expandidos = expandidos;
+    TERMINAR_FASE(FASE_BUSQUEDA, inicio_busqueda);
+    return anterior;
+}
+
 // ==================== FUNCIONES AUXILIARES ====================
 
 /*
@@ -461,16 +828,18 @@ void imprimir_camino(int* anterior, int inicio, int fin) {
  * Útil para algoritmos que modifican la matriz.
  */
 int** crear_matriz_adyacencia(grafo_matriz* grafo) {
-    int** matriz = (int**)malloc(grafo->num_nodos * sizeof(int*));    // Array de filas
+    int** matriz = (int**)reservar_memoria(MEM_ALGORITMOS,
+                                           grafo->num_nodos * sizeof(int*));    // Filas
     if (!matriz) return NULL;    // Verifica asignación
     
     // Asigna memoria para cada fila
     for (int i = 0; i < grafo->num_nodos; i++) {
-        matriz[i] = (int*)malloc(grafo->num_nodos * sizeof(int));    // Fila i
+        matriz[i] = (int*)reservar_memoria(MEM_ALGORITMOS,
+                                           grafo->num_nodos * sizeof(int));     // Fila i
         if (!matriz[i]) {    // Verifica asignación
-            for (int j = 0; j < i; j++) free(matriz[j]);    // Libera anteriores
-            free(matriz);                                   // Libera array
-            return NULL;                                    // Retorna NULL
+            for (int j = 0; j < i; j++) liberar_memoria(matriz[j]);    // Libera anteriores
+            liberar_memoria(matriz);                                    // Libera array
+            return NULL;                                                // Retorna NULL
         }
         
         // Copia valores de la matriz original
@@ -490,38 +859,53 @@ int** crear_matriz_adyacencia(grafo_matriz* grafo) {
 void liberar_matriz_adyacencia(int** matriz, int n) {
     if (matriz) {    // Si matriz no es NULL
         for (int i = 0; i < n; i++) {
-            free(matriz[i]);    // Libera cada fila
+            liberar_memoria(matriz[i]);    // Libera cada fila
         }
-        free(matriz);    // Libera array de filas
+        liberar_memoria(matriz);    // Libera array de filas
     }
 }
 
 /*
  * liberar_aristas
  * Libera memoria de array dinámico de aristas.
- * Simple wrapper para free().
+ * Simple wrapper para liberar_memoria().
  */
 void liberar_aristas(arista* aristas) {
     if (aristas) {
-        free(aristas);    // Libera memoria
+        liberar_memoria(aristas);    // Libera memoria
     }
 }
 
 // ==================== ALGORITMOS ADICIONALES ====================
 
 /*
- * encontrar_caminos_criticos
- * Encuentra caminos más largos en el grafo.
- * Usa Floyd-Warshall para todas las distancias.
+ * floyd_warshall_en_sitio
+ * Cierra una matriz n x n de pesos directos (INFINITO sin arista, 0 en
+ * la diagonal) en distancias mínimas entre todos los pares.
  */
-void encontrar_caminos_criticos(grafo_matriz* grafo) {
-    printf(COLOR_CYAN "\n=== CAMINOS CRÍTICOS ===\n" COLOR_RESET);
-    
-    int** distancias = crear_matriz_adyacencia(grafo);    // Copia de matriz
-    if (!distancias) {
-        printf("Error al crear matriz de distancias\n");
-        return;
+void floyd_warshall_en_sitio(int** distancias, int n) {
+    for (int k = 0; k < n; k++) {
+        for (int i = 0; i < n; i++) {
+            for (int j = 0; j < n; j++) {
+                // Si hay camino i→k y k→j
+                if (distancias[i][k] != INFINITO && 
+                    distancias[k][j] != INFINITO &&
+                    distancias[i][k] + distancias[k][j] < distancias[i][j]) {
+                    distancias[i][j] = distancias[i][k] + distancias[k][j];    // Actualiza
+                }
+            }
+        }
     }
+}
+
+/*
+ * distancias_todos_los_pares
+ * Floyd-Warshall sobre una copia de la matriz; INFINITO donde no hay
+ * camino. Se libera con liberar_matriz_adyacencia (NULL sin memoria).
+ */
+int** distancias_todos_los_pares(grafo_matriz* grafo) {
+    int** distancias = crear_matriz_adyacencia(grafo);    // Copia de matriz
+    if (!distancias) return NULL;
     
     int n = grafo->num_nodos;    // Número de nodos
     
@@ -535,35 +919,57 @@ void encontrar_caminos_criticos(grafo_matriz* grafo) {
         }
     }
     
-    // Algoritmo Floyd-Warshall
-    for (int k = 0; k < n; k++) {
-        for (int i = 0; i < n; i++) {
-            for (int j = 0; j < n; j++) {
-                // Si hay camino i→k y k→j
-                if (distancias[i][k] != INFINITO && 
-                    distancias[k][j] != INFINITO &&
-                    distancias[i][k] + distancias[k][j] < distancias[i][j]) {
-                    distancias[i][j] = distancias[i][k] + distancias[k][j];    // Actualiza
-                }
-            }
-        }
-    }
+    floyd_warshall_en_sitio(distancias, n);
+    return distancias;
+}
+
+/*
+ * calcular_camino_critico
+ * Floyd-Warshall sobre todos los pares y busca el par más lejano.
+ * Retorna la distancia máxima (-1 si no hay memoria).
+ */
+int calcular_camino_critico(grafo_matriz* grafo, int* inicio_critico, int* fin_critico) {
+    int** distancias = distancias_todos_los_pares(grafo);
+    if (!distancias) return -1;
+    
+    int n = grafo->num_nodos;    // Número de nodos
     
     // Encuentra camino más largo
     int max_distancia = 0;
-    int inicio_critico = -1, fin_critico = -1;
+    *inicio_critico = -1;
+    *fin_critico = -1;
     
     for (int i = 0; i < n; i++) {
         for (int j = 0; j < n; j++) {
             // Si hay camino y es el más largo encontrado
             if (distancias[i][j] != INFINITO && distancias[i][j] > max_distancia) {
                 max_distancia = distancias[i][j];    // Actualiza máximo
-                inicio_critico = i;                  // Actualiza inicio
-                fin_critico = j;                     // Actualiza fin
+                *inicio_critico = i;                 // Actualiza inicio
+                *fin_critico = j;                    // Actualiza fin
             }
         }
     }
     
+    liberar_matriz_adyacencia(distancias, n);    // Libera memoria
+    return max_distancia;
+}
+
+/*
+ * encontrar_caminos_criticos
+ * Encuentra caminos más largos en el grafo.
+ * Usa Floyd-Warshall para todas las distancias.
+ */
+void encontrar_caminos_criticos(grafo_matriz* grafo) {
+    int inicio_critico, fin_critico;    // Extremos del camino más largo
+    
+    printf(COLOR_CYAN "\n=== CAMINOS CRÍTICOS ===\n" COLOR_RESET);
+    
+    int max_distancia = calcular_camino_critico(grafo, &inicio_critico, &fin_critico);
+    if (max_distancia < 0) {
+        printf("Error al crear matriz de distancias\n");
+        return;
+    }
+    
     // Muestra resultado
     if (inicio_critico != -1) {
         printf("Camino más largo: del nodo %d al nodo %d\n", 
@@ -572,8 +978,6 @@ void encontrar_caminos_criticos(grafo_matriz* grafo) {
     } else {
         printf("No se encontraron caminos críticos\n");
     }
-    
-    liberar_matriz_adyacencia(distancias, n);    // Libera memoria
 }
 
 /*
@@ -703,4 +1107,245 @@ void explicar_algoritmos_seleccion(void) {
     printf("BFS: Encuentra camino más corto sin considerar pesos.\n");
     
 
-}
\ No newline at end of file
+}
+// ==================== COMPARACIÓN EMPÍRICA ====================
+
+#define NUM_DENSIDADES 4
+
+/*
+ * resolver_dijkstra / resolver_bfs / resolver_a_estrella / resolver_alt
+ * Adaptadores al formato común de solucionador.
+ */
+static int* resolver_dijkstra(grafo_matriz* grafo, int inicio, int fin, int* distancia_total,
+                              int* nodos_expandidos, const void* datos) {
+    (void)datos;
+    return dijkstra_interno(grafo, inicio, fin, distancia_total, 0, NULL, nodos_expandidos);
+}
+
+static int* resolver_bfs(grafo_matriz* grafo, int inicio, int fin, int* distancia_total,
+                         int* nodos_expandidos, const void* datos) {
+    static int anterior[MAX_NODOS];    // Árbol de caminos
+    int cola[MAX_NODOS];               // Cola FIFO
+    int visitado[MAX_NODOS] = {0};
+    int frente = 0, final = 0;
+    (void)datos;
+    
+    for (int i = 0; i < grafo->num_nodos; i++) anterior[i] = -1;
+    cola[final++] = inicio;
+    visitado[inicio] = 1;
+    *nodos_expandidos = 0;
+    
+    while (frente < final) {
+        int actual = cola[frente++];
+        if (actual == fin) break;    // Menos aristas, no menor costo
+        (*nodos_expandidos)++;
+        
+        for (int v = 0; v < grafo->num_nodos; v++) {
+            if (grafo->matriz[actual][v] != 0 && !visitado[v]) {
+                visitado[v] = 1;
+                anterior[v] = actual;
+                cola[final++] = v;
+            }
+        }
+    }
+    
+    // Costo ponderado del camino encontrado
+    *distancia_total = visitado[fin] ? 0 : -1;
+    for (int nodo = fin; visitado[fin] && nodo != inicio; nodo = anterior[nodo]) {
+        *distancia_total += grafo->matriz[anterior[nodo]][nodo];
+    }
+    return anterior;
+}
+
+static void* preparar_a_estrella(grafo_matriz* grafo) {
+    int* factor = (int*)reservar_memoria(MEM_ALGORITMOS, sizeof(int));
+    if (factor) *factor = factor_manhattan_admisible(grafo);
+    return factor;
+}
+
+static int* resolver_a_estrella(grafo_matriz* grafo, int inicio, int fin, int* distancia_total,
+                                int* nodos_expandidos, const void* datos) {
+    return a_estrella(grafo, inicio, fin, distancia_total, heuristica_manhattan, datos,
+                      nodos_expandidos);
+}
+
+static void* preparar_alt(grafo_matriz* grafo) {
+    return hitos_desde_grafo(grafo, HITOS_DEFECTO);
+}
+
+static void liberar_alt(void* datos) {
+    destruir_tabla_hitos((tabla_hitos*)datos);
+}
+
+static int* resolver_alt(grafo_matriz* grafo, int inicio, int fin, int* distancia_total,
+                         int* nodos_expandidos, const void* datos) {
+    return a_estrella(grafo, inicio, fin, distancia_total, heuristica_hitos, datos,
+                      nodos_expandidos);
+}
+
+/* Solucionadores registrados (el primero es la referencia de costo) */
+static const solucionador solucionadores[] = {
+    {"Dijkstra", resolver_dijkstra,   NULL,                NULL},
+    {"BFS",      resolver_bfs,        NULL,                NULL},
+    {"A*",       resolver_a_estrella, preparar_a_estrella, liberar_memoria},
+    {"ALT",      resolver_alt,        preparar_alt,        liberar_alt},
+};
+
+/*
+ * obtener_solucionadores
+ * Tabla de solucionadores; retorna la cantidad.
+ */
+int obtener_solucionadores(const solucionador** tabla) {
+    *tabla = solucionadores;
+    return (int)(sizeof(solucionadores) / sizeof(solucionadores[0]));
+}
+
+/*
+ * contar_pasos
+ * Aristas del camino inicio → fin según el arreglo de anteriores.
+ */
+static int contar_pasos(const int* anterior, int inicio, int fin, int num_nodos) {
+    int pasos = 0;
+    for (int nodo = fin; nodo != inicio; nodo = anterior[nodo]) {
+        if (nodo == -1 || pasos > num_nodos) return -1;    // Sin camino
+        pasos++;
+    }
+    return pasos;
+}
+
+/*
+ * comparar_solucionadores
+ * Ejecuta cada solucionador registrado sobre el mismo grafo y muestra
+ * tiempo, nodos expandidos, memoria y si el costo coincide con Dijkstra.
+ */
+void comparar_solucionadores(grafo_matriz* grafo, int inicio, int fin, int repeticiones) {
+    const solucionador* tabla;
+    int num = obtener_solucionadores(&tabla);
+    double* muestras = (double*)reservar_memoria(MEM_ALGORITMOS, repeticiones * sizeof(double));
+    int costo_referencia = -1;
+    
+    if (!muestras) return;
+    
+    printf("%-10s %11s %11s %11s %10s %10s %7s %7s  %s\n", "Algoritmo", "Mediana µs",
+           "p95 µs", "Expandidos", "Heap KB", "Pila KB", "Pasos", "Costo", "Coincide");
+    
+    for (int s = 0; s < num; s++) {
+        void* datos = tabla[s].preparar ? tabla[s].preparar(grafo) : NULL;
+        if (tabla[s].preparar && datos == NULL) continue;    // Sin memoria
+        
+        int distancia = -1, expandidos = 0;
+        int* anterior = NULL;
+        size_t base = bytes_vivos_memoria();
+        reiniciar_pico_memoria();
+        
+        for (int r = 0; r < repeticiones; r++) {
+            uint64_t t0 = reloj_ns();
+            anterior = tabla[s].resolver(grafo, inicio, fin, &distancia, &expandidos, datos);
+            muestras[r] = (reloj_ns() - t0) / 1000.0;
+        }
+        size_t heap = bytes_pico_memoria() - base;
+        
+        resumen_tiempos resumen;
+        resumir_tiempos(muestras, repeticiones, &resumen);
+        int pasos = (anterior && distancia >= 0)
+                    ? contar_pasos(anterior, inicio, fin, grafo->num_nodos) : -1;
+        
+        if (s == 0) costo_referencia = distancia;
+        
+        printf("%-10s %11.2f %11.2f %11d %10.1f %10.1f %7d %7d  ", tabla[s].nombre,
+               resumen.mediana, resumen.p95, expandidos, heap / 1024.0,
+               pila_estimada(tabla[s].nombre) / 1024.0, pasos, distancia);
+        if (s == 0) {
+            printf("referencia\n");
+        } else if (distancia == costo_referencia) {
+            printf(COLOR_VERDE "sí" COLOR_RESET "\n");
+        } else {
+            printf(COLOR_ROJO "no (%+d)" COLOR_RESET "\n", distancia - costo_referencia);
+        }
+        
+        if (tabla[s].liberar) tabla[s].liberar(datos);
+    }
+    
+    liberar_memoria(muestras);
+}
+
+/*
+ * medir_arbol
+ * Mide Prim o Kruskal sobre un grafo y devuelve el peso del árbol.
+ */
+static int medir_arbol(grafo_matriz* grafo, int usar_kruskal, int repeticiones,
+                       double* muestras, resumen_tiempos* resumen, size_t* heap) {
+    int peso = 0;
+    size_t base = bytes_vivos_memoria();
+    reiniciar_pico_memoria();
+    
+    for (int r = 0; r < repeticiones; r++) {
+        int num_aristas;
+        uint64_t t0 = reloj_ns();
+        
+        if (usar_kruskal) {
+            arista* arbol = kruskal(grafo, &num_aristas);
+            muestras[r] = (reloj_ns() - t0) / 1000.0;
+            peso = 0;
+            for (int i = 0; arbol && i < num_aristas; i++) peso += arbol[i].peso;
+            liberar_aristas(arbol);
+        } else {
+            arista_prim* arbol = prim(grafo, &num_aristas);
+            muestras[r] = (reloj_ns() - t0) / 1000.0;
+            peso = 0;
+            for (int i = 0; i < num_aristas; i++) peso += arbol[i].peso;
+        }
+    }
+    
+    *heap = bytes_pico_memoria() - base;
+    resumir_tiempos(muestras, repeticiones, resumen);
+    return peso;
+}
+
+/*
+ * comparar_arboles_generadores
+ * Prim contra Kruskal en grafos conexos de varias densidades.
+ * La memoria es el pico de heap más la pila estimada de cada uno.
+ */
+void comparar_arboles_generadores(int repeticiones) {
+    static const int densidades[NUM_DENSIDADES] = {5, 25, 50, 100};   // % de aristas
+    grafo_matriz* grafo = (grafo_matriz*)reservar_memoria(MEM_ALGORITMOS, sizeof(grafo_matriz));
+    double* muestras = (double*)reservar_memoria(MEM_ALGORITMOS, repeticiones * sizeof(double));
+    
+    if (!grafo || !muestras) {
+        liberar_memoria(grafo);
+        liberar_memoria(muestras);
+        return;
+    }
+    
+    printf("%-9s %8s %11s %11s %9s %9s %8s %8s  %s\n", "Densidad", "Aristas",
+           "Prim µs", "Kruskal µs", "Prim KB", "Krusk KB", "Peso P", "Peso K", "Coincide");
+    
+    for (int d = 0; d < NUM_DENSIDADES; d++) {
+        inicializar_grafo_matriz(grafo, MAX_NODOS);
+        generar_grafo_con_densidad(grafo, densidades[d]);
+        
+        int aristas = 0;
+        for (int i = 0; i < grafo->num_nodos; i++) {
+            for (int j = i + 1; j < grafo->num_nodos; j++) {
+                if (grafo->matriz[i][j] != 0) aristas++;
+            }
+        }
+        
+        resumen_tiempos tiempo_prim, tiempo_kruskal;
+        size_t heap_prim, heap_kruskal;
+        int peso_prim = medir_arbol(grafo, 0, repeticiones, muestras, &tiempo_prim, &heap_prim);
+        int peso_kruskal = medir_arbol(grafo, 1, repeticiones, muestras, &tiempo_kruskal,
+                                       &heap_kruskal);
+        
+        printf("%8d%% %8d %11.1f %11.1f %9.1f %9.1f %8d %8d  %s\n", densidades[d], aristas,
+               tiempo_prim.mediana, tiempo_kruskal.mediana,
+               (heap_prim + pila_estimada("Prim")) / 1024.0,
+               (heap_kruskal + pila_estimada("Kruskal")) / 1024.0,
+               peso_prim, peso_kruskal, (peso_prim == peso_kruskal) ? "sí" : "no");
+    }
+    
+    liberar_grafo_matriz(grafo);
+    liberar_memoria(grafo);
+    liberar_memoria(muestras);
+}
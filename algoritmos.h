@@ -8,6 +8,7 @@
 #define ALGORITMOS_H
 
 #include "grafo.h"
+#include "traza.h"
 
 // ============================================================================
 // DEFINICIONES DE ESTRUCTURAS PARA ALGORITMOS
@@ -32,6 +33,35 @@ typedef struct {
     int en_arbol;   // Si está en el árbol
 } arista_prim;
 
+/*
+ * monticulo - Montículo binario indexado (mínimo por prioridad)
+ * posicion[] permite mejorar la prioridad de un nodo ya insertado.
+ */
+typedef struct {
+    int* nodos;         // Nodos en orden de montículo
+    int* posicion;      // Índice de cada nodo en 'nodos' (-1 = fuera)
+    int* prioridad;     // Prioridad de cada nodo
+    int tamano;         // Nodos en el montículo
+} monticulo;
+
+/*
+ * heuristica_nodo - Cota inferior del costo desde nodo hasta fin
+ */
+typedef int (*heuristica_nodo)(int nodo, int fin, const void* contexto);
+
+/*
+ * solucionador - Algoritmo de camino más corto registrado
+ * preparar/liberar son opcionales: precálculo por grafo que no se mide
+ * junto con la búsqueda y que se pasa a resolver como 'datos'.
+ */
+typedef struct {
+    const char* nombre;     // Nombre en las comparaciones
+    int* (*resolver)(grafo_matriz* grafo, int inicio, int fin, int* distancia_total,
+                     int* nodos_expandidos, const void* datos);
+    void* (*preparar)(grafo_matriz* grafo);
+    void (*liberar)(void* datos);
+} solucionador;
+
 // ============================================================================
 // PROTOTIPOS DE FUNCIONES - ALGORITMOS PRINCIPALES
 // ============================================================================
@@ -39,22 +69,47 @@ typedef struct {
 /* Dijkstra con visualización de estados */
 int* dijkstra_con_estados(grafo_matriz* grafo, int inicio, int fin, 
                          int* distancia_total, int mostrar_estados);
+int* dijkstra_con_traza(grafo_matriz* grafo, int inicio, int fin,
+                        int* distancia_total, traza_dijkstra* traza);
 
 /* Funciones auxiliares de Dijkstra */
 void imprimir_estado_dijkstra(int num_nodos, int distancia[], int anterior[], 
                               int visitado[], int nodo_actual, int iteracion);
+void imprimir_cambios_dijkstra(int distancia[], int anterior[], int visitado[],
+                               int nodo_actual, int iteracion,
+                               const int cambiados[], int num_cambiados);
+void establecer_rango_estados(int desde, int hasta);
 void reconstruir_camino_detallado(int* anterior, int inicio, int fin, 
                                   int distancia_total);
 
 /* Algoritmos de árboles generadores */
 arista_prim* prim(grafo_matriz* grafo, int* num_aristas);
 arista* kruskal(grafo_matriz* grafo, int* num_aristas);
+arista* kruskal_aristas(arista* aristas, int total_aristas, int num_nodos, int* num_aristas);
 
 /* Búsqueda en grafos */
 int* bfs(grafo_matriz* grafo, int inicio);
+int* a_estrella(grafo_matriz* grafo, int inicio, int fin, int* distancia_total,
+                heuristica_nodo heuristica, const void* contexto, int* nodos_expandidos);
+int heuristica_manhattan(int nodo, int fin, const void* contexto);
+int factor_manhattan_admisible(grafo_matriz* grafo);
+
+/* Montículo indexado (lo usa también la búsqueda jerárquica) */
+int crear_monticulo(monticulo* m, int n);
+void destruir_monticulo(monticulo* m);
+void insertar_o_mejorar(monticulo* m, int nodo, int prioridad);
+int extraer_minimo(monticulo* m);
+
+/* Comparación empírica */
+int obtener_solucionadores(const solucionador** tabla);
+void comparar_solucionadores(grafo_matriz* grafo, int inicio, int fin, int repeticiones);
+void comparar_arboles_generadores(int repeticiones);
 
 /* Análisis de grafos */
 void encontrar_caminos_criticos(grafo_matriz* grafo);
+int calcular_camino_critico(grafo_matriz* grafo, int* inicio_critico, int* fin_critico);
+int** distancias_todos_los_pares(grafo_matriz* grafo);
+void floyd_warshall_en_sitio(int** distancias, int n);
 void encontrar_componentes_conexas(grafo_matriz* grafo);
 void ordenacion_topologica(grafo_matriz* grafo);
 
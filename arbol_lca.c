@@ -0,0 +1,306 @@
+/*
+ * arbol_lca.c
+ * Índice LCA para consultas de distancia y camino entre pares de celdas.
+ * Un DFS iterativo arma el árbol y su recorrido de Euler; una tabla
+ * dispersa responde el mínimo de profundidad de cada rango en O(1).
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "arbol_lca.h"
+#include "memoria.h"
+
+// ==================== CONSTRUCCIÓN ====================
+
+/*
+ * agregar_portal
+ * Suma nodo a los portales si no estaba. Retorna 0 si no hay lugar.
+ */
+static int agregar_portal(arbol_lca* arbol, int nodo) {
+    for (int i = 0; i < arbol->num_portales; i++) {
+        if (arbol->portales[i] == nodo) return 1;
+    }
+    if (arbol->num_portales == MAX_PORTALES_LCA) return 0;
+    arbol->portales[arbol->num_portales++] = nodo;
+    return 1;
+}
+
+/*
+ * recorrer_arboles
+ * DFS iterativo desde cada celda abierta sin visitar. Llena padre,
+ * profundidad, componente, primera y el recorrido de Euler, y anota
+ * como portales los extremos de las aristas que cierran ciclos.
+ */
+static int recorrer_arboles(arbol_lca* arbol, const unsigned char* vecinos,
+                            int* pila, unsigned char* siguiente_dir) {
+    int componentes = 0;
+
+    for (int raiz = 0; raiz < MAX_NODOS; raiz++) {
+        if (arbol->componente[raiz] != -1) continue;  // Pared o ya visitada
+
+        int tope = 0;
+        arbol->componente[raiz] = componentes;
+        arbol->profundidad[raiz] = 0;
+        arbol->primera[raiz] = arbol->longitud_euler;
+        arbol->euler[arbol->longitud_euler++] = raiz;
+        pila[tope] = raiz;
+        siguiente_dir[tope++] = 0;
+
+        while (tope > 0) {
+            int u = pila[tope - 1];
+            int d = siguiente_dir[tope - 1];
+
+            if (d == 4) {  // Sin más hijos: vuelve al padre
+                tope--;
+                if (tope > 0) arbol->euler[arbol->longitud_euler++] = pila[tope - 1];
+                continue;
+            }
+            siguiente_dir[tope - 1]++;
+            if (!(vecinos[u] & (1 << d))) continue;
+
+            int v = u + PASO_VECINO(d);
+            if (arbol->componente[v] == -1) {
+                arbol->componente[v] = componentes;
+                arbol->padre[v] = u;
+                arbol->profundidad[v] = arbol->profundidad[u] + 1;
+                arbol->primera[v] = arbol->longitud_euler;
+                arbol->euler[arbol->longitud_euler++] = v;
+                pila[tope] = v;
+                siguiente_dir[tope++] = 0;
+            } else if (v != arbol->padre[u] && u < v) {
+                // Arista fuera del árbol (cada una se ve desde ambos extremos)
+                if (!agregar_portal(arbol, u) || !agregar_portal(arbol, v)) return 0;
+            }
+        }
+        componentes++;
+    }
+    return 1;
+}
+
+/*
+ * llenar_tabla
+ * Tabla dispersa sobre el recorrido de Euler: cada fila j guarda el
+ * nodo menos profundo de los rangos de largo 2^j.
+ */
+static void llenar_tabla(arbol_lca* arbol) {
+    int n = arbol->longitud_euler;
+
+    arbol->logaritmo[1] = 0;
+    for (int i = 2; i <= n; i++) arbol->logaritmo[i] = arbol->logaritmo[i / 2] + 1;
+
+    memcpy(arbol->tabla, arbol->euler, (size_t)n * sizeof(int));
+    for (int j = 1; j < arbol->niveles; j++) {
+        const int* previa = arbol->tabla + (size_t)(j - 1) * n;
+        int* fila = arbol->tabla + (size_t)j * n;
+        int mitad = 1 << (j - 1);
+        for (int i = 0; i + (1 << j) <= n; i++) {
+            int a = previa[i], b = previa[i + mitad];
+            fila[i] = arbol->profundidad[a] <= arbol->profundidad[b] ? a : b;
+        }
+    }
+}
+
+/*
+ * construir_arbol_lca
+ * Prepara el índice de un laberinto. Retorna NULL (con error) si falta
+ * memoria o si hay más de MAX_PORTALES_LCA extremos de ciclos; en ese
+ * caso conviene resolver con BFS (ver resolver_lote_consultas).
+ */
+arbol_lca* construir_arbol_lca(laberinto* lab, const char** error) {
+    arbol_lca* arbol = (arbol_lca*)reservar_memoria_cero(MEM_ALGORITMOS, 1, sizeof(arbol_lca));
+    size_t bytes_aux = MAX_NODOS * (2 * sizeof(int) + 2);
+    char* aux = (char*)reservar_memoria(MEM_ALGORITMOS, bytes_aux);
+    *error = "sin memoria";
+    if (arbol == NULL || aux == NULL) {
+        liberar_memoria(arbol);
+        liberar_memoria(aux);
+        return NULL;
+    }
+    int* pila = (int*)aux;
+    int* cola = pila + MAX_NODOS;
+    unsigned char* vecinos = (unsigned char*)(cola + MAX_NODOS);
+    unsigned char* siguiente_dir = vecinos + MAX_NODOS;
+
+    // Recorrido de Euler: a lo sumo 2 * MAX_NODOS - 1 nodos
+    arbol->euler = (int*)reservar_memoria(MEM_ALGORITMOS, 2 * (size_t)MAX_NODOS * sizeof(int));
+    if (arbol->euler == NULL) {
+        liberar_memoria(aux);
+        destruir_arbol_lca(arbol);
+        return NULL;
+    }
+
+    // Paredes en -2 mientras se recorre; al final quedan en -1
+    calcular_vecinos(lab, vecinos);
+    for (int n = 0; n < MAX_NODOS; n++) {
+        arbol->padre[n] = -1;
+        arbol->componente[n] = (lab->celdas[n / COLUMNAS][n % COLUMNAS] == PARED) ? -2 : -1;
+    }
+    int ok = recorrer_arboles(arbol, vecinos, pila, siguiente_dir);
+    for (int n = 0; n < MAX_NODOS; n++) {
+        if (arbol->componente[n] == -2) arbol->componente[n] = -1;
+    }
+    if (!ok) {
+        *error = "demasiados ciclos para el índice LCA";
+        liberar_memoria(aux);
+        destruir_arbol_lca(arbol);
+        return NULL;
+    }
+
+    // Tabla dispersa del tamaño justo
+    int n = arbol->longitud_euler > 0 ? arbol->longitud_euler : 1;
+    arbol->niveles = 1;
+    while ((1 << arbol->niveles) <= n) arbol->niveles++;
+    arbol->tabla = (int*)reservar_memoria(MEM_ALGORITMOS,
+                                          (size_t)arbol->niveles * n * sizeof(int));
+    arbol->logaritmo = (unsigned char*)reservar_memoria(MEM_ALGORITMOS, (size_t)n + 1);
+    if (arbol->num_portales > 0) {
+        size_t celdas = (size_t)arbol->num_portales * MAX_NODOS;
+        arbol->distancia_portal = (int*)reservar_memoria(MEM_ALGORITMOS, celdas * sizeof(int));
+        arbol->anterior_portal = (int*)reservar_memoria(MEM_ALGORITMOS, celdas * sizeof(int));
+    }
+    if (!arbol->tabla || !arbol->logaritmo ||
+        (arbol->num_portales > 0 && (!arbol->distancia_portal || !arbol->anterior_portal))) {
+        liberar_memoria(aux);
+        destruir_arbol_lca(arbol);
+        return NULL;
+    }
+    if (arbol->longitud_euler > 0) llenar_tabla(arbol);
+
+    // Un BFS completo por portal para los caminos que salen del árbol
+    for (int i = 0; i < arbol->num_portales; i++) {
+        recorrer_anchura_vecinos(vecinos, arbol->portales[i],
+                                 arbol->distancia_portal + (size_t)i * MAX_NODOS,
+                                 arbol->anterior_portal + (size_t)i * MAX_NODOS, cola);
+    }
+
+    liberar_memoria(aux);
+    *error = NULL;
+    return arbol;
+}
+
+/*
+ * destruir_arbol_lca
+ * Libera el índice y sus tablas.
+ */
+void destruir_arbol_lca(arbol_lca* arbol) {
+    if (arbol == NULL) return;
+    liberar_memoria(arbol->euler);
+    liberar_memoria(arbol->tabla);
+    liberar_memoria(arbol->logaritmo);
+    liberar_memoria(arbol->distancia_portal);
+    liberar_memoria(arbol->anterior_portal);
+    liberar_memoria(arbol);
+}
+
+// ==================== CONSULTAS ====================
+
+/*
+ * ancestro_comun
+ * LCA de u y v en O(1); -1 si no están en el mismo árbol.
+ */
+int ancestro_comun(const arbol_lca* arbol, int u, int v) {
+    if (u < 0 || v < 0 || u >= MAX_NODOS || v >= MAX_NODOS) return -1;
+    if (arbol->componente[u] < 0 || arbol->componente[u] != arbol->componente[v]) return -1;
+
+    int i = arbol->primera[u], j = arbol->primera[v];
+    if (i > j) {
+        int t = i;
+        i = j;
+        j = t;
+    }
+    int k = arbol->logaritmo[j - i + 1];
+    const int* fila = arbol->tabla + (size_t)k * arbol->longitud_euler;
+    int a = fila[i], b = fila[j - (1 << k) + 1];
+    return arbol->profundidad[a] <= arbol->profundidad[b] ? a : b;
+}
+
+/*
+ * mejor_ruta
+ * Distancia más corta de u a v y por dónde pasa: -1 por el árbol o el
+ * índice del portal. Retorna -1 si no hay camino.
+ */
+static int mejor_ruta(const arbol_lca* arbol, int u, int v, int* via) {
+    int lca = ancestro_comun(arbol, u, v);
+    if (lca < 0) return -1;
+
+    int mejor = arbol->profundidad[u] + arbol->profundidad[v] - 2 * arbol->profundidad[lca];
+    *via = -1;
+    for (int i = 0; i < arbol->num_portales; i++) {
+        const int* distancia = arbol->distancia_portal + (size_t)i * MAX_NODOS;
+        if (distancia[u] < 0) continue;  // Portal de otro árbol
+        if (distancia[u] + distancia[v] < mejor) {
+            mejor = distancia[u] + distancia[v];
+            *via = i;
+        }
+    }
+    return mejor;
+}
+
+/*
+ * distancia_lca
+ * Pasos del camino más corto entre u y v (-1 sin camino).
+ */
+int distancia_lca(const arbol_lca* arbol, int u, int v) {
+    int via;
+    return mejor_ruta(arbol, u, v, &via);
+}
+
+/*
+ * camino_lca
+ * Escribe el camino de u a v en O(L) sin buscar: sube desde cada
+ * extremo hasta el LCA (o hasta el portal) y une las dos mitades.
+ * camino debe tener lugar para MAX_NODOS nodos; retorna los nodos
+ * escritos o 0 si no hay camino.
+ */
+int camino_lca(const arbol_lca* arbol, int u, int v, int* camino) {
+    int via;
+    int pasos = mejor_ruta(arbol, u, v, &via);
+    if (pasos < 0) return 0;
+
+    const int* padre = arbol->padre;
+    int encuentro = ancestro_comun(arbol, u, v);
+    if (via >= 0) {
+        padre = arbol->anterior_portal + (size_t)via * MAX_NODOS;
+        encuentro = arbol->portales[via];
+    }
+
+    int pos = 0;
+    for (int w = u; w != encuentro; w = padre[w]) camino[pos++] = w;
+    camino[pos] = encuentro;
+    pos = pasos;
+    for (int w = v; w != encuentro; w = padre[w]) camino[pos--] = w;
+    return pasos + 1;
+}
+
+/*
+ * resolver_lote_lca
+ * Igual que resolver_lote_consultas pero con el índice: cada consulta
+ * cuesta O(1 + portales) y su camino O(L). Retorna 0 sin memoria.
+ */
+int resolver_lote_lca(const arbol_lca* arbol, consulta_ruta* consultas, int cantidad,
+                      int con_camino, resumen_lote* resumen) {
+    size_t total = 0;
+
+    memset(resumen, 0, sizeof(*resumen));
+    resumen->hilos = 1;
+    for (int k = 0; k < cantidad; k++) {
+        consultas[k].camino = NULL;
+        consultas[k].pasos = distancia_lca(arbol, consultas[k].origen, consultas[k].destino);
+        if (consultas[k].pasos >= 0) total += (size_t)consultas[k].pasos + 1;
+    }
+    if (!con_camino || cantidad <= 0) return 1;
+
+    // Un solo bloque para todos los caminos, como en los lotes BFS
+    int* nodos = (int*)reservar_memoria(MEM_ALGORITMOS, (total ? total : 1) * sizeof(int));
+    if (nodos == NULL) return 0;
+    size_t usado = 0;
+    for (int k = 0; k < cantidad; k++) {
+        if (consultas[k].pasos < 0) continue;
+        consultas[k].camino = nodos + usado;
+        usado += (size_t)camino_lca(arbol, consultas[k].origen, consultas[k].destino,
+                                    consultas[k].camino);
+    }
+    resumen->nodos_caminos = nodos;
+    return 1;
+}
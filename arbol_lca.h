@@ -0,0 +1,58 @@
+/*
+ * arbol_lca.h
+ * Distancias y caminos entre celdas arbitrarias con ancestro común más
+ * bajo (LCA). Pensado para laberintos perfectos, cuyo grafo es un árbol
+ * salvo por unos pocos ciclos junto a la entrada y la salida.
+ */
+
+#ifndef ARBOL_LCA_H
+#define ARBOL_LCA_H
+
+#include "laberinto.h"
+#include "consultas.h"
+
+// ============================================================================
+// DEFINICIONES DEL ÍNDICE
+// ============================================================================
+
+// Extremos de aristas fuera del árbol que se admiten; cada uno guarda un BFS
+#define MAX_PORTALES_LCA 16
+
+/*
+ * arbol_lca - Árbol DFS con recorrido de Euler y tabla dispersa
+ * La distancia en el árbol sale del LCA en O(1). Cada arista que cierra
+ * un ciclo aporta sus extremos como portales: un camino más corto que no
+ * es el del árbol pasa por alguno de ellos.
+ */
+typedef struct {
+    int padre[MAX_NODOS];               // Padre en el árbol (-1 en raíces y paredes)
+    int profundidad[MAX_NODOS];         // Aristas hasta la raíz
+    int componente[MAX_NODOS];          // Árbol de la celda (-1 en paredes)
+    int primera[MAX_NODOS];             // Primera aparición en el recorrido de Euler
+    int longitud_euler;                 // Nodos del recorrido
+    int niveles;                        // Filas de la tabla dispersa
+    int* euler;                         // Recorrido de Euler de todos los árboles
+    int* tabla;                         // tabla[j * longitud_euler + i]: menos profundo en [i, i + 2^j)
+    unsigned char* logaritmo;           // logaritmo[n] = piso(log2 n)
+    int num_portales;                   // Extremos de aristas fuera del árbol
+    int portales[MAX_PORTALES_LCA];     // Nodos portal
+    int* distancia_portal;              // BFS de cada portal (num_portales * MAX_NODOS)
+    int* anterior_portal;               // Árbol BFS de cada portal, hacia el portal
+} arbol_lca;
+
+// ============================================================================
+// PROTOTIPOS DE FUNCIONES
+// ============================================================================
+
+/* Construcción */
+arbol_lca* construir_arbol_lca(laberinto* lab, const char** error);
+void destruir_arbol_lca(arbol_lca* arbol);
+
+/* Consultas */
+int ancestro_comun(const arbol_lca* arbol, int u, int v);
+int distancia_lca(const arbol_lca* arbol, int u, int v);
+int camino_lca(const arbol_lca* arbol, int u, int v, int* camino);
+int resolver_lote_lca(const arbol_lca* arbol, consulta_ruta* consultas, int cantidad,
+                      int con_camino, resumen_lote* resumen);
+
+#endif // ARBOL_LCA_H
@@ -0,0 +1,537 @@
+/*
+ * arbol_sucinto.c
+ * Árbol generador de un laberinto perfecto en 2 bits por habitación.
+ * El padre, los hijos y la profundidad se leen de los bits sin expandir;
+ * el generador nativo usa los propios punteros al padre como pila.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include "arbol_sucinto.h"
+#include "memoria.h"
+
+static const int direccion_opuesta[4] = {DIR_SUR, DIR_NORTE, DIR_OESTE, DIR_ESTE};
+
+// ==================== CREACIÓN Y DESTRUCCIÓN ====================
+
+#define BYTES_DIRECCIONES(arbol) (((size_t)(arbol)->filas * (arbol)->columnas + 3) / 4)
+#define BYTES_BORDE(arbol) (((size_t)2 * ((arbol)->filas + (arbol)->columnas) + 7) / 8)
+
+/*
+ * crear_arbol_sucinto
+ * Reserva un árbol de filas x columnas habitaciones sin enlaces.
+ */
+arbol_sucinto* crear_arbol_sucinto(int filas, int columnas) {
+    if (filas <= 0 || columnas <= 0 || (long long)filas * columnas > INT_MAX / 2) return NULL;
+
+    arbol_sucinto* arbol = (arbol_sucinto*)reservar_memoria_cero(MEM_LABERINTO, 1,
+                                                                  sizeof(arbol_sucinto));
+    if (arbol == NULL) return NULL;
+    arbol->filas = filas;
+    arbol->columnas = columnas;
+    arbol->fila_inicio = arbol->columna_inicio = -1;
+    arbol->fila_final = arbol->columna_final = -1;
+    arbol->direcciones = (unsigned char*)reservar_memoria_cero(MEM_LABERINTO, 1,
+                                                               BYTES_DIRECCIONES(arbol));
+    arbol->borde = (unsigned char*)reservar_memoria_cero(MEM_LABERINTO, 1, BYTES_BORDE(arbol));
+    if (arbol->direcciones == NULL || arbol->borde == NULL) {
+        destruir_arbol_sucinto(arbol);
+        return NULL;
+    }
+    return arbol;
+}
+
+/*
+ * destruir_arbol_sucinto
+ * Libera el árbol y sus bits.
+ */
+void destruir_arbol_sucinto(arbol_sucinto* arbol) {
+    if (arbol == NULL) return;
+    liberar_memoria(arbol->direcciones);
+    liberar_memoria(arbol->borde);
+    liberar_memoria(arbol);
+}
+
+/*
+ * bytes_arbol_sucinto
+ * Memoria ocupada por el árbol, incluida la estructura.
+ */
+size_t bytes_arbol_sucinto(const arbol_sucinto* arbol) {
+    return sizeof(arbol_sucinto) + BYTES_DIRECCIONES(arbol) + BYTES_BORDE(arbol);
+}
+
+// ==================== BITS ====================
+
+static void fijar_direccion(arbol_sucinto* arbol, int h, int direccion) {
+    unsigned char* byte = &arbol->direcciones[h >> 2];
+    int desplazamiento = (h & 3) * 2;
+    *byte = (unsigned char)((*byte & ~(3 << desplazamiento)) | (direccion << desplazamiento));
+}
+
+/*
+ * indice_borde
+ * Bit de la pared del perímetro de la habitación (f, c) en la
+ * dirección dada, o -1 si esa pared es interior.
+ */
+static int indice_borde(const arbol_sucinto* arbol, int f, int c, int direccion) {
+    switch (direccion) {
+        case DIR_NORTE: return f == 0 ? c : -1;
+        case DIR_SUR: return f == arbol->filas - 1 ? arbol->columnas + c : -1;
+        case DIR_OESTE: return c == 0 ? 2 * arbol->columnas + f : -1;
+        default: return c == arbol->columnas - 1 ? 2 * arbol->columnas + arbol->filas + f : -1;
+    }
+}
+
+static void abrir_borde(arbol_sucinto* arbol, int f, int c, int direccion) {
+    int bit = indice_borde(arbol, f, c, direccion);
+    if (bit >= 0) arbol->borde[bit >> 3] |= (unsigned char)(1 << (bit & 7));
+}
+
+static int borde_abierto(const arbol_sucinto* arbol, int f, int c, int direccion) {
+    int bit = indice_borde(arbol, f, c, direccion);
+    return bit >= 0 && (arbol->borde[bit >> 3] & (1 << (bit & 7)));
+}
+
+/*
+ * vecina_sucinto
+ * Habitación en la dirección dada, o -1 fuera del laberinto.
+ */
+static int vecina_sucinto(const arbol_sucinto* arbol, int h, int direccion) {
+    int f = h / arbol->columnas;
+    int c = h % arbol->columnas;
+
+    switch (direccion) {
+        case DIR_NORTE: return f > 0 ? h - arbol->columnas : -1;
+        case DIR_SUR: return f < arbol->filas - 1 ? h + arbol->columnas : -1;
+        case DIR_ESTE: return c < arbol->columnas - 1 ? h + 1 : -1;
+        default: return c > 0 ? h - 1 : -1;
+    }
+}
+
+/*
+ * es_hijo
+ * 1 si la vecina de h en la dirección dada tiene a h como padre.
+ */
+static int es_hijo(const arbol_sucinto* arbol, int h, int direccion, int* hijo) {
+    int w = vecina_sucinto(arbol, h, direccion);
+    if (w < 0 || w == arbol->raiz) return 0;
+    if ((int)DIRECCION_PADRE(arbol, w) != direccion_opuesta[direccion]) return 0;
+    *hijo = w;
+    return 1;
+}
+
+// ==================== NAVEGACIÓN ====================
+
+/*
+ * padre_sucinto
+ * Habitación padre, o -1 en la raíz.
+ */
+int padre_sucinto(const arbol_sucinto* arbol, int habitacion) {
+    if (habitacion == arbol->raiz) return -1;
+    return vecina_sucinto(arbol, habitacion, DIRECCION_PADRE(arbol, habitacion));
+}
+
+/*
+ * hijos_sucinto
+ * Llena hijos con las vecinas que apuntan a esta habitación.
+ * Retorna cuántos hay (0 a 4).
+ */
+int hijos_sucinto(const arbol_sucinto* arbol, int habitacion, int hijos[4]) {
+    int total = 0;
+    for (int d = 0; d < 4; d++) {
+        if (es_hijo(arbol, habitacion, d, &hijos[total])) total++;
+    }
+    return total;
+}
+
+/*
+ * profundidad_sucinto
+ * Aristas hasta la raíz, subiendo por los bits del padre.
+ */
+int profundidad_sucinto(const arbol_sucinto* arbol, int habitacion) {
+    int profundidad = 0;
+    for (int h = habitacion; h != arbol->raiz; h = padre_sucinto(arbol, h)) profundidad++;
+    return profundidad;
+}
+
+/*
+ * distancia_sucinto
+ * Aristas entre dos habitaciones: iguala profundidades y sube
+ * por ambos lados hasta el ancestro común. O(profundidad).
+ */
+long distancia_sucinto(const arbol_sucinto* arbol, int u, int v) {
+    int pu = profundidad_sucinto(arbol, u);
+    int pv = profundidad_sucinto(arbol, v);
+    long distancia = 0;
+
+    for (; pu > pv; pu--, distancia++) u = padre_sucinto(arbol, u);
+    for (; pv > pu; pv--, distancia++) v = padre_sucinto(arbol, v);
+    while (u != v) {
+        u = padre_sucinto(arbol, u);
+        v = padre_sucinto(arbol, v);
+        distancia += 2;
+    }
+    return distancia;
+}
+
+/*
+ * agregar_enlace
+ * Suma la habitación (f, c) a los enlaces si existe.
+ */
+static void agregar_enlace(const arbol_sucinto* arbol, int f, int c, int pasos_hasta,
+                           int habitaciones[8], int pasos[8], int* total) {
+    if (f < 0 || f >= arbol->filas || c < 0 || c >= arbol->columnas) return;
+    habitaciones[*total] = f * arbol->columnas + c;
+    pasos[(*total)++] = pasos_hasta;
+}
+
+/*
+ * pared_abierta_sucinto
+ * 1 si la pared de la habitación h en la dirección dada está abierta.
+ */
+static int pared_abierta_sucinto(const arbol_sucinto* arbol, int h, int direccion) {
+    int w = vecina_sucinto(arbol, h, direccion);
+    int hijo;
+
+    if (w < 0) return borde_abierto(arbol, h / arbol->columnas, h % arbol->columnas, direccion);
+    return padre_sucinto(arbol, h) == w || es_hijo(arbol, h, direccion, &hijo);
+}
+
+/*
+ * enlaces_sucinto
+ * Habitaciones a las que se llega desde una celda de INICIO o FINAL
+ * y los pasos hasta cada una (0 habitación, 1 pared, 2 esquina).
+ */
+static int enlaces_sucinto(const arbol_sucinto* arbol, int fila, int columna,
+                           int habitaciones[8], int pasos[8]) {
+    int total = 0;
+
+    if (fila % 2 == 1 && columna % 2 == 1) {            // Habitación
+        agregar_enlace(arbol, fila / 2, columna / 2, 0, habitaciones, pasos, &total);
+    } else if (fila % 2 == 0 && columna % 2 == 1) {     // Pared horizontal
+        agregar_enlace(arbol, fila / 2 - 1, columna / 2, 1, habitaciones, pasos, &total);
+        agregar_enlace(arbol, fila / 2, columna / 2, 1, habitaciones, pasos, &total);
+    } else if (fila % 2 == 1) {                         // Pared vertical
+        agregar_enlace(arbol, fila / 2, columna / 2 - 1, 1, habitaciones, pasos, &total);
+        agregar_enlace(arbol, fila / 2, columna / 2, 1, habitaciones, pasos, &total);
+    } else {
+        // Esquina: habitaciones en diagonal con alguna pared abierta hacia ella
+        for (int df = -1; df <= 0; df++) {
+            for (int dc = -1; dc <= 0; dc++) {
+                int f = fila / 2 + df, c = columna / 2 + dc;
+                if (f < 0 || f >= arbol->filas || c < 0 || c >= arbol->columnas) continue;
+                int h = f * arbol->columnas + c;
+                if (pared_abierta_sucinto(arbol, h, df ? DIR_SUR : DIR_NORTE) ||
+                    pared_abierta_sucinto(arbol, h, dc ? DIR_ESTE : DIR_OESTE)) {
+                    agregar_enlace(arbol, f, c, 2, habitaciones, pasos, &total);
+                }
+            }
+        }
+    }
+    return total;
+}
+
+/*
+ * pasos_sucinto
+ * Pasos del camino más corto de INICIO a FINAL en celdas, -1 si falta
+ * alguno o no se conectan con una habitación.
+ */
+long pasos_sucinto(const arbol_sucinto* arbol) {
+    int desde[8], pasos_desde[8], hasta[8], pasos_hasta[8];
+    long mejor = -1;
+
+    if (arbol->fila_inicio < 0 || arbol->fila_final < 0) return -1;
+    int n = enlaces_sucinto(arbol, arbol->fila_inicio, arbol->columna_inicio, desde, pasos_desde);
+    int m = enlaces_sucinto(arbol, arbol->fila_final, arbol->columna_final, hasta, pasos_hasta);
+
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < m; j++) {
+            long pasos = pasos_desde[i] + 2 * distancia_sucinto(arbol, desde[i], hasta[j]) +
+                         pasos_hasta[j];
+            if (mejor < 0 || pasos < mejor) mejor = pasos;
+        }
+    }
+    return mejor;
+}
+
+// ==================== GENERACIÓN Y CONVERSIÓN ====================
+
+/*
+ * generar_arbol_sucinto
+ * DFS aleatorio sobre las habitaciones sin pila: al retroceder sigue
+ * los bits del padre. Solo reserva un bit de visitado por habitación.
+ * Abre el perímetro junto a la primera y la última habitación y pone
+ * INICIO y FINAL en las esquinas, como generar_celdas_segun_tipo.
+ */
+int generar_arbol_sucinto(arbol_sucinto* arbol) {
+    int total = arbol->filas * arbol->columnas;
+    unsigned char* visitado = (unsigned char*)reservar_memoria_cero(MEM_LABERINTO, 1,
+                                                                    ((size_t)total + 7) / 8);
+    if (visitado == NULL) return 0;
+
+    sembrar_aleatorio();    // Inicializa generador
+    memset(arbol->direcciones, 0, BYTES_DIRECCIONES(arbol));
+    memset(arbol->borde, 0, BYTES_BORDE(arbol));
+    arbol->raiz = 0;
+
+    int actual = 0;
+    visitado[0] = 1;
+    for (;;) {
+        int candidatas[4];
+        int num_candidatas = 0;
+
+        for (int d = 0; d < 4; d++) {
+            int w = vecina_sucinto(arbol, actual, d);
+            if (w >= 0 && !(visitado[w >> 3] & (1 << (w & 7)))) candidatas[num_candidatas++] = d;
+        }
+
+        if (num_candidatas > 0) {
+            int d = candidatas[rand() % num_candidatas];   // Dirección aleatoria
+            int siguiente = vecina_sucinto(arbol, actual, d);
+            fijar_direccion(arbol, siguiente, direccion_opuesta[d]);
+            visitado[siguiente >> 3] |= (unsigned char)(1 << (siguiente & 7));
+            actual = siguiente;
+        } else if (actual == arbol->raiz) {
+            break;  // Volvió a la raíz sin vecinas libres: terminó
+        } else {
+            actual = padre_sucinto(arbol, actual);  // Backtrack por el padre
+        }
+    }
+    liberar_memoria(visitado);
+
+    // Entrada y salida en esquinas opuestas
+    abrir_borde(arbol, 0, 0, DIR_NORTE);
+    abrir_borde(arbol, 0, 0, DIR_OESTE);
+    abrir_borde(arbol, arbol->filas - 1, arbol->columnas - 1, DIR_SUR);
+    abrir_borde(arbol, arbol->filas - 1, arbol->columnas - 1, DIR_ESTE);
+    arbol->fila_inicio = arbol->columna_inicio = 0;
+    arbol->fila_final = 2 * arbol->filas;
+    arbol->columna_final = 2 * arbol->columnas;
+    return 1;
+}
+
+/*
+ * extremo_valido
+ * Una entrada o salida es (-1, -1) si no hay, o una celda dentro de las
+ * 2*filas+1 x 2*columnas+1 del árbol.
+ */
+static int extremo_valido(const arbol_sucinto* arbol, int fila, int columna) {
+    if (fila == -1 && columna == -1) return 1;
+    return fila >= 0 && fila <= 2 * arbol->filas && columna >= 0 && columna <= 2 * arbol->columnas;
+}
+
+/*
+ * validar_arbol_sucinto
+ * Recorre el árbol desde la raíz sin pila (baja por los hijos y sube
+ * por el padre). Es un árbol válido si alcanza todas las habitaciones.
+ */
+static int validar_arbol_sucinto(const arbol_sucinto* arbol) {
+    long total = (long)arbol->filas * arbol->columnas;
+    long visitadas = 1;
+    int actual = arbol->raiz;
+    int d = 0;  // Próxima dirección a probar en actual
+
+    if (arbol->raiz < 0 || arbol->raiz >= total) return 0;
+    for (;;) {
+        int hijo;
+        while (d < 4 && !es_hijo(arbol, actual, d, &hijo)) d++;
+        if (d < 4) {
+            actual = hijo;
+            d = 0;
+            if (++visitadas > total) return 0;
+        } else if (actual == arbol->raiz) {
+            break;
+        } else {
+            // Sigue con la dirección posterior a la de la que vino
+            d = direccion_opuesta[DIRECCION_PADRE(arbol, actual)];
+            actual = padre_sucinto(arbol, actual);
+            d++;
+        }
+    }
+    return visitadas == total;
+}
+
+/*
+ * celdas_a_sucinto
+ * Construye el árbol de un laberinto perfecto en formato de bloques
+ * (p. ej. salido de generar_perfecto). Retorna NULL con error si no
+ * sigue el formato o si sus habitaciones no forman un árbol.
+ */
+arbol_sucinto* celdas_a_sucinto(laberinto* lab, const char** error) {
+    laberinto_compacto lc;
+
+    if (!celdas_a_compacto(lab, &lc)) {
+        *error = "no sigue el formato de bloques";
+        return NULL;
+    }
+    arbol_sucinto* arbol = crear_arbol_sucinto(lc.filas, lc.columnas);
+    if (arbol == NULL) {
+        *error = "sin memoria";
+        return NULL;
+    }
+
+    // BFS desde la habitación 0: el padre es la vecina que la descubrió
+    int cola[MAX_HABITACIONES];
+    unsigned char visitada[MAX_HABITACIONES] = {0};
+    int total = lc.filas * lc.columnas;
+    int frente = 0, fin = 0, paredes_abiertas = 0;
+    visitada[0] = 1;
+    cola[fin++] = 0;
+    while (frente < fin) {
+        int h = cola[frente++];
+        int f = h / lc.columnas, c = h % lc.columnas;
+        for (int d = 0; d < 4; d++) {
+            if (hay_pared_compacto(&lc, f, c, d)) continue;
+            int w = vecina_sucinto(arbol, h, d);
+            if (w < 0) {
+                abrir_borde(arbol, f, c, d);
+                continue;
+            }
+            paredes_abiertas++;  // Cada pared interior se cuenta dos veces
+            if (!visitada[w]) {
+                visitada[w] = 1;
+                fijar_direccion(arbol, w, direccion_opuesta[d]);
+                cola[fin++] = w;
+            }
+        }
+    }
+
+    if (fin != total || paredes_abiertas / 2 != total - 1) {
+        *error = (fin != total) ? "habitaciones desconectadas" : "tiene ciclos entre habitaciones";
+        destruir_arbol_sucinto(arbol);
+        return NULL;
+    }
+
+    arbol->raiz = 0;
+    arbol->fila_inicio = lc.fila_inicio;
+    arbol->columna_inicio = lc.columna_inicio;
+    arbol->fila_final = lc.fila_final;
+    arbol->columna_final = lc.columna_final;
+    strncpy(arbol->nombre, lab->nombre, MAX_NOMBRE - 1);
+    arbol->nombre[MAX_NOMBRE - 1] = '\0';
+    *error = NULL;
+    return arbol;
+}
+
+/*
+ * sucinto_a_celdas
+ * Expande el árbol al formato de bloques (vía laberinto_compacto).
+ * Retorna 0 si no entra en FILAS x COLUMNAS.
+ */
+int sucinto_a_celdas(const arbol_sucinto* arbol, laberinto* lab) {
+    laberinto_compacto lc;
+
+    if (arbol->filas > FILAS_COMPACTO || arbol->columnas > COLUMNAS_COMPACTO ||
+        !extremo_valido(arbol, arbol->fila_inicio, arbol->columna_inicio) ||
+        !extremo_valido(arbol, arbol->fila_final, arbol->columna_final) ||
+        arbol->fila_final >= FILAS || arbol->columna_final >= COLUMNAS ||
+        arbol->fila_inicio >= FILAS || arbol->columna_inicio >= COLUMNAS) {
+        return 0;
+    }
+
+    inicializar_compacto(&lc);
+    lc.filas = arbol->filas;
+    lc.columnas = arbol->columnas;
+    for (int h = 0; h < arbol->filas * arbol->columnas; h++) {
+        int f = h / arbol->columnas, c = h % arbol->columnas;
+        if (h != arbol->raiz) abrir_pared_compacto(&lc, f, c, DIRECCION_PADRE(arbol, h));
+        for (int d = 0; d < 4; d++) {
+            if (borde_abierto(arbol, f, c, d)) abrir_pared_compacto(&lc, f, c, d);
+        }
+    }
+    lc.fila_inicio = arbol->fila_inicio;
+    lc.columna_inicio = arbol->columna_inicio;
+    lc.fila_final = arbol->fila_final;
+    lc.columna_final = arbol->columna_final;
+
+    lab->filas = FILAS;
+    lab->columnas = COLUMNAS;
+    strcpy(lab->nombre, arbol->nombre);
+    compacto_a_celdas(&lc, lab);
+    calcular_solucion(lab);
+    return 1;
+}
+
+// ==================== ARCHIVOS ====================
+
+/*
+ * guardar_arbol_sucinto
+ * Cabecera, bits de direcciones y bits de borde. Retorna 1 si pudo.
+ */
+int guardar_arbol_sucinto(const arbol_sucinto* arbol, const char* ruta) {
+    cabecera_sucinto cabecera;
+    FILE* archivo = fopen(ruta, "wb");
+    if (archivo == NULL) return 0;
+
+    memset(&cabecera, 0, sizeof(cabecera));
+    memcpy(cabecera.magia, MAGIA_SUCINTO, 8);
+    cabecera.version = VERSION_SUCINTO;
+    cabecera.filas = (uint32_t)arbol->filas;
+    cabecera.columnas = (uint32_t)arbol->columnas;
+    cabecera.raiz = (uint32_t)arbol->raiz;
+    cabecera.fila_inicio = arbol->fila_inicio;
+    cabecera.columna_inicio = arbol->columna_inicio;
+    cabecera.fila_final = arbol->fila_final;
+    cabecera.columna_final = arbol->columna_final;
+    memcpy(cabecera.nombre, arbol->nombre, MAX_NOMBRE);
+
+    int ok = fwrite(&cabecera, sizeof(cabecera), 1, archivo) == 1 &&
+             fwrite(arbol->direcciones, 1, BYTES_DIRECCIONES(arbol), archivo) ==
+                 BYTES_DIRECCIONES(arbol) &&
+             fwrite(arbol->borde, 1, BYTES_BORDE(arbol), archivo) == BYTES_BORDE(arbol);
+    if (fclose(archivo) != 0) ok = 0;
+    return ok;
+}
+
+/*
+ * cargar_arbol_sucinto
+ * Lee un archivo de guardar_arbol_sucinto y valida que sea un árbol
+ * y que la entrada y la salida caigan dentro de sus celdas.
+ */
+arbol_sucinto* cargar_arbol_sucinto(const char* ruta) {
+    cabecera_sucinto cabecera;
+    FILE* archivo = fopen(ruta, "rb");
+    if (archivo == NULL) return NULL;
+
+    arbol_sucinto* arbol = NULL;
+    if (fread(&cabecera, sizeof(cabecera), 1, archivo) == 1 &&
+        memcmp(cabecera.magia, MAGIA_SUCINTO, 8) == 0 && cabecera.version == VERSION_SUCINTO &&
+        cabecera.filas <= INT_MAX && cabecera.columnas <= INT_MAX) {
+        arbol = crear_arbol_sucinto((int)cabecera.filas, (int)cabecera.columnas);
+    }
+    if (arbol != NULL) {
+        arbol->raiz = (int)cabecera.raiz;
+        arbol->fila_inicio = cabecera.fila_inicio;
+        arbol->columna_inicio = cabecera.columna_inicio;
+        arbol->fila_final = cabecera.fila_final;
+        arbol->columna_final = cabecera.columna_final;
+        memcpy(arbol->nombre, cabecera.nombre, MAX_NOMBRE);
+        arbol->nombre[MAX_NOMBRE - 1] = '\0';
+        if (fread(arbol->direcciones, 1, BYTES_DIRECCIONES(arbol), archivo) !=
+                BYTES_DIRECCIONES(arbol) ||
+            fread(arbol->borde, 1, BYTES_BORDE(arbol), archivo) != BYTES_BORDE(arbol) ||
+            !extremo_valido(arbol, arbol->fila_inicio, arbol->columna_inicio) ||
+            !extremo_valido(arbol, arbol->fila_final, arbol->columna_final) ||
+            !validar_arbol_sucinto(arbol)) {
+            destruir_arbol_sucinto(arbol);
+            arbol = NULL;
+        }
+    }
+    fclose(archivo);
+    return arbol;
+}
+
+/*
+ * es_archivo_sucinto
+ * Mira si el archivo empieza con MAGIA_SUCINTO.
+ */
+int es_archivo_sucinto(const char* ruta) {
+    char magia[8];
+    FILE* archivo = fopen(ruta, "rb");
+    if (archivo == NULL) return 0;
+    int es = fread(magia, 1, 8, archivo) == 8 && memcmp(magia, MAGIA_SUCINTO, 8) == 0;
+    fclose(archivo);
+    return es;
+}
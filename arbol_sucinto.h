@@ -0,0 +1,88 @@
+/*
+ * arbol_sucinto.h
+ * Laberintos perfectos como árbol sucinto: 2 bits por habitación con la
+ * dirección de su padre. El tamaño se fija al crear (no al compilar),
+ * así que admite laberintos mucho mayores que FILAS x COLUMNAS.
+ */
+
+#ifndef ARBOL_SUCINTO_H
+#define ARBOL_SUCINTO_H
+
+#include <stdint.h>
+#include "laberinto.h"
+#include "compacto.h"
+
+// ============================================================================
+// FORMATO SUCINTO
+// ============================================================================
+
+#define MAGIA_SUCINTO "LABSUC01"
+#define VERSION_SUCINTO 1
+
+// Dirección DIR_* del padre de la habitación h (la raíz no tiene)
+#define DIRECCION_PADRE(arbol, h) \
+    (((arbol)->direcciones[(h) >> 2] >> (((h) & 3) * 2)) & 3)
+
+/*
+ * arbol_sucinto - Árbol generador de las habitaciones
+ * La habitación (f, c) es la celda (2f+1, 2c+1) del formato de bloques.
+ * Las paredes del perímetro abiertas (junto a INICIO y FINAL) van aparte,
+ * un bit por pared: norte, sur, oeste y este, en ese orden.
+ */
+typedef struct {
+    int filas;                  // Filas de habitaciones
+    int columnas;               // Columnas de habitaciones
+    int raiz;                   // Habitación sin padre
+    int fila_inicio;            // INICIO en celdas (-1 si no hay)
+    int columna_inicio;
+    int fila_final;             // FINAL en celdas (-1 si no hay)
+    int columna_final;
+    char nombre[MAX_NOMBRE];    // Nombre del laberinto
+    unsigned char* direcciones; // 2 bits por habitación
+    unsigned char* borde;       // 1 bit por pared del perímetro
+} arbol_sucinto;
+
+/*
+ * cabecera_sucinto - Inicio del archivo (enteros en orden nativo)
+ * Siguen los bytes de direcciones y luego los de borde.
+ */
+typedef struct {
+    char magia[8];              // "LABSUC01"
+    uint32_t version;           // Versión del formato
+    uint32_t filas;             // Filas de habitaciones
+    uint32_t columnas;          // Columnas de habitaciones
+    uint32_t raiz;              // Habitación raíz
+    int32_t fila_inicio;        // INICIO y FINAL en celdas
+    int32_t columna_inicio;
+    int32_t fila_final;
+    int32_t columna_final;
+    char nombre[MAX_NOMBRE];    // Nombre del laberinto
+} cabecera_sucinto;
+
+// ============================================================================
+// PROTOTIPOS DE FUNCIONES
+// ============================================================================
+
+/* Creación y destrucción */
+arbol_sucinto* crear_arbol_sucinto(int filas, int columnas);
+void destruir_arbol_sucinto(arbol_sucinto* arbol);
+size_t bytes_arbol_sucinto(const arbol_sucinto* arbol);
+
+/* Generación y conversión con el formato de bloques */
+int generar_arbol_sucinto(arbol_sucinto* arbol);
+arbol_sucinto* celdas_a_sucinto(laberinto* lab, const char** error);
+int sucinto_a_celdas(const arbol_sucinto* arbol, laberinto* lab);
+
+/* Navegación sin descomprimir */
+int padre_sucinto(const arbol_sucinto* arbol, int habitacion);
+int hijos_sucinto(const arbol_sucinto* arbol, int habitacion, int hijos[4]);
+int profundidad_sucinto(const arbol_sucinto* arbol, int habitacion);
+long distancia_sucinto(const arbol_sucinto* arbol, int u, int v);
+long pasos_sucinto(const arbol_sucinto* arbol);
+
+/* Archivos */
+int guardar_arbol_sucinto(const arbol_sucinto* arbol, const char* ruta);
+arbol_sucinto* cargar_arbol_sucinto(const char* ruta);
+int es_archivo_sucinto(const char* ruta);
+
+#endif // ARBOL_SUCINTO_H
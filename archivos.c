@@ -6,13 +6,20 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdarg.h>
 #include <string.h>
 #include <sys/stat.h>
 #include <dirent.h>
 #include <time.h>
 #include "archivos.h"
+#include "paquete.h"
+#include "compresion.h"
+#include "memoria.h"
+#include "callejones.h"
 #include "config.h"
 
+#define TAM_BUFFER_SVG (1 << 20)   // Buffer de escritura del SVG (1 MB)
+
 // ==================== FUNCIONES PRINCIPALES ====================
 
 /*
@@ -45,6 +52,24 @@ int guardar_laberinto(laberinto* lab, const char* nombre_archivo) {
         return 0;  // Error
     }
     
+    int ok = escribir_laberinto_texto(archivo, lab);  // Metadatos y celdas
+    ok = (fclose(archivo) == 0) && ok;                 // Cierra archivo
+    if (!ok) {
+        printf("Error al escribir el archivo %s\n", nombre_completo);
+        return 0;
+    }
+    printf("Laberinto guardado en: %s\n", nombre_completo);
+    return 1;  // Éxito
+}
+
+/*
+ * escribir_laberinto_texto
+ * Escribe el laberinto en formato de texto en un flujo abierto.
+ * Cada registro empieza con "# LABERINTO", así varios pueden ir seguidos.
+ */
+int escribir_laberinto_texto(FILE* archivo, laberinto* lab) {
+    char fila[2 * COLUMNAS + 1];  // Una fila: dígito y separador por celda
+    
     // Escribe metadatos
     fprintf(archivo, "# LABERINTO ANÁRQUICO\n");
     fprintf(archivo, "NOMBRE: %s\n", lab->nombre);
@@ -54,32 +79,29 @@ int guardar_laberinto(laberinto* lab, const char* nombre_archivo) {
     fprintf(archivo, "PASOS_SOLUCION: %d\n", lab->pasos_solucion);
     fprintf(archivo, "DATA:\n");
     
-    // Escribe matriz del laberinto
+    // Escribe matriz del laberinto (valores de un dígito, una escritura por fila)
     for (int i = 0; i < lab->filas; i++) {
+        int n = 0;
         for (int j = 0; j < lab->columnas; j++) {
-            fprintf(archivo, "%d", lab->celdas[i][j]);  // Valor de celda
-            if (j < lab->columnas - 1) {
-                fprintf(archivo, " ");  // Espacio entre valores
-            }
+            fila[n++] = (char)('0' + lab->celdas[i][j]);  // Valor de celda
+            fila[n++] = (j < lab->columnas - 1) ? ' ' : '\n';
         }
-        fprintf(archivo, "\n");  // Nueva línea por fila
+        fwrite(fila, 1, (size_t)n, archivo);
     }
     
-    fclose(archivo);  // Cierra archivo
-    printf("Laberinto guardado en: %s\n", nombre_completo);
-    return 1;  // Éxito
+    return ferror(archivo) == 0;
 }
 
 /*
  * cargar_laberinto
  * Carga un laberinto desde archivo de texto.
- * Verifica formato y estructura del archivo.
+ * Lee el archivo completo y lo valida en una sola pasada.
  */
 laberinto* cargar_laberinto(const char* nombre_archivo) {
-    FILE* archivo;                         // Puntero a archivo
     char nombre_completo[MAX_NOMBRE + 50]; // Nombre completo con ruta
-    char linea[MAX_LINEA];                 // Buffer para línea
     laberinto* lab = NULL;                 // Laberinto a cargar
+    const char* error = NULL;              // Motivo de rechazo
+    size_t tamano;                         // Bytes leídos
     
     // Construye nombre completo
     sprintf(nombre_completo, "%s%s", DIRECTORIO_LABERINTOS, nombre_archivo);
@@ -93,68 +115,28 @@ laberinto* cargar_laberinto(const char* nombre_archivo) {
         return NULL;
     }
     
-    // Abre archivo para lectura
-    archivo = fopen(nombre_completo, "r");
-    if (archivo == NULL) {
+    // Lee todo el archivo con una sola lectura
+    char* datos = leer_archivo_completo(nombre_completo, &tamano);
+    if (datos == NULL) {
         printf("Error: No se pudo abrir el archivo %s\n", nombre_completo);
         return NULL;
     }
     
     // Asigna memoria para laberinto
-    lab = (laberinto*)malloc(sizeof(laberinto));
+    lab = (laberinto*)reservar_memoria(MEM_LABERINTO, sizeof(laberinto));
     if (!lab) {
-        fclose(archivo);
+        liberar_memoria(datos);
         return NULL;
     }
     
-    int leyendo_data = 0;  // Flag para sección DATA
-    int fila_actual = 0;   // Fila actual en lectura
-    
-    // Lee archivo línea por línea
-    while (fgets(linea, MAX_LINEA, archivo)) {
-        linea[strcspn(linea, "\n")] = 0;  // Elimina salto de línea
-        
-        if (strstr(linea, "DATA:") != NULL) {
-            leyendo_data = 1;  // Comienza sección DATA
-            continue;
-        }
-        
-        if (!leyendo_data) {
-            // Parsea metadatos
-            if (strstr(linea, "NOMBRE:") != NULL) {
-                strcpy(lab->nombre, linea + 8);  // Copia nombre
-            } else if (strstr(linea, "FILAS:") != NULL) {
-                lab->filas = atoi(linea + 6);  // Convierte a entero
-            } else if (strstr(linea, "COLUMNAS:") != NULL) {
-                lab->columnas = atoi(linea + 9);  // Convierte a entero
-            } else if (strstr(linea, "TIENE_SOLUCION:") != NULL) {
-                lab->tiene_solucion = atoi(linea + 15);  // Convierte a entero
-            } else if (strstr(linea, "PASOS_SOLUCION:") != NULL) {
-                lab->pasos_solucion = atoi(linea + 15);  // Convierte a entero
-            }
-        } else if (fila_actual < lab->filas) {
-            // Lee datos del laberinto
-            char* token = strtok(linea, " ");  // Primer token
-            int columna = 0;  // Columna actual
-            
-            while (token != NULL && columna < lab->columnas) {
-                lab->celdas[fila_actual][columna] = atoi(token);  // Convierte a entero
-                token = strtok(NULL, " ");  // Siguiente token
-                columna++;  // Incrementa columna
-            }
-            fila_actual++;  // Incrementa fila
-        }
-    }
-    
-    fclose(archivo);  // Cierra archivo
-    
-    // Verifica integridad del archivo
-    if (fila_actual != lab->filas) {
-        printf("Error: Archivo corrupto o incompleto\n");
-        free(lab);  // Libera memoria
+    if (!parsear_laberinto_texto(datos, tamano, lab, &error)) {
+        printf("Error: Archivo corrupto o incompleto (%s)\n", error);
+        liberar_memoria(datos);
+        liberar_memoria(lab);  // Libera memoria
         return NULL;
     }
     
+    liberar_memoria(datos);
     printf("Laberinto cargado exitosamente: %s\n", lab->nombre);
     return lab;  // Retorna laberinto cargado
 }
@@ -217,6 +199,13 @@ void listar_laberintos_guardados(void) {
     }
     
     closedir(directorio);  // Cierra directorio
+    
+    // Laberintos empaquetados: solo se lee el índice mapeado
+    paquete* paq = abrir_paquete(ARCHIVO_PAQUETE);
+    if (paq != NULL) {
+        listar_paquete(paq);
+        cerrar_paquete(paq);
+    }
 }
 
 /*
@@ -244,73 +233,245 @@ int eliminar_laberinto(const char* nombre_archivo) {
 
 // ==================== EXPORTACIÓN ====================
 
+/*
+ * salida_svg - Buffer de escritura para exportar SVG
+ * Junta todo el texto en memoria y lo manda al archivo (o gzip) en bloques.
+ */
+typedef struct {
+    FILE* archivo;                 // Salida sin comprimir
+    archivo_gzip* gz;              // Salida comprimida (o NULL)
+    char buffer[TAM_BUFFER_SVG];   // Buffer de usuario
+    size_t usados;                 // Bytes pendientes
+    int error;                     // 1 si se perdió texto
+} salida_svg;
+
+/*
+ * escribir_destino_svg
+ * Manda bytes al destino (archivo o gzip) sin pasar por el buffer.
+ */
+static void escribir_destino_svg(salida_svg* salida, const char* datos, size_t n) {
+    if (salida->gz != NULL) {
+        escribir_gzip(salida->gz, datos, n);  // Comprime
+    } else if (fwrite(datos, 1, n, salida->archivo) != n) {  // Una escritura
+        salida->error = 1;
+    }
+}
+
+/*
+ * vaciar_salida_svg
+ * Escribe el contenido del buffer en el destino.
+ * Deja el buffer vacío para seguir acumulando.
+ */
+static void vaciar_salida_svg(salida_svg* salida) {
+    if (salida->usados == 0) return;
+    
+    escribir_destino_svg(salida, salida->buffer, salida->usados);
+    salida->usados = 0;
+}
+
+/*
+ * escribir_svg
+ * Agrega texto con formato al buffer de salida.
+ * Vacía el buffer cuando no queda espacio; un texto más grande que el
+ * buffer se arma aparte y va directo al destino. Si falta memoria
+ * marca el error para que el llamador no informe éxito.
+ */
+static void escribir_svg(salida_svg* salida, const char* formato, ...) {
+    va_list args;
+    int n = -1;
+    
+    for (int intento = 0; intento < 2; intento++) {
+        size_t libre = TAM_BUFFER_SVG - salida->usados;
+        
+        va_start(args, formato);
+        n = vsnprintf(salida->buffer + salida->usados, libre, formato, args);
+        va_end(args);
+        
+        if (n >= 0 && (size_t)n < libre) {
+            salida->usados += (size_t)n;  // Cupo en el buffer
+            return;
+        }
+        vaciar_salida_svg(salida);  // Sin espacio: vacía y reintenta
+    }
+    
+    char* grande = (n >= 0) ? (char*)reservar_memoria(MEM_ARCHIVOS, (size_t)n + 1) : NULL;
+    if (grande == NULL) {
+        salida->error = 1;
+        return;
+    }
+    va_start(args, formato);
+    vsnprintf(grande, (size_t)n + 1, formato, args);
+    va_end(args);
+    escribir_destino_svg(salida, grande, (size_t)n);
+    liberar_memoria(grande);
+}
+
 /*
  * exportar_laberinto_svg
  * Exporta laberinto a formato SVG (vectorial).
- * Crea imagen escalable con colores definidos.
+ * Versión simple: sin solución y sin comprimir.
  */
 void exportar_laberinto_svg(laberinto* lab, const char* nombre_archivo) {
-    FILE* archivo;                         // Puntero a archivo
+    exportar_laberinto_svg_completo(lab, nombre_archivo, NULL, 0, 0);
+}
+
+/*
+ * exportar_laberinto_svg_completo
+ * Exporta SVG con todas las paredes fusionadas en un solo <path>.
+ * Opcionalmente dibuja la solución y comprime a .svgz.
+ */
+int exportar_laberinto_svg_completo(laberinto* lab, const char* nombre_archivo,
+                                    int* camino, int longitud, int comprimido) {
     char nombre_completo[MAX_NOMBRE + 50]; // Nombre completo con ruta
     int tam_celda = 20;                    // Tamaño de celda en píxeles
+    int filas = lab->filas;
+    int columnas = lab->columnas;
     
-    sprintf(nombre_completo, "%s%s.svg", DIRECTORIO_LABERINTOS, nombre_archivo);
+    sprintf(nombre_completo, "%s%s.%s", DIRECTORIO_LABERINTOS, nombre_archivo,
+            comprimido ? "svgz" : "svg");
     
-    archivo = fopen(nombre_completo, "w");
-    if (archivo == NULL) {
+    salida_svg* salida = (salida_svg*)reservar_memoria(MEM_ARCHIVOS, sizeof(salida_svg));
+    if (!salida) return 0;
+    salida->usados = 0;
+    salida->archivo = NULL;
+    salida->gz = NULL;
+    salida->error = 0;
+    
+    if (comprimido) {
+        salida->gz = abrir_gzip(nombre_completo);
+    } else {
+        salida->archivo = fopen(nombre_completo, "w");
+    }
+    if (salida->archivo == NULL && salida->gz == NULL) {
         printf("Error al crear archivo SVG\n");
-        return;
+        liberar_memoria(salida);
+        return 0;
     }
     
-    // Encabezado SVG
-    fprintf(archivo, "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n");
-    fprintf(archivo, "<svg width=\"%d\" height=\"%d\" xmlns=\"http://www.w3.org/2000/svg\">\n",
-            lab->columnas * tam_celda + 10, lab->filas * tam_celda + 10);
+    // Encabezado: coordenadas en unidades de celda con margen de 1/4
+    escribir_svg(salida, "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n");
+    escribir_svg(salida, "<svg width=\"%d\" height=\"%d\" viewBox=\"-0.25 -0.25 %d.5 %d.5\" "
+                 "shape-rendering=\"crispEdges\" xmlns=\"http://www.w3.org/2000/svg\">\n",
+                 columnas * tam_celda + 10, filas * tam_celda + 10, columnas, filas);
+    
+    // Rejilla como patrón: una definición en lugar de un borde por celda
+    escribir_svg(salida, "<defs><pattern id=\"rejilla\" width=\"1\" height=\"1\" "
+                 "patternUnits=\"userSpaceOnUse\"><path d=\"M1 0H0V1\" fill=\"none\" "
+                 "stroke=\"#cccccc\" stroke-width=\"0.05\"/></pattern></defs>\n");
+    
+    // Fondo y área de caminos
+    escribir_svg(salida, "<rect x=\"-0.25\" y=\"-0.25\" width=\"%d.5\" height=\"%d.5\" fill=\"#f0f0f0\"/>\n",
+                 columnas, filas);
+    escribir_svg(salida, "<rect width=\"%d\" height=\"%d\" fill=\"#ffffff\"/>\n", columnas, filas);
+    
+    // Paredes: rectángulos máximos (corrida horizontal extendida hacia abajo)
+    unsigned char cubierta[FILAS][COLUMNAS];
+    memset(cubierta, 0, sizeof(cubierta));
+    
+    escribir_svg(salida, "<path fill=\"#333333\" d=\"");
+    for (int i = 0; i < filas; i++) {
+        for (int j = 0; j < columnas; j++) {
+            if (lab->celdas[i][j] != PARED || cubierta[i][j]) continue;
+            
+            // Corrida horizontal de paredes libres
+            int fin = j;
+            while (fin < columnas && lab->celdas[i][fin] == PARED && !cubierta[i][fin]) fin++;
+            
+            // Extiende hacia abajo mientras toda la corrida siga siendo pared
+            int alto = 1;
+            while (i + alto < filas) {
+                int completa = 1;
+                for (int k = j; k < fin && completa; k++) {
+                    if (lab->celdas[i + alto][k] != PARED || cubierta[i + alto][k]) completa = 0;
+                }
+                if (!completa) break;
+                alto++;
+            }
+            
+            for (int a = 0; a < alto; a++) {
+                memset(&cubierta[i + a][j], 1, (size_t)(fin - j));  // Marca cubierta
+            }
+            
+            escribir_svg(salida, "M%d %dh%dv%dh-%dz", j, i, fin - j, alto, fin - j);
+            j = fin - 1;
+        }
+    }
+    escribir_svg(salida, "\"/>\n");
     
-    // Fondo
-    fprintf(archivo, "<rect x=\"0\" y=\"0\" width=\"%d\" height=\"%d\" fill=\"#f0f0f0\"/>\n",
-            lab->columnas * tam_celda + 10, lab->filas * tam_celda + 10);
+    escribir_svg(salida, "<rect width=\"%d\" height=\"%d\" fill=\"url(#rejilla)\"/>\n",
+                 columnas, filas);
     
-    // Dibuja cada celda del laberinto
-    for (int i = 0; i < lab->filas; i++) {
-        for (int j = 0; j < lab->columnas; j++) {
-            int x = j * tam_celda + 5;  // Posición X
-            int y = i * tam_celda + 5;  // Posición Y
+    // Entrada y salida
+    for (int i = 0; i < filas; i++) {
+        for (int j = 0; j < columnas; j++) {
+            if (lab->celdas[i][j] != INICIO && lab->celdas[i][j] != FINAL) continue;
+            int es_inicio = (lab->celdas[i][j] == INICIO);
             
-            // Color según tipo de celda
-            switch (lab->celdas[i][j]) {
-                case PARED:
-                    fprintf(archivo, "<rect x=\"%d\" y=\"%d\" width=\"%d\" height=\"%d\" fill=\"#333333\"/>\n",
-                            x, y, tam_celda, tam_celda);
-                    break;
-                case CAMINO:
-                    fprintf(archivo, "<rect x=\"%d\" y=\"%d\" width=\"%d\" height=\"%d\" fill=\"#ffffff\"/>\n",
-                            x, y, tam_celda, tam_celda);
-                    break;
-                case INICIO:
-                    fprintf(archivo, "<rect x=\"%d\" y=\"%d\" width=\"%d\" height=\"%d\" fill=\"#4CAF50\"/>\n",
-                            x, y, tam_celda, tam_celda);
-                    fprintf(archivo, "<text x=\"%d\" y=\"%d\" font-size=\"12\" text-anchor=\"middle\" dy=\".3em\">E</text>\n",
-                            x + tam_celda/2, y + tam_celda/2);
-                    break;
-                case FINAL:
-                    fprintf(archivo, "<rect x=\"%d\" y=\"%d\" width=\"%d\" height=\"%d\" fill=\"#F44336\"/>\n",
-                            x, y, tam_celda, tam_celda);
-                    fprintf(archivo, "<text x=\"%d\" y=\"%d\" font-size=\"12\" text-anchor=\"middle\" dy=\".3em\">S</text>\n",
-                            x + tam_celda/2, y + tam_celda/2);
-                    break;
+            escribir_svg(salida, "<rect x=\"%d\" y=\"%d\" width=\"1\" height=\"1\" fill=\"%s\"/>"
+                         "<text x=\"%d.5\" y=\"%d.5\" font-size=\"0.6\" text-anchor=\"middle\" "
+                         "dy=\".3em\">%s</text>\n",
+                         j, i, es_inicio ? "#4CAF50" : "#F44336", j, i, es_inicio ? "E" : "S");
+        }
+    }
+    
+    // Solución: una polilínea con pasos relativos entre centros de celda
+    if (camino != NULL && longitud > 0) {
+        escribir_svg(salida, "<path fill=\"none\" stroke=\"#2196F3\" stroke-width=\"0.3\" "
+                     "stroke-linecap=\"round\" stroke-linejoin=\"round\" d=\"M%d.5 %d.5",
+                     camino[0] % COLUMNAS, camino[0] / COLUMNAS);
+        
+        char eje = 0;       // 'h' o 'v' del tramo actual
+        int tramo = 0;      // Desplazamiento acumulado del tramo
+        for (int k = 1; k < longitud; k++) {
+            int df = camino[k] / COLUMNAS - camino[k - 1] / COLUMNAS;
+            int dc = camino[k] % COLUMNAS - camino[k - 1] % COLUMNAS;
+            char nuevo_eje = 0;
+            int paso = 0;
+            
+            if (df == 0 && (dc == 1 || dc == -1)) {
+                nuevo_eje = 'h';
+                paso = dc;
+            } else if (dc == 0 && (df == 1 || df == -1)) {
+                nuevo_eje = 'v';
+                paso = df;
             }
             
-            // Borde de celda
-            fprintf(archivo, "<rect x=\"%d\" y=\"%d\" width=\"%d\" height=\"%d\" fill=\"none\" stroke=\"#cccccc\" stroke-width=\"1\"/>\n",
-                    x, y, tam_celda, tam_celda);
+            // Junta pasos seguidos en la misma dirección
+            if (nuevo_eje != 0 && nuevo_eje == eje && (paso > 0) == (tramo > 0)) {
+                tramo += paso;
+                continue;
+            }
+            if (eje != 0) escribir_svg(salida, "%c%d", eje, tramo);
+            
+            eje = nuevo_eje;
+            tramo = paso;
+            if (nuevo_eje == 0) {
+                escribir_svg(salida, "M%d.5 %d.5", camino[k] % COLUMNAS, camino[k] / COLUMNAS);
+            }
         }
+        if (eje != 0) escribir_svg(salida, "%c%d", eje, tramo);
+        escribir_svg(salida, "\"/>\n");
     }
     
-    fprintf(archivo, "</svg>\n");  // Cierra SVG
-    fclose(archivo);               // Cierra archivo
+    escribir_svg(salida, "</svg>\n");  // Cierra SVG
+    vaciar_salida_svg(salida);
     
-    printf("Laberinto exportado a SVG: %s\n", nombre_completo);
+    int ok;
+    if (salida->gz != NULL) {
+        ok = cerrar_gzip(salida->gz);
+    } else {
+        ok = (ferror(salida->archivo) == 0);
+        ok = (fclose(salida->archivo) == 0) && ok;
+    }
+    ok = ok && !salida->error;
+    liberar_memoria(salida);
+    
+    if (ok) {
+        printf("Laberinto exportado a SVG: %s\n", nombre_completo);
+    } else {
+        printf("Error al escribir archivo SVG\n");
+    }
+    return ok;
 }
 
 /*
@@ -344,6 +505,12 @@ void exportar_estadisticas(laberinto* lab, const char* nombre_archivo) {
     
     float porcentaje_caminos = (float)caminos * 100 / (lab->filas * lab->columnas);
     
+    // Callejones: puntas y celdas que tapia el relleno (sobre una copia)
+    int callejones = contar_callejones(lab);
+    int en_callejones = -1;
+    laberinto* podado = podar_laberinto(lab, RELLENO_COLA, &en_callejones);
+    liberar_memoria(podado);
+    
     // Escribe estadísticas
     fprintf(archivo, "ESTADÍSTICAS DEL LABERINTO: %s\n", lab->nombre);
     fprintf(archivo, "================================\n\n");
@@ -353,6 +520,11 @@ void exportar_estadisticas(laberinto* lab, const char* nombre_archivo) {
     fprintf(archivo, "Caminos: %d (%.1f%%)\n", caminos, porcentaje_caminos);
     fprintf(archivo, "Tiene solución: %s\n", lab->tiene_solucion ? "Sí" : "No");
     fprintf(archivo, "Pasos en solución: %d\n", lab->pasos_solucion);
+    fprintf(archivo, "Callejones sin salida: %d\n", callejones);
+    if (en_callejones >= 0) {
+        fprintf(archivo, "Celdas en callejones: %d (%.1f%% de los caminos)\n", en_callejones,
+                caminos ? 100.0 * en_callejones / caminos : 0.0);
+    }
     fprintf(archivo, "Fecha de generación: %s", ctime(&(time_t){time(NULL)}));
     
     fclose(archivo);  // Cierra archivo
@@ -394,30 +566,223 @@ char* generar_nombre_archivo(const char* nombre_laberinto) {
 
 /*
  * validar_archivo_laberinto
- * Verifica formato básico de archivo de laberinto.
- * Comprueba existencia de secciones esenciales.
+ * Verifica formato completo de archivo de laberinto.
+ * Usa el mismo parser estricto que cargar_laberinto.
  */
 int validar_archivo_laberinto(const char* nombre_archivo) {
-    FILE* archivo;                         // Puntero a archivo
     char nombre_completo[MAX_NOMBRE + 50]; // Nombre completo con ruta
+    const char* error = NULL;              // Motivo de rechazo
+    size_t tamano;                         // Bytes leídos
     
     sprintf(nombre_completo, "%s%s", DIRECTORIO_LABERINTOS, nombre_archivo);
     
-    archivo = fopen(nombre_completo, "r");
-    if (archivo == NULL) {
+    char* datos = leer_archivo_completo(nombre_completo, &tamano);
+    if (datos == NULL) {
         return 0;  // No se pudo abrir
     }
     
-    char linea[MAX_LINEA];          // Buffer para línea
-    int tiene_data = 0, tiene_nombre = 0;  // Flags para secciones
+    laberinto* lab = (laberinto*)reservar_memoria(MEM_LABERINTO, sizeof(laberinto));
+    int valido = (lab != NULL) && parsear_laberinto_texto(datos, tamano, lab, &error);
+    
+    liberar_memoria(lab);
+    liberar_memoria(datos);
+    
+    return valido;  // Válido si pasa el parser completo
+}
+
+/*
+ * leer_archivo_completo
+ * Lee un archivo entero en memoria dinámica con un solo fread.
+ * Agrega un terminador '\0' al final; el llamador libera con liberar_memoria.
+ */
+char* leer_archivo_completo(const char* ruta, size_t* tamano) {
+    FILE* archivo = fopen(ruta, "rb");
+    if (archivo == NULL) return NULL;
     
-    // Lee archivo buscando secciones esenciales
-    while (fgets(linea, MAX_LINEA, archivo)) {
-        if (strstr(linea, "NOMBRE:") != NULL) tiene_nombre = 1;
-        if (strstr(linea, "DATA:") != NULL) tiene_data = 1;
+    // Obtiene el tamaño del archivo
+    if (fseek(archivo, 0, SEEK_END) != 0) {
+        fclose(archivo);
+        return NULL;
+    }
+    long largo = ftell(archivo);
+    if (largo < 0 || fseek(archivo, 0, SEEK_SET) != 0) {
+        fclose(archivo);
+        return NULL;
     }
     
-    fclose(archivo);  // Cierra archivo
+    char* datos = (char*)reservar_memoria(MEM_ARCHIVOS, (size_t)largo + 1);
+    if (!datos) {
+        fclose(archivo);
+        return NULL;
+    }
+    
+    *tamano = fread(datos, 1, (size_t)largo, archivo);  // Una sola lectura
+    datos[*tamano] = '\0';                               // Terminador
+    fclose(archivo);
+    
+    return datos;
+}
+
+/*
+ * leer_entero
+ * Escanea dígitos decimales a mano desde la posición actual.
+ * Retorna 0 si no hay número o si desborda un int.
+ */
+static int leer_entero(const char** cursor, const char* fin, int* valor) {
+    const char* p = *cursor;
+    int negativo = 0;
+    long acumulado = 0;
+    
+    if (p < fin && *p == '-') {
+        negativo = 1;
+        p++;
+    }
+    if (p >= fin || *p < '0' || *p > '9') return 0;  // Sin dígitos
+    
+    while (p < fin && *p >= '0' && *p <= '9') {
+        acumulado = acumulado * 10 + (*p - '0');
+        if (acumulado > INFINITO) return 0;  // Desborda int
+        p++;
+    }
+    
+    *valor = negativo ? (int)-acumulado : (int)acumulado;
+    *cursor = p;
+    return 1;
+}
+
+/*
+ * empieza_con
+ * Verifica si la línea [inicio, fin) comienza con una clave.
+ * Más estricto y barato que strstr sobre cada línea.
+ */
+static int empieza_con(const char* inicio, const char* fin, const char* clave) {
+    size_t largo = strlen(clave);
+    return (size_t)(fin - inicio) >= largo && memcmp(inicio, clave, largo) == 0;
+}
+
+/*
+ * valor_de_clave
+ * Lee el entero que sigue a "CLAVE:" en una línea de metadatos.
+ * Acepta espacios antes del número y exige fin de línea después.
+ */
+static int valor_de_clave(const char* inicio, const char* fin, size_t largo_clave, int* valor) {
+    const char* p = inicio + largo_clave;
     
-    return (tiene_nombre && tiene_data);  // Válido si tiene ambas secciones
-}
\ No newline at end of file
+    while (p < fin && (*p == ' ' || *p == '\t')) p++;  // Espacios previos
+    if (!leer_entero(&p, fin, valor)) return 0;
+    while (p < fin && (*p == ' ' || *p == '\t' || *p == '\r')) p++;
+    
+    return p == fin;  // Nada más en la línea
+}
+
+/*
+ * parsear_laberinto_texto
+ * Parser de una pasada para el formato de guardar_laberinto.
+ * Valida dimensiones contra FILAS/COLUMNAS y valores de celda.
+ */
+int parsear_laberinto_texto(const char* datos, size_t tamano, laberinto* lab,
+                            const char** error) {
+    const char* p = datos;              // Cursor actual
+    const char* fin = datos + tamano;   // Fin del buffer
+    int tiene_filas = 0, tiene_columnas = 0, tiene_data = 0;
+    
+    memset(lab, 0, sizeof(laberinto));  // Celdas sin datos quedan como pared
+    
+    // ===== Metadatos: una línea por clave hasta DATA: =====
+    while (p < fin) {
+        const char* fin_linea = memchr(p, '\n', (size_t)(fin - p));
+        if (fin_linea == NULL) fin_linea = fin;
+        
+        if (empieza_con(p, fin_linea, "DATA:")) {
+            tiene_data = 1;
+            p = (fin_linea < fin) ? fin_linea + 1 : fin;
+            break;
+        } else if (empieza_con(p, fin_linea, "NOMBRE:")) {
+            const char* nombre = p + 7;
+            const char* fin_nombre = fin_linea;
+            if (nombre < fin_nombre && *nombre == ' ') nombre++;
+            if (fin_nombre > nombre && fin_nombre[-1] == '\r') fin_nombre--;
+            size_t largo = (size_t)(fin_nombre - nombre);
+            if (largo > MAX_NOMBRE - 1) largo = MAX_NOMBRE - 1;  // Trunca nombre
+            memcpy(lab->nombre, nombre, largo);
+            lab->nombre[largo] = '\0';
+        } else if (empieza_con(p, fin_linea, "FILAS:")) {
+            if (!valor_de_clave(p, fin_linea, 6, &lab->filas)) {
+                *error = "FILAS inválido";
+                return 0;
+            }
+            tiene_filas = 1;
+        } else if (empieza_con(p, fin_linea, "COLUMNAS:")) {
+            if (!valor_de_clave(p, fin_linea, 9, &lab->columnas)) {
+                *error = "COLUMNAS inválido";
+                return 0;
+            }
+            tiene_columnas = 1;
+        } else if (empieza_con(p, fin_linea, "TIENE_SOLUCION:")) {
+            if (!valor_de_clave(p, fin_linea, 15, &lab->tiene_solucion) ||
+                (lab->tiene_solucion != 0 && lab->tiene_solucion != 1)) {
+                *error = "TIENE_SOLUCION inválido";
+                return 0;
+            }
+        } else if (empieza_con(p, fin_linea, "PASOS_SOLUCION:")) {
+            if (!valor_de_clave(p, fin_linea, 15, &lab->pasos_solucion) ||
+                lab->pasos_solucion < 0) {
+                *error = "PASOS_SOLUCION inválido";
+                return 0;
+            }
+        }
+        // Comentarios (#) y claves desconocidas se ignoran
+        
+        p = (fin_linea < fin) ? fin_linea + 1 : fin;
+    }
+    
+    // ===== Validación de dimensiones =====
+    if (!tiene_data) {
+        *error = "falta la sección DATA";
+        return 0;
+    }
+    if (!tiene_filas || !tiene_columnas) {
+        *error = "faltan FILAS o COLUMNAS";
+        return 0;
+    }
+    if (lab->filas < 1 || lab->filas > FILAS || lab->columnas < 1 || lab->columnas > COLUMNAS) {
+        *error = "dimensiones fuera de rango";
+        return 0;
+    }
+    
+    // ===== Celdas: un solo recorrido del buffer =====
+    for (int i = 0; i < lab->filas; i++) {
+        for (int j = 0; j < lab->columnas; j++) {
+            while (p < fin && (*p == ' ' || *p == '\t')) p++;  // Separadores
+            
+            // Cada celda debe empezar con un dígito
+            if (p >= fin || *p < '0' || *p > '9') {
+                *error = (p >= fin || *p == '\n' || *p == '\r') ? "fila incompleta" : "celda no numérica";
+                return 0;
+            }
+            int valor = 0;
+            if (!leer_entero(&p, fin, &valor) || valor < PARED || valor > SOLUCION) {
+                *error = "valor de celda inválido";
+                return 0;
+            }
+            lab->celdas[i][j] = valor;
+        }
+        
+        // Fin de fila: solo espacios y salto de línea
+        while (p < fin && (*p == ' ' || *p == '\t' || *p == '\r')) p++;
+        if (p < fin && *p != '\n') {
+            *error = "fila con columnas de más";
+            return 0;
+        }
+        if (p < fin) p++;  // Consume '\n'
+    }
+    
+    // Solo se admiten líneas vacías después de los datos
+    while (p < fin && (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n')) p++;
+    if (p < fin) {
+        *error = "filas de más";
+        return 0;
+    }
+    
+    return 1;  // Archivo válido
+}
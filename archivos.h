@@ -6,20 +6,28 @@
 #ifndef ARCHIVOS_H
 #define ARCHIVOS_H
 
+#include <stdio.h>
+#include <stddef.h>
 #include "laberinto.h"
 
 // Funciones de archivos
 int guardar_laberinto(laberinto* lab, const char* nombreArchivo);
+int escribir_laberinto_texto(FILE* archivo, laberinto* lab);
 laberinto* cargar_laberinto(const char* nombreArchivo);
 int existe_laberinto(const char* nombreArchivo);
 void listar_laberintos_guardados();
 int eliminar_laberinto(const char* nombreArchivo);
 void exportar_laberinto_svg(laberinto* lab, const char* nombreArchivo);
+int exportar_laberinto_svg_completo(laberinto* lab, const char* nombreArchivo,
+                                    int* camino, int longitud, int comprimido);
 void exportar_estadisticas(laberinto* lab, const char* nombreArchivo);
 
 // Funciones auxiliares
 void crear_directorio_laberintos();
 char* generar_nombre_archivo(const char* nombreLaberinto);
 int validar_archivo_laberinto(const char* nombreArchivo);
+char* leer_archivo_completo(const char* ruta, size_t* tamano);
+int parsear_laberinto_texto(const char* datos, size_t tamano, laberinto* lab,
+                            const char** error);
 
 #endif // ARCHIVOS_H
\ No newline at end of file
@@ -0,0 +1,429 @@
+/*
+ * bench.c
+ * Programa de benchmarks: mide generadores, solucionadores y archivos,
+ * y el flujo completo generar → verificar → guardar → estadísticas.
+ * Se compila una vez por tamaño (-DFILAS=n -DCOLUMNAS=n) con 'make bench'.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include "laberinto.h"
+#include "algoritmos.h"
+#include "archivos.h"
+#include "medicion.h"
+#include "memoria.h"
+#include "contraccion.h"
+#include "callejones.h"
+#include "jerarquico.h"
+#include "hitos.h"
+
+#define REPETICIONES_DEFECTO 21
+#define CALENTAMIENTO_DEFECTO 3
+#define NOMBRE_TEMPORAL "_bench_tmp"
+#define NOMBRE_PIPELINE "_bench_pipeline"
+#define NUM_GENERADORES 4
+#define NUM_ETAPAS 4
+
+// ==================== CONTEXTO Y CASOS ====================
+
+/*
+ * contexto_bench - Datos compartidos por los casos
+ */
+typedef struct {
+    laberinto trabajo;         // Laberinto que modifican los generadores
+    laberinto* base;           // Laberinto perfecto para los solucionadores
+    grafo_matriz* grafo;       // Grafo del laberinto base
+    grafo_contraido* contraido; // Grafo de pasillos del laberinto base
+    indice_jerarquico* indice;  // Índice por bloques del laberinto base
+    tabla_hitos* hitos;         // Hitos ALT del laberinto base
+} contexto_bench;
+
+/*
+ * caso_bench - Una operación a medir
+ */
+typedef struct {
+    const char* nombre;                    // Nombre en los resultados
+    void (*ejecutar)(contexto_bench* ctx); // Operación medida
+} caso_bench;
+
+static void caso_generar_aleatorio(contexto_bench* ctx) { generar_aleatorio(&ctx->trabajo); }
+static void caso_generar_perfecto(contexto_bench* ctx) { generar_perfecto(&ctx->trabajo); }
+static void caso_generar_backtracking(contexto_bench* ctx) { generar_con_backtracking(&ctx->trabajo); }
+static void caso_generar_desde_grafo(contexto_bench* ctx) { generar_desde_grafo(&ctx->trabajo); }
+
+static void caso_dijkstra(contexto_bench* ctx) {
+    int distancia;
+    dijkstra_con_estados(ctx->grafo, 0, FILAS * COLUMNAS - 1, &distancia, 0);
+}
+
+static void caso_bfs(contexto_bench* ctx) { bfs(ctx->grafo, 0); }
+
+static void caso_a_estrella(contexto_bench* ctx) {
+    int distancia;
+    a_estrella(ctx->grafo, 0, FILAS * COLUMNAS - 1, &distancia, heuristica_manhattan, NULL, NULL);
+}
+
+static void caso_hitos(contexto_bench* ctx) {
+    destruir_tabla_hitos(hitos_desde_laberinto(ctx->base, HITOS_DEFECTO));
+}
+
+static void caso_a_estrella_alt(contexto_bench* ctx) {
+    int distancia;
+    a_estrella(ctx->grafo, 0, FILAS * COLUMNAS - 1, &distancia, heuristica_hitos, ctx->hitos, NULL);
+}
+
+static void caso_prim(contexto_bench* ctx) {
+    int num_aristas;
+    prim(ctx->grafo, &num_aristas);
+}
+
+static void caso_kruskal(contexto_bench* ctx) {
+    int num_aristas;
+    liberar_aristas(kruskal(ctx->grafo, &num_aristas));
+}
+
+static void caso_floyd_warshall(contexto_bench* ctx) {
+    int inicio, fin;
+    calcular_camino_critico(ctx->grafo, &inicio, &fin);
+}
+
+static void caso_contraer(contexto_bench* ctx) {
+    int extremos[2] = {0, FILAS * COLUMNAS - 1};
+    destruir_grafo_contraido(contraer_laberinto(ctx->base, extremos, 2));
+}
+
+static void caso_dijkstra_contraido(contexto_bench* ctx) {
+    int camino[MAX_NODOS];
+    camino_contraido(ctx->contraido, 0, FILAS * COLUMNAS - 1, camino);
+}
+
+static void caso_kruskal_contraido(contexto_bench* ctx) {
+    int num_aristas;
+    liberar_aristas(arbol_contraido(ctx->contraido, &num_aristas));
+}
+
+static void caso_floyd_warshall_contraido(contexto_bench* ctx) {
+    int inicio, fin;
+    diametro_contraido(ctx->contraido, &inicio, &fin);
+}
+
+static void caso_rellenar_cola(contexto_bench* ctx) {
+    memcpy(&ctx->trabajo, ctx->base, sizeof(laberinto));
+    rellenar_callejones(&ctx->trabajo, RELLENO_COLA);
+}
+
+static void caso_rellenar_bits(contexto_bench* ctx) {
+    memcpy(&ctx->trabajo, ctx->base, sizeof(laberinto));
+    rellenar_callejones(&ctx->trabajo, RELLENO_BITS);
+}
+
+static void caso_construir_indice_jerarquico(contexto_bench* ctx) {
+    destruir_indice_jerarquico(construir_indice_jerarquico(ctx->base, TAM_BLOQUE_JERARQUICO));
+}
+
+static void caso_camino_jerarquico(contexto_bench* ctx) {
+    int camino[MAX_NODOS];
+    camino_jerarquico(ctx->indice, 0, FILAS * COLUMNAS - 1, camino, NULL);
+}
+
+static void caso_guardar(contexto_bench* ctx) { guardar_laberinto(ctx->base, NOMBRE_TEMPORAL); }
+
+static void caso_cargar(contexto_bench* ctx) {
+    (void)ctx;
+    destruir_laberinto(cargar_laberinto(NOMBRE_TEMPORAL));
+}
+
+static const caso_bench casos[] = {
+    {"generar_aleatorio", caso_generar_aleatorio},
+    {"generar_perfecto", caso_generar_perfecto},
+    {"generar_con_backtracking", caso_generar_backtracking},
+    {"generar_desde_grafo", caso_generar_desde_grafo},
+    {"dijkstra_con_estados", caso_dijkstra},
+    {"bfs", caso_bfs},
+    {"a_estrella", caso_a_estrella},
+    {"hitos_desde_laberinto", caso_hitos},
+    {"a_estrella_alt", caso_a_estrella_alt},
+    {"prim", caso_prim},
+    {"kruskal", caso_kruskal},
+    {"floyd_warshall", caso_floyd_warshall},
+    {"contraer_laberinto", caso_contraer},
+    {"dijkstra_contraido", caso_dijkstra_contraido},
+    {"kruskal_contraido", caso_kruskal_contraido},
+    {"floyd_warshall_contraido", caso_floyd_warshall_contraido},
+    {"rellenar_callejones_cola", caso_rellenar_cola},
+    {"rellenar_callejones_bits", caso_rellenar_bits},
+    {"construir_indice_jerarquico", caso_construir_indice_jerarquico},
+    {"camino_jerarquico", caso_camino_jerarquico},
+    {"guardar_laberinto", caso_guardar},
+    {"cargar_laberinto", caso_cargar},
+};
+
+#define NUM_CASOS ((int)(sizeof(casos) / sizeof(casos[0])))
+
+// ==================== SALIDA ====================
+
+/*
+ * imprimir_uso
+ * Muestra las opciones del programa.
+ */
+static void imprimir_uso(FILE* salida, const char* programa) {
+    fprintf(salida, "Uso: %s [opciones]\n", programa);
+    fprintf(salida, "  --reps N          Repeticiones medidas (defecto %d)\n", REPETICIONES_DEFECTO);
+    fprintf(salida, "  --warmup N        Repeticiones de calentamiento (defecto %d)\n", CALENTAMIENTO_DEFECTO);
+    fprintf(salida, "  --formato F       csv o json (defecto csv)\n");
+    fprintf(salida, "  --salida RUTA     Escribe los resultados en un archivo\n");
+    fprintf(salida, "  --caso TEXTO      Solo casos cuyo nombre contiene TEXTO\n");
+    fprintf(salida, "  --sin-encabezado  Omite la línea de encabezado CSV\n");
+    fprintf(salida, "  --pipeline N      Mide el flujo completo con N laberintos por generador\n");
+    fprintf(salida, "  --memoria         Agrega el informe de memoria al final (a stderr)\n");
+}
+
+/*
+ * escribir_resultado
+ * Escribe una fila CSV o un objeto JSON con el resumen de un caso.
+ */
+static void escribir_resultado(FILE* salida, int json, int primero,
+                               const char* caso, const resumen_tiempos* r,
+                               size_t heap_pico) {
+    if (json) {
+        fprintf(salida, "%s\n  {\"filas\": %d, \"columnas\": %d, \"caso\": \"%s\", "
+                "\"repeticiones\": %d, \"min_us\": %.3f, \"mediana_us\": %.3f, "
+                "\"p95_us\": %.3f, \"media_us\": %.3f, \"max_us\": %.3f, "
+                "\"heap_pico_b\": %zu, \"rss_kb\": %ld}",
+                primero ? "" : ",", FILAS, COLUMNAS, caso, r->muestras,
+                r->minimo, r->mediana, r->p95, r->media, r->maximo,
+                heap_pico, pico_rss_kb());
+    } else {
+        fprintf(salida, "%d,%d,%s,%d,%.3f,%.3f,%.3f,%.3f,%.3f,%zu,%ld\n",
+                FILAS, COLUMNAS, caso, r->muestras,
+                r->minimo, r->mediana, r->p95, r->media, r->maximo,
+                heap_pico, pico_rss_kb());
+    }
+}
+
+// ==================== FLUJO COMPLETO ====================
+
+static const char* nombres_generadores[NUM_GENERADORES] = {
+    "aleatorio", "perfecto", "backtracking", "desde_grafo"
+};
+
+/*
+ * tamano_archivo
+ * Bytes de un archivo (0 si no existe).
+ */
+static long tamano_archivo(const char* ruta) {
+    struct stat st;
+    return (stat(ruta, &st) == 0) ? (long)st.st_size : 0;
+}
+
+/*
+ * medir_pipeline
+ * Corre 'cantidad' laberintos por generador por el flujo completo y
+ * reporta laberintos/s, bytes/s y el tiempo de cada etapa.
+ */
+static void medir_pipeline(FILE* salida, int json, int encabezado, int cantidad) {
+    char ruta_laberinto[MAX_NOMBRE + 50];      // Archivo guardado
+    char ruta_estadisticas[MAX_NOMBRE + 50];   // Archivo de estadísticas
+    
+    sprintf(ruta_laberinto, "%s%s.txt", DIRECTORIO_LABERINTOS, NOMBRE_PIPELINE);
+    sprintf(ruta_estadisticas, "%s%s_estadisticas.txt", DIRECTORIO_LABERINTOS, NOMBRE_PIPELINE);
+    
+    laberinto* lab = (laberinto*)reservar_memoria_cero(MEM_LABERINTO, 1, sizeof(laberinto));
+    if (!lab) return;
+    lab->filas = FILAS;
+    lab->columnas = COLUMNAS;
+    strcpy(lab->nombre, NOMBRE_PIPELINE);
+    
+    if (json) {
+        fprintf(salida, "[");
+    } else if (encabezado) {
+        fprintf(salida, "filas,columnas,generador,laberintos,total_ms,laberintos_por_s,"
+                "bytes,bytes_por_s,generar_ms,verificar_ms,guardar_ms,estadisticas_ms,"
+                "heap_pico_b,rss_kb\n");
+    }
+    
+    for (int g = 0; g < NUM_GENERADORES; g++) {
+        uint64_t etapas[NUM_ETAPAS] = {0};   // Nanosegundos por etapa
+        long bytes = 0;                      // Bytes escritos
+        
+        size_t base = bytes_vivos_memoria();   // Sin contar el laberinto de trabajo
+        reiniciar_pico_memoria();
+        for (int k = 0; k < cantidad; k++) {
+            uint64_t t0 = reloj_ns();
+            generar_celdas_segun_tipo(lab, g + 1);
+            uint64_t t1 = reloj_ns();
+            calcular_solucion(lab);
+            uint64_t t2 = reloj_ns();
+            guardar_laberinto(lab, NOMBRE_PIPELINE);
+            uint64_t t3 = reloj_ns();
+            exportar_estadisticas(lab, NOMBRE_PIPELINE);
+            uint64_t t4 = reloj_ns();
+            
+            etapas[0] += t1 - t0;
+            etapas[1] += t2 - t1;
+            etapas[2] += t3 - t2;
+            etapas[3] += t4 - t3;
+            bytes += tamano_archivo(ruta_laberinto) + tamano_archivo(ruta_estadisticas);
+        }
+        
+        uint64_t total = etapas[0] + etapas[1] + etapas[2] + etapas[3];
+        double segundos = (double)total / 1e9;
+        double por_segundo = segundos > 0 ? cantidad / segundos : 0.0;
+        double bytes_por_segundo = segundos > 0 ? bytes / segundos : 0.0;
+        size_t heap = bytes_pico_memoria() - base;
+        
+        if (json) {
+            fprintf(salida, "%s\n  {\"filas\": %d, \"columnas\": %d, \"generador\": \"%s\", "
+                    "\"laberintos\": %d, \"total_ms\": %.3f, \"laberintos_por_s\": %.1f, "
+                    "\"bytes\": %ld, \"bytes_por_s\": %.1f, \"etapas_ms\": {\"generar\": %.3f, "
+                    "\"verificar\": %.3f, \"guardar\": %.3f, \"estadisticas\": %.3f}, "
+                    "\"heap_pico_b\": %zu, \"rss_kb\": %ld}",
+                    g == 0 ? "" : ",", FILAS, COLUMNAS, nombres_generadores[g], cantidad,
+                    total / 1e6, por_segundo, bytes, bytes_por_segundo,
+                    etapas[0] / 1e6, etapas[1] / 1e6, etapas[2] / 1e6, etapas[3] / 1e6,
+                    heap, pico_rss_kb());
+        } else {
+            fprintf(salida, "%d,%d,%s,%d,%.3f,%.1f,%ld,%.1f,%.3f,%.3f,%.3f,%.3f,%zu,%ld\n",
+                    FILAS, COLUMNAS, nombres_generadores[g], cantidad,
+                    total / 1e6, por_segundo, bytes, bytes_por_segundo,
+                    etapas[0] / 1e6, etapas[1] / 1e6, etapas[2] / 1e6, etapas[3] / 1e6,
+                    heap, pico_rss_kb());
+        }
+        fflush(salida);
+    }
+    
+    if (json) fprintf(salida, "\n]\n");
+    
+    remove(ruta_laberinto);
+    remove(ruta_estadisticas);
+    liberar_memoria(lab);
+}
+
+// ==================== PROGRAMA PRINCIPAL ====================
+
+int main(int argc, char* argv[]) {
+    int repeticiones = REPETICIONES_DEFECTO;
+    int calentamiento = CALENTAMIENTO_DEFECTO;
+    int json = 0;                 // 1 = JSON, 0 = CSV
+    int encabezado = 1;           // Encabezado CSV
+    const char* ruta_salida = NULL;
+    const char* filtro = NULL;
+    int pipeline = 0;             // Laberintos por generador (0 = microbenchmarks)
+    int informe_memoria = 0;      // Informe por subsistema al terminar
+    
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--reps") == 0 && i + 1 < argc) {
+            repeticiones = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--warmup") == 0 && i + 1 < argc) {
+            calentamiento = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--formato") == 0 && i + 1 < argc) {
+            json = (strcmp(argv[++i], "json") == 0);
+        } else if (strcmp(argv[i], "--salida") == 0 && i + 1 < argc) {
+            ruta_salida = argv[++i];
+        } else if (strcmp(argv[i], "--caso") == 0 && i + 1 < argc) {
+            filtro = argv[++i];
+        } else if (strcmp(argv[i], "--pipeline") == 0 && i + 1 < argc) {
+            pipeline = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--memoria") == 0) {
+            informe_memoria = 1;
+        } else if (strcmp(argv[i], "--sin-encabezado") == 0) {
+            encabezado = 0;
+        } else {
+            imprimir_uso(stderr, argv[0]);
+            return 1;
+        }
+    }
+    if (repeticiones < 1) repeticiones = 1;
+    if (calentamiento < 0) calentamiento = 0;
+    
+    // Resultados por una copia de stdout; la salida de la biblioteca se descarta
+    FILE* salida = ruta_salida ? fopen(ruta_salida, "w") : fdopen(dup(STDOUT_FILENO), "w");
+    if (salida == NULL) {
+        fprintf(stderr, "No se pudo abrir la salida de resultados\n");
+        return 1;
+    }
+    if (freopen("/dev/null", "w", stdout) == NULL) {
+        fprintf(stderr, "No se pudo silenciar la salida estándar\n");
+        return 1;
+    }
+    
+    crear_directorio_laberintos();
+    
+    if (pipeline > 0) {
+        medir_pipeline(salida, json, encabezado, pipeline);
+        if (informe_memoria) imprimir_informe_memoria(stderr);
+        fclose(salida);
+        return 0;
+    }
+    
+    // Datos de entrada: un laberinto perfecto, su grafo, su grafo contraído,
+    // su índice por bloques y sus hitos
+    contexto_bench ctx;
+    memset(&ctx, 0, sizeof(ctx));
+    ctx.trabajo.filas = FILAS;
+    ctx.trabajo.columnas = COLUMNAS;
+    ctx.base = crear_laberinto_segun_tipo(3, "bench");
+    ctx.grafo = (grafo_matriz*)reservar_memoria(MEM_GRAFO, sizeof(grafo_matriz));
+    double* muestras = (double*)reservar_memoria(MEM_ALGORITMOS, repeticiones * sizeof(double));
+    int extremos[2] = {0, FILAS * COLUMNAS - 1};
+    if (ctx.base) ctx.contraido = contraer_laberinto(ctx.base, extremos, 2);
+    if (ctx.base) ctx.indice = construir_indice_jerarquico(ctx.base, TAM_BLOQUE_JERARQUICO);
+    if (ctx.base) ctx.hitos = hitos_desde_laberinto(ctx.base, HITOS_DEFECTO);
+    if (!ctx.base || !ctx.grafo || !ctx.contraido || !ctx.indice || !ctx.hitos || !muestras) {
+        fprintf(stderr, "Sin memoria\n");
+        return 1;
+    }
+    laberinto_a_grafo(ctx.base, ctx.grafo);
+    guardar_laberinto(ctx.base, NOMBRE_TEMPORAL);   // Archivo para cargar_laberinto
+    
+    if (json) {
+        fprintf(salida, "[");
+    } else if (encabezado) {
+        fprintf(salida, "filas,columnas,caso,repeticiones,min_us,mediana_us,p95_us,media_us,max_us,"
+                "heap_pico_b,rss_kb\n");
+    }
+    
+    int primero = 1;
+    for (int c = 0; c < NUM_CASOS; c++) {
+        if (filtro != NULL && strstr(casos[c].nombre, filtro) == NULL) continue;
+        
+        for (int i = 0; i < calentamiento; i++) {
+            casos[c].ejecutar(&ctx);
+        }
+        
+        // Pico de memoria dinámica solo de este caso, sin los datos de entrada
+        size_t base = bytes_vivos_memoria();
+        reiniciar_pico_memoria();
+        for (int i = 0; i < repeticiones; i++) {
+            uint64_t inicio = reloj_ns();
+            casos[c].ejecutar(&ctx);
+            muestras[i] = (double)(reloj_ns() - inicio) / 1000.0;
+        }
+        
+        resumen_tiempos resumen;
+        resumir_tiempos(muestras, repeticiones, &resumen);
+        escribir_resultado(salida, json, primero, casos[c].nombre, &resumen,
+                           bytes_pico_memoria() - base);
+        fflush(salida);
+        primero = 0;
+    }
+    
+    if (json) fprintf(salida, "\n]\n");
+    
+    eliminar_laberinto(NOMBRE_TEMPORAL);
+    liberar_memoria(muestras);
+    liberar_memoria(ctx.grafo);
+    destruir_grafo_contraido(ctx.contraido);
+    destruir_indice_jerarquico(ctx.indice);
+    destruir_tabla_hitos(ctx.hitos);
+    destruir_laberinto(ctx.base);
+    if (informe_memoria) imprimir_informe_memoria(stderr);
+    fclose(salida);
+    
+    return 0;
+}
@@ -0,0 +1,220 @@
+/*
+ * callejones.c
+ * Dos motores para el mismo relleno de callejones. La cola procesa cada
+ * celda una vez; el tablero de bits tapia de una pasada todas las puntas
+ * de callejón, 64 celdas por operación, y repite tantas pasadas como
+ * largo tenga el callejón más largo. Ambos llegan al mismo resultado.
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include "callejones.h"
+#include "consultas.h"
+#include "distancias.h"
+#include "memoria.h"
+
+// Palabras de 64 bits del tablero (un bit por nodo)
+#define PALABRAS_TABLERO ((MAX_NODOS + 63) / 64)
+
+// ==================== MOTOR CON COLA ====================
+
+/*
+ * es_protegida
+ * INICIO y FINAL nunca se tapian.
+ */
+static int es_protegida(laberinto* lab, int nodo) {
+    int tipo = lab->celdas[nodo / COLUMNAS][nodo % COLUMNAS];
+    return tipo == INICIO || tipo == FINAL;
+}
+
+/*
+ * rellenar_con_cola
+ * Encola las celdas con uno o ningún vecino abierto; al tapiar una, su
+ * vecino pierde un grado y entra en la cola si queda con uno solo.
+ */
+static int rellenar_con_cola(laberinto* lab) {
+    size_t bytes = MAX_NODOS * (2 * sizeof(int) + 1);
+    int* grado = (int*)reservar_memoria(MEM_ALGORITMOS, bytes);
+    if (grado == NULL) return -1;
+    int* cola = grado + MAX_NODOS;
+    unsigned char* vecinos = (unsigned char*)(cola + MAX_NODOS);
+    int cabeza = 0, fin = 0, rellenadas = 0;
+
+    calcular_vecinos(lab, vecinos);
+    for (int n = 0; n < MAX_NODOS; n++) {
+        grado[n] = 0;
+        for (int d = 0; d < 4; d++) {
+            if (vecinos[n] & (1 << d)) grado[n]++;
+        }
+        if (lab->celdas[n / COLUMNAS][n % COLUMNAS] != PARED && grado[n] <= 1 &&
+            !es_protegida(lab, n)) {
+            cola[fin++] = n;
+        }
+    }
+
+    while (cabeza < fin) {
+        int n = cola[cabeza++];
+        lab->celdas[n / COLUMNAS][n % COLUMNAS] = PARED;
+        rellenadas++;
+
+        for (int d = 0; d < 4; d++) {
+            if (!(vecinos[n] & (1 << d))) continue;
+            int m = n + PASO_VECINO(d);
+            if (lab->celdas[m / COLUMNAS][m % COLUMNAS] == PARED || es_protegida(lab, m)) continue;
+            if (--grado[m] == 1) cola[fin++] = m;
+        }
+    }
+
+    liberar_memoria(grado);
+    return rellenadas;
+}
+
+// ==================== MOTOR CON TABLERO DE BITS ====================
+
+/*
+ * hacia_menores
+ * destino[i] = origen[i + k] (k > 0); lo que sale del tablero es 0.
+ */
+static void hacia_menores(const uint64_t* origen, uint64_t* destino, int k) {
+    int salto = k >> 6, resto = k & 63;
+
+    for (int w = 0; w < PALABRAS_TABLERO; w++) {
+        uint64_t bajo = (w + salto < PALABRAS_TABLERO) ? origen[w + salto] : 0;
+        uint64_t alto = (w + salto + 1 < PALABRAS_TABLERO) ? origen[w + salto + 1] : 0;
+        destino[w] = resto ? (bajo >> resto) | (alto << (64 - resto)) : bajo;
+    }
+}
+
+/*
+ * hacia_mayores
+ * destino[i] = origen[i - k] (k > 0); lo que entra por abajo es 0.
+ */
+static void hacia_mayores(const uint64_t* origen, uint64_t* destino, int k) {
+    int salto = k >> 6, resto = k & 63;
+
+    for (int w = 0; w < PALABRAS_TABLERO; w++) {
+        uint64_t alto = (w - salto >= 0) ? origen[w - salto] : 0;
+        uint64_t bajo = (w - salto - 1 >= 0) ? origen[w - salto - 1] : 0;
+        destino[w] = resto ? (alto << resto) | (bajo >> (64 - resto)) : alto;
+    }
+}
+
+/*
+ * rellenar_con_bits
+ * Abiertas como un bit por nodo. En cada pasada los vecinos de todas las
+ * celdas salen de cuatro desplazamientos (con máscaras para no cruzar de
+ * una fila a la siguiente) y se tapian a la vez las que no tienen dos.
+ */
+static int rellenar_con_bits(laberinto* lab) {
+    uint64_t* bloque = (uint64_t*)reservar_memoria_cero(MEM_ALGORITMOS, 8 * PALABRAS_TABLERO,
+                                                        sizeof(uint64_t));
+    if (bloque == NULL) return -1;
+    uint64_t* abiertas = bloque;
+    uint64_t* protegidas = abiertas + PALABRAS_TABLERO;
+    uint64_t* con_oeste = protegidas + PALABRAS_TABLERO;    // Celdas que no están en la columna 0
+    uint64_t* con_este = con_oeste + PALABRAS_TABLERO;      // Ni en la última columna
+    uint64_t* norte = con_este + PALABRAS_TABLERO;
+    uint64_t* sur = norte + PALABRAS_TABLERO;
+    uint64_t* este = sur + PALABRAS_TABLERO;
+    uint64_t* oeste = este + PALABRAS_TABLERO;
+
+    for (int n = 0; n < MAX_NODOS; n++) {
+        uint64_t bit = (uint64_t)1 << (n & 63);
+        int columna = n % COLUMNAS;
+        if (lab->celdas[n / COLUMNAS][columna] != PARED) abiertas[n >> 6] |= bit;
+        if (es_protegida(lab, n)) protegidas[n >> 6] |= bit;
+        if (columna > 0) con_oeste[n >> 6] |= bit;
+        if (columna < COLUMNAS - 1) con_este[n >> 6] |= bit;
+    }
+
+    int quedan = 1;
+    while (quedan) {
+        hacia_mayores(abiertas, norte, COLUMNAS);
+        hacia_menores(abiertas, sur, COLUMNAS);
+        hacia_menores(abiertas, este, 1);
+        hacia_mayores(abiertas, oeste, 1);
+
+        quedan = 0;
+        for (int w = 0; w < PALABRAS_TABLERO; w++) {
+            uint64_t e = este[w] & con_este[w];
+            uint64_t o = oeste[w] & con_oeste[w];
+            // Al menos dos de los cuatro vecinos abiertos
+            uint64_t dos = (norte[w] & sur[w]) | (e & o) | ((norte[w] | sur[w]) & (e | o));
+            uint64_t puntas = abiertas[w] & ~dos & ~protegidas[w];
+            if (puntas) {
+                abiertas[w] &= ~puntas;
+                quedan = 1;
+            }
+        }
+    }
+
+    int rellenadas = 0;
+    for (int n = 0; n < MAX_NODOS; n++) {
+        int* celda = &lab->celdas[n / COLUMNAS][n % COLUMNAS];
+        if (*celda != PARED && !(abiertas[n >> 6] & ((uint64_t)1 << (n & 63)))) {
+            *celda = PARED;
+            rellenadas++;
+        }
+    }
+
+    liberar_memoria(bloque);
+    return rellenadas;
+}
+
+// ==================== RELLENO ====================
+
+/*
+ * rellenar_callejones
+ * Tapia los callejones del laberinto con el motor RELLENO_*.
+ * Retorna las celdas tapiadas o -1 si falta memoria.
+ */
+int rellenar_callejones(laberinto* lab, int motor) {
+    int rellenadas = (motor == RELLENO_BITS) ? rellenar_con_bits(lab) : rellenar_con_cola(lab);
+    if (rellenadas > 0) invalidar_campo_distancias(lab);
+    return rellenadas;
+}
+
+/*
+ * podar_laberinto
+ * Copia del laberinto sin callejones; la solución y sus pasos se
+ * conservan. Deja en rellenadas las celdas tapiadas (admite NULL).
+ * Retorna NULL si falta memoria.
+ */
+laberinto* podar_laberinto(laberinto* lab, int motor, int* rellenadas) {
+    laberinto* copia = (laberinto*)reservar_memoria(MEM_LABERINTO, sizeof(laberinto));
+    if (copia == NULL) return NULL;
+    memcpy(copia, lab, sizeof(laberinto));
+
+    int tapiadas = rellenar_callejones(copia, motor);
+    if (tapiadas < 0) {
+        liberar_memoria(copia);
+        return NULL;
+    }
+    if (rellenadas != NULL) *rellenadas = tapiadas;
+    return copia;
+}
+
+// ==================== MEDIDAS ====================
+
+/*
+ * contar_callejones
+ * Puntas de callejón: celdas abiertas con un solo vecino abierto, sin
+ * contar INICIO ni FINAL.
+ */
+int contar_callejones(laberinto* lab) {
+    int callejones = 0;
+
+    for (int i = 0; i < FILAS; i++) {
+        for (int j = 0; j < COLUMNAS; j++) {
+            if (lab->celdas[i][j] == PARED || es_protegida(lab, i * COLUMNAS + j)) continue;
+
+            int abiertos = 0;
+            if (i > 0 && lab->celdas[i - 1][j] != PARED) abiertos++;
+            if (i < FILAS - 1 && lab->celdas[i + 1][j] != PARED) abiertos++;
+            if (j > 0 && lab->celdas[i][j - 1] != PARED) abiertos++;
+            if (j < COLUMNAS - 1 && lab->celdas[i][j + 1] != PARED) abiertos++;
+            if (abiertos == 1) callejones++;
+        }
+    }
+    return callejones;
+}
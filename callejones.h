@@ -0,0 +1,31 @@
+/*
+ * callejones.h
+ * Relleno de callejones sin salida: tapia una y otra vez las celdas con
+ * un solo vecino abierto (salvo INICIO y FINAL) hasta que no queda
+ * ninguno. Los caminos entre INICIO y FINAL no cambian.
+ */
+
+#ifndef CALLEJONES_H
+#define CALLEJONES_H
+
+#include "laberinto.h"
+
+// ============================================================================
+// MOTORES DE RELLENO
+// ============================================================================
+
+#define RELLENO_COLA 0      // Cola de celdas con un vecino: O(celdas)
+#define RELLENO_BITS 1      // Tablero de bits: 64 celdas por operación en cada pasada
+
+// ============================================================================
+// PROTOTIPOS DE FUNCIONES
+// ============================================================================
+
+/* Relleno */
+int rellenar_callejones(laberinto* lab, int motor);
+laberinto* podar_laberinto(laberinto* lab, int motor, int* rellenadas);
+
+/* Medidas */
+int contar_callejones(laberinto* lab);
+
+#endif // CALLEJONES_H
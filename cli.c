@@ -0,0 +1,1177 @@
+/*
+ * cli.c
+ * Subcomandos no interactivos: leen laberintos de archivos o stdin
+ * y escriben un registro por laberinto en stdout, sin menús ni pausas.
+ * servir y consultar delegan en servidor.c; rutas, en consultas.c
+ * o en arbol_lca.c; sucinto, en arbol_sucinto.c.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <limits.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "cli.h"
+#include "laberinto.h"
+#include "archivos.h"
+#include "imagen.h"
+#include "paquete.h"
+#include "servidor.h"
+#include "consultas.h"
+#include "arbol_lca.h"
+#include "arbol_sucinto.h"
+#include "callejones.h"
+#include "jerarquico.h"
+#include "hitos.h"
+#include "medicion.h"
+#include "memoria.h"
+
+#define MAX_ENTRADAS_CLI 64     // Archivos de entrada por invocación
+#define LOTE_PAQUETE 256        // Laberintos por escritura del índice
+
+// ==================== OPCIONES ====================
+
+/*
+ * opciones_cli - Banderas comunes a todos los subcomandos
+ */
+typedef struct {
+    int tipo;                   // Generador (1-4)
+    int cantidad;               // Laberintos a generar
+    unsigned int semilla;       // Semilla de rand()
+    int tiene_semilla;          // 1 si se pasó --semilla
+    int algoritmo;              // Id para resolver_laberinto
+    const char* nombre_algoritmo;   // Nombre para la salida
+    const char* formato;        // Formato de exportar/convertir
+    const char* salida;         // Archivo de salida (NULL o "-" = stdout)
+    const char* nombre;         // Nombre base de los laberintos generados
+    int pixeles_por_celda;      // Escala de imágenes raster
+    int con_camino;             // 1 para incluir la solución
+    int encabezado;             // 1 para imprimir encabezado TSV
+    const char* socket;         // Socket del servidor
+    int capacidad;              // Laberintos en la caché del servidor
+    int hilos;                  // Hilos para lotes de rutas
+    const char* motor;          // Motor de rutas (auto, bfs, lca, hpa, alt) o de podar (cola, bits)
+    int hitos;                  // Hitos de ALT (--algoritmo alt, --motor alt)
+    int con_resumen;            // 1 para informar tiempos en stderr
+    const char* entradas[MAX_ENTRADAS_CLI];  // Archivos ("-" = stdin)
+    int num_entradas;           // Archivos de entrada
+} opciones_cli;
+
+/* algoritmos_cli - Nombres aceptados por --algoritmo */
+static const struct {
+    const char* nombre;
+    int id;                     // Id de resolver_laberinto
+} algoritmos_cli[] = {
+    {"dijkstra", 1},
+    {"bfs", 2},
+    {"a*", 3},
+    {"astar", 3},
+    {"contraido", 4},
+    {"hpa", 5},
+    {"alt", 6},
+};
+
+#define NUM_ALGORITMOS_CLI ((int)(sizeof(algoritmos_cli) / sizeof(algoritmos_cli[0])))
+
+/*
+ * leer_numero
+ * Convierte un argumento a entero dentro de [minimo, maximo].
+ * Retorna 0 si no es un número completo o está fuera de rango.
+ */
+static int leer_numero(const char* texto, long minimo, long maximo, long* valor) {
+    char* fin;
+    long numero = strtol(texto, &fin, 10);
+
+    if (*texto == '\0' || *fin != '\0' || numero < minimo || numero > maximo) {
+        return 0;
+    }
+    *valor = numero;
+    return 1;
+}
+
+/*
+ * parsear_opciones
+ * Lee las banderas que siguen al subcomando.
+ * Los argumentos sueltos son archivos de entrada; "-" es stdin.
+ */
+static int parsear_opciones(int argc, char* argv[], opciones_cli* op) {
+    memset(op, 0, sizeof(*op));
+    op->tipo = 1;
+    op->cantidad = 1;
+    op->algoritmo = 1;
+    op->nombre_algoritmo = "dijkstra";
+    op->pixeles_por_celda = 8;
+    op->encabezado = 1;
+    op->socket = SOCKET_SERVIDOR;
+    op->capacidad = CAPACIDAD_CACHE_SERVIDOR;
+    op->hilos = hilos_disponibles();
+    op->motor = "auto";
+    op->hitos = HITOS_DEFECTO;
+
+    for (int i = 2; i < argc; i++) {
+        const char* arg = argv[i];
+        const char* valor = (i + 1 < argc) ? argv[i + 1] : NULL;
+        long numero;
+
+        // Banderas sin valor
+        if (strcmp(arg, "--camino") == 0) {
+            op->con_camino = 1;
+            continue;
+        }
+        if (strcmp(arg, "--sin-encabezado") == 0) {
+            op->encabezado = 0;
+            continue;
+        }
+        if (strcmp(arg, "--resumen") == 0) {
+            op->con_resumen = 1;
+            continue;
+        }
+        if (arg[0] != '-' || strcmp(arg, "-") == 0) {
+            if (op->num_entradas == MAX_ENTRADAS_CLI) {
+                fprintf(stderr, "Error: más de %d archivos de entrada\n", MAX_ENTRADAS_CLI);
+                return 0;
+            }
+            op->entradas[op->num_entradas++] = arg;
+            continue;
+        }
+
+        // Banderas con valor
+        if (valor == NULL) {
+            fprintf(stderr, "Error: falta el valor de %s\n", arg);
+            return 0;
+        }
+        i++;
+
+        if (strcmp(arg, "--tipo") == 0 || strcmp(arg, "-t") == 0) {
+            if (!leer_numero(valor, 1, 4, &numero)) {
+                fprintf(stderr, "Error: --tipo debe estar entre 1 y 4\n");
+                return 0;
+            }
+            op->tipo = (int)numero;
+        } else if (strcmp(arg, "--cantidad") == 0 || strcmp(arg, "-n") == 0) {
+            if (!leer_numero(valor, 1, 100000000L, &numero)) {
+                fprintf(stderr, "Error: --cantidad inválida: %s\n", valor);
+                return 0;
+            }
+            op->cantidad = (int)numero;
+        } else if (strcmp(arg, "--semilla") == 0 || strcmp(arg, "-s") == 0) {
+            if (!leer_numero(valor, 0, 4294967295L, &numero)) {
+                fprintf(stderr, "Error: --semilla inválida: %s\n", valor);
+                return 0;
+            }
+            op->semilla = (unsigned int)numero;
+            op->tiene_semilla = 1;
+        } else if (strcmp(arg, "--algoritmo") == 0 || strcmp(arg, "-a") == 0) {
+            int k;
+            for (k = 0; k < NUM_ALGORITMOS_CLI; k++) {
+                if (strcmp(valor, algoritmos_cli[k].nombre) == 0) break;
+            }
+            if (k == NUM_ALGORITMOS_CLI) {
+                fprintf(stderr, "Error: algoritmo desconocido: %s\n", valor);
+                return 0;
+            }
+            op->algoritmo = algoritmos_cli[k].id;
+            op->nombre_algoritmo = algoritmos_cli[k].nombre;
+        } else if (strcmp(arg, "--formato") == 0 || strcmp(arg, "-f") == 0) {
+            op->formato = valor;
+        } else if (strcmp(arg, "--salida") == 0 || strcmp(arg, "-o") == 0) {
+            op->salida = valor;
+        } else if (strcmp(arg, "--socket") == 0) {
+            op->socket = valor;
+        } else if (strcmp(arg, "--capacidad") == 0) {
+            if (!leer_numero(valor, 1, 1000000L, &numero)) {
+                fprintf(stderr, "Error: --capacidad inválida: %s\n", valor);
+                return 0;
+            }
+            op->capacidad = (int)numero;
+        } else if (strcmp(arg, "--hilos") == 0) {
+            if (!leer_numero(valor, 1, MAX_HILOS_CONSULTAS, &numero)) {
+                fprintf(stderr, "Error: --hilos debe estar entre 1 y %d\n", MAX_HILOS_CONSULTAS);
+                return 0;
+            }
+            op->hilos = (int)numero;
+        } else if (strcmp(arg, "--motor") == 0) {
+            if (strcmp(valor, "auto") != 0 && strcmp(valor, "bfs") != 0 &&
+                strcmp(valor, "lca") != 0 && strcmp(valor, "cola") != 0 &&
+                strcmp(valor, "bits") != 0 && strcmp(valor, "hpa") != 0 &&
+                strcmp(valor, "alt") != 0) {
+                fprintf(stderr, "Error: --motor debe ser auto, bfs, lca, hpa, alt, cola o bits\n");
+                return 0;
+            }
+            op->motor = valor;
+        } else if (strcmp(arg, "--hitos") == 0) {
+            if (!leer_numero(valor, 1, MAX_HITOS, &numero)) {
+                fprintf(stderr, "Error: --hitos debe estar entre 1 y %d\n", MAX_HITOS);
+                return 0;
+            }
+            op->hitos = (int)numero;
+        } else if (strcmp(arg, "--nombre") == 0) {
+            op->nombre = valor;
+        } else if (strcmp(arg, "--ppc") == 0) {
+            if (!leer_numero(valor, 1, MAX_PIXELES_CELDA, &numero)) {
+                fprintf(stderr, "Error: --ppc debe estar entre 1 y %d\n", MAX_PIXELES_CELDA);
+                return 0;
+            }
+            op->pixeles_por_celda = (int)numero;
+        } else if (strcmp(arg, "--filas") == 0 || strcmp(arg, "--columnas") == 0) {
+            // Las dimensiones son de compilación: solo se valida que coincidan
+            long esperado = (strcmp(arg, "--filas") == 0) ? FILAS : COLUMNAS;
+            if (!leer_numero(valor, 1, 1000000L, &numero) || numero != esperado) {
+                fprintf(stderr, "Error: este binario genera laberintos de %dx%d; "
+                        "recompile con make CFLAGS+=\"-DFILAS=N -DCOLUMNAS=M\"\n",
+                        FILAS, COLUMNAS);
+                return 0;
+            }
+        } else {
+            fprintf(stderr, "Error: opción desconocida: %s\n", arg);
+            return 0;
+        }
+    }
+
+    if (op->num_entradas == 0) {
+        op->entradas[op->num_entradas++] = "-";  // Por defecto lee stdin
+    }
+    return 1;
+}
+
+/*
+ * abrir_salida / cerrar_salida
+ * La salida de texto va a --salida o a stdout.
+ * cerrar_salida retorna 0 si hubo errores de escritura.
+ */
+static FILE* abrir_salida(const opciones_cli* op) {
+    if (op->salida == NULL || strcmp(op->salida, "-") == 0) {
+        return stdout;
+    }
+    FILE* flujo = fopen(op->salida, "w");
+    if (flujo == NULL) {
+        fprintf(stderr, "Error: no se pudo crear %s\n", op->salida);
+    }
+    return flujo;
+}
+
+static int cerrar_salida(FILE* flujo) {
+    if (flujo == stdout) {
+        return fflush(stdout) == 0 && ferror(stdout) == 0;
+    }
+    int ok = (ferror(flujo) == 0);
+    return (fclose(flujo) == 0) && ok;
+}
+
+// ==================== LECTURA DE FLUJOS ====================
+
+/*
+ * lector_laberintos - Flujo de texto con varios laberintos seguidos
+ * Cada registro termina donde empieza el siguiente "# LABERINTO".
+ */
+typedef struct {
+    FILE* archivo;              // Flujo de entrada
+    char* registro;             // Texto del laberinto en curso
+    size_t usados;              // Bytes en registro
+    size_t capacidad;           // Bytes reservados
+    char linea[MAX_LINEA];      // Último trozo leído con fgets
+    int linea_pendiente;        // 1 si linea abre el próximo registro
+    int inicio_de_linea;        // 1 si el próximo trozo empieza una línea
+} lector_laberintos;
+
+/*
+ * agregar_a_registro
+ * Copia texto al final del registro, creciendo al doble si hace falta.
+ */
+static int agregar_a_registro(lector_laberintos* lector, const char* texto, size_t n) {
+    if (lector->usados + n + 1 > lector->capacidad) {
+        size_t nueva = lector->capacidad ? lector->capacidad : 4096;
+        while (nueva < lector->usados + n + 1) nueva *= 2;
+        char* datos = (char*)redimensionar_memoria(MEM_ARCHIVOS, lector->registro, nueva);
+        if (!datos) return 0;
+        lector->registro = datos;
+        lector->capacidad = nueva;
+    }
+    memcpy(lector->registro + lector->usados, texto, n);
+    lector->usados += n;
+    lector->registro[lector->usados] = '\0';
+    return 1;
+}
+
+/*
+ * leer_registro
+ * Junta líneas hasta el próximo encabezado o el fin del flujo.
+ * Retorna 1 si hay registro, 0 al terminar y -1 sin memoria.
+ */
+static int leer_registro(lector_laberintos* lector) {
+    int hay_datos = 0;  // 1 si el registro tiene algo más que espacios
+    lector->usados = 0;
+
+    if (lector->linea_pendiente) {
+        lector->linea_pendiente = 0;
+        if (!agregar_a_registro(lector, lector->linea, strlen(lector->linea))) return -1;
+        hay_datos = 1;
+    }
+
+    while (fgets(lector->linea, sizeof(lector->linea), lector->archivo) != NULL) {
+        size_t n = strlen(lector->linea);
+        int empieza_linea = lector->inicio_de_linea;
+        lector->inicio_de_linea = (n > 0 && lector->linea[n - 1] == '\n');
+
+        // Un encabezado después de datos cierra el registro actual
+        if (empieza_linea && hay_datos && strncmp(lector->linea, "# LABERINTO", 11) == 0) {
+            lector->linea_pendiente = 1;
+            break;
+        }
+        if (!agregar_a_registro(lector, lector->linea, n)) return -1;
+        if (strspn(lector->linea, " \t\r\n") < n) hay_datos = 1;
+    }
+
+    return hay_datos;
+}
+
+// ==================== RECORRIDO DE ENTRADAS ====================
+
+/* accion_laberinto - Trabajo de un subcomando sobre cada laberinto */
+typedef int (*accion_laberinto)(laberinto* lab, const opciones_cli* op, void* contexto);
+
+/*
+ * es_paquete
+ * Mira la firma del archivo para distinguir paquetes de texto.
+ */
+static int es_paquete(const char* ruta) {
+    char magia[8];
+
+    if (strcmp(ruta, "-") == 0) return 0;  // stdin siempre es texto
+    FILE* archivo = fopen(ruta, "rb");
+    if (archivo == NULL) return 0;
+    int ok = fread(magia, 1, sizeof(magia), archivo) == sizeof(magia) &&
+             memcmp(magia, MAGIA_PAQUETE, sizeof(magia)) == 0;
+    fclose(archivo);
+    return ok;
+}
+
+/*
+ * recorrer_paquete
+ * Aplica la acción a cada entrada de un paquete, en orden de índice.
+ */
+static int recorrer_paquete(const char* ruta, accion_laberinto accion,
+                            const opciones_cli* op, void* contexto) {
+    int errores = 0;
+    paquete* paq = abrir_paquete(ruta);
+    if (paq == NULL) {
+        fprintf(stderr, "%s: paquete inválido\n", ruta);
+        return 1;
+    }
+
+    for (uint32_t k = 0; k < paq->cabecera->num_entradas; k++) {
+        laberinto* lab = cargar_de_paquete(paq, &paq->indice[k]);
+        if (lab == NULL) {
+            fprintf(stderr, "%s: entrada %u inválida\n", ruta, k + 1);
+            errores++;
+            continue;
+        }
+        if (!accion(lab, op, contexto)) errores++;
+        destruir_laberinto(lab);
+    }
+
+    cerrar_paquete(paq);
+    return errores;
+}
+
+/*
+ * recorrer_texto
+ * Aplica la acción a cada laberinto de un flujo de texto.
+ * Un registro inválido se informa en stderr y no detiene el resto.
+ */
+static int recorrer_texto(const char* ruta, accion_laberinto accion,
+                          const opciones_cli* op, void* contexto) {
+    lector_laberintos lector;
+    int errores = 0, numero = 0, leido;
+
+    memset(&lector, 0, sizeof(lector));
+    lector.inicio_de_linea = 1;
+    lector.archivo = (strcmp(ruta, "-") == 0) ? stdin : fopen(ruta, "r");
+    if (lector.archivo == NULL) {
+        fprintf(stderr, "%s: no se pudo abrir\n", ruta);
+        return 1;
+    }
+
+    laberinto* lab = (laberinto*)reservar_memoria(MEM_LABERINTO, sizeof(laberinto));
+    while (lab != NULL && (leido = leer_registro(&lector)) > 0) {
+        const char* error = NULL;
+        numero++;
+        if (!parsear_laberinto_texto(lector.registro, lector.usados, lab, &error)) {
+            fprintf(stderr, "%s: laberinto %d: %s\n", ruta, numero, error);
+            errores++;
+        } else if (!accion(lab, op, contexto)) {
+            errores++;
+        }
+    }
+    if (lab == NULL || leido < 0) {
+        fprintf(stderr, "%s: sin memoria\n", ruta);
+        errores++;
+    }
+
+    liberar_memoria(lab);
+    liberar_memoria(lector.registro);
+    if (lector.archivo != stdin) fclose(lector.archivo);
+    return errores;
+}
+
+/*
+ * recorrer_entradas
+ * Recorre todos los archivos de entrada, de texto o paquetes.
+ * Retorna el código de salida del subcomando.
+ */
+static int recorrer_entradas(const opciones_cli* op, accion_laberinto accion, void* contexto) {
+    int errores = 0;
+
+    for (int i = 0; i < op->num_entradas; i++) {
+        const char* ruta = op->entradas[i];
+        if (es_paquete(ruta)) {
+            errores += recorrer_paquete(ruta, accion, op, contexto);
+        } else {
+            errores += recorrer_texto(ruta, accion, op, contexto);
+        }
+    }
+
+    return errores ? SALIDA_CLI_ERROR : SALIDA_CLI_OK;
+}
+
+// ==================== SUBCOMANDOS ====================
+
+/*
+ * ejecutar_generar
+ * Genera --cantidad laberintos y los escribe como texto.
+ * Con varios laberintos cada nombre lleva un sufijo _N.
+ */
+static int ejecutar_generar(const opciones_cli* op) {
+    char base[MAX_NOMBRE];           // Nombre dado o meme aleatorio
+    char nombre[MAX_NOMBRE + 16];    // Nombre con sufijo
+    int errores = 0;
+
+    FILE* flujo = abrir_salida(op);
+    if (flujo == NULL) return SALIDA_CLI_ERROR;
+
+    for (int i = 0; i < op->cantidad; i++) {
+        if (op->nombre != NULL) {
+            snprintf(base, sizeof(base), "%s", op->nombre);
+        } else {
+            obtener_nombre_aleatorio(base);
+        }
+        if (op->cantidad > 1) {
+            snprintf(nombre, sizeof(nombre), "%s_%d", base, i + 1);
+        } else {
+            snprintf(nombre, sizeof(nombre), "%s", base);
+        }
+
+        laberinto* lab = crear_laberinto_segun_tipo(op->tipo, nombre);
+        if (lab == NULL) {
+            fprintf(stderr, "Error: sin memoria para el laberinto %d\n", i + 1);
+            errores++;
+            break;
+        }
+        if (!escribir_laberinto_texto(flujo, lab)) errores++;
+        destruir_laberinto(lab);
+    }
+
+    if (!cerrar_salida(flujo)) errores++;
+    return errores ? SALIDA_CLI_ERROR : SALIDA_CLI_OK;
+}
+
+/*
+ * accion_resolver
+ * Una línea por laberinto: nombre, algoritmo, pasos (-1 sin solución)
+ * y, con --camino, las celdas fila,columna separadas por espacios.
+ */
+static int accion_resolver(laberinto* lab, const opciones_cli* op, void* contexto) {
+    FILE* flujo = (FILE*)contexto;
+    int longitud = 0;
+    int* camino = resolver_laberinto(lab, op->algoritmo, &longitud);
+
+    fprintf(flujo, "%s\t%s\t%d", lab->nombre, op->nombre_algoritmo,
+            camino != NULL ? longitud - 1 : -1);
+    if (op->con_camino) {
+        fputc('\t', flujo);
+        for (int k = 0; camino != NULL && k < longitud; k++) {
+            int fila, columna;
+            convertir_coordenadas(camino[k], &fila, &columna);
+            fprintf(flujo, k ? " %d,%d" : "%d,%d", fila, columna);
+        }
+    }
+    fputc('\n', flujo);
+    return 1;
+}
+
+static int ejecutar_resolver(const opciones_cli* op) {
+    FILE* flujo = abrir_salida(op);
+    if (flujo == NULL) return SALIDA_CLI_ERROR;
+
+    if (op->encabezado) {
+        fprintf(flujo, op->con_camino ? "nombre\talgoritmo\tpasos\tcamino\n"
+                                      : "nombre\talgoritmo\tpasos\n");
+    }
+    int codigo = recorrer_entradas(op, accion_resolver, flujo);
+    if (!cerrar_salida(flujo)) codigo = SALIDA_CLI_ERROR;
+    return codigo;
+}
+
+/*
+ * accion_estadisticas
+ * Una línea TSV por laberinto; la solución se recalcula.
+ */
+static int accion_estadisticas(laberinto* lab, const opciones_cli* op, void* contexto) {
+    FILE* flujo = (FILE*)contexto;
+    int paredes = 0, total = lab->filas * lab->columnas;
+    (void)op;
+
+    for (int i = 0; i < lab->filas; i++) {
+        for (int j = 0; j < lab->columnas; j++) {
+            if (lab->celdas[i][j] == PARED) paredes++;
+        }
+    }
+    calcular_solucion(lab);
+
+    fprintf(flujo, "%s\t%d\t%d\t%d\t%d\t%.1f\t%d\t%d\n", lab->nombre, lab->filas,
+            lab->columnas, paredes, total - paredes, 100.0 * (total - paredes) / total,
+            lab->tiene_solucion, lab->pasos_solucion);
+    return 1;
+}
+
+static int ejecutar_estadisticas(const opciones_cli* op) {
+    FILE* flujo = abrir_salida(op);
+    if (flujo == NULL) return SALIDA_CLI_ERROR;
+
+    if (op->encabezado) {
+        fprintf(flujo, "nombre\tfilas\tcolumnas\tparedes\tcaminos\tpct_caminos\t"
+                       "tiene_solucion\tpasos_solucion\n");
+    }
+    int codigo = recorrer_entradas(op, accion_estadisticas, flujo);
+    if (!cerrar_salida(flujo)) codigo = SALIDA_CLI_ERROR;
+    return codigo;
+}
+
+/*
+ * accion_exportar
+ * Escribe <nombre>.<formato> en DIRECTORIO_LABERINTOS.
+ * El exportador informa cada archivo creado en stdout.
+ */
+static int accion_exportar(laberinto* lab, const opciones_cli* op, void* contexto) {
+    int formato = *(const int*)contexto;   // 0 svg, 1 svgz o FORMATO_*
+    int longitud = 0;
+    int* camino = op->con_camino ? resolver_laberinto(lab, op->algoritmo, &longitud) : NULL;
+
+    if (formato <= 1) {
+        return exportar_laberinto_svg_completo(lab, lab->nombre, camino, longitud, formato);
+    }
+
+    opciones_imagen opciones;
+    inicializar_opciones_imagen(&opciones);
+    opciones.formato = formato == 2 ? FORMATO_PBM : formato == 3 ? FORMATO_PGM : FORMATO_PNG;
+    opciones.pixeles_por_celda = op->pixeles_por_celda;
+    opciones.camino = camino;
+    opciones.longitud = longitud;
+    return exportar_laberinto_imagen(lab, lab->nombre, &opciones);
+}
+
+static int ejecutar_exportar(const opciones_cli* op) {
+    static const char* formatos[] = {"svg", "svgz", "pbm", "pgm", "png"};
+    const char* pedido = op->formato ? op->formato : "svg";
+    int formato;
+
+    for (formato = 0; formato < 5; formato++) {
+        if (strcmp(pedido, formatos[formato]) == 0) break;
+    }
+    if (formato == 5) {
+        fprintf(stderr, "Error: formato de exportación desconocido: %s\n", pedido);
+        return SALIDA_CLI_USO;
+    }
+
+    crear_directorio_laberintos();
+    int codigo = recorrer_entradas(op, accion_exportar, &formato);
+    fflush(stdout);
+    return codigo;
+}
+
+/*
+ * lote_paquete - Laberintos acumulados antes de reescribir el índice
+ */
+typedef struct {
+    const char* ruta;                   // Paquete destino
+    laberinto* labs[LOTE_PAQUETE];      // Copias pendientes
+    int cantidad;                       // Copias en labs
+    int errores;                        // Lotes que fallaron
+} lote_paquete;
+
+static void vaciar_lote(lote_paquete* lote) {
+    if (lote->cantidad > 0 &&
+        !agregar_laberintos_a_paquete(lote->ruta, lote->labs, lote->cantidad)) {
+        lote->errores++;
+    }
+    for (int k = 0; k < lote->cantidad; k++) {
+        destruir_laberinto(lote->labs[k]);
+    }
+    lote->cantidad = 0;
+}
+
+static int accion_empaquetar(laberinto* lab, const opciones_cli* op, void* contexto) {
+    lote_paquete* lote = (lote_paquete*)contexto;
+    (void)op;
+
+    laberinto* copia = (laberinto*)reservar_memoria(MEM_LABERINTO, sizeof(laberinto));
+    if (copia == NULL) return 0;
+    memcpy(copia, lab, sizeof(laberinto));
+    lote->labs[lote->cantidad++] = copia;
+    if (lote->cantidad == LOTE_PAQUETE) vaciar_lote(lote);
+    return 1;
+}
+
+static int accion_texto(laberinto* lab, const opciones_cli* op, void* contexto) {
+    (void)op;
+    return escribir_laberinto_texto((FILE*)contexto, lab);
+}
+
+/*
+ * ejecutar_convertir
+ * --formato texto: escribe las entradas (texto o paquete) como texto.
+ * --formato paquete: agrega las entradas al paquete de --salida.
+ */
+static int ejecutar_convertir(const opciones_cli* op) {
+    const char* formato = op->formato ? op->formato : "texto";
+
+    if (strcmp(formato, "texto") == 0) {
+        FILE* flujo = abrir_salida(op);
+        if (flujo == NULL) return SALIDA_CLI_ERROR;
+        int codigo = recorrer_entradas(op, accion_texto, flujo);
+        if (!cerrar_salida(flujo)) codigo = SALIDA_CLI_ERROR;
+        return codigo;
+    }
+
+    if (strcmp(formato, "paquete") == 0) {
+        lote_paquete* lote = (lote_paquete*)reservar_memoria_cero(MEM_PAQUETES, 1,
+                                                                  sizeof(lote_paquete));
+        if (lote == NULL) return SALIDA_CLI_ERROR;
+        if (op->salida == NULL) crear_directorio_laberintos();
+        lote->ruta = op->salida ? op->salida : ARCHIVO_PAQUETE;
+
+        int codigo = recorrer_entradas(op, accion_empaquetar, lote);
+        vaciar_lote(lote);
+        if (lote->errores) codigo = SALIDA_CLI_ERROR;
+        liberar_memoria(lote);
+        fflush(stdout);
+        return codigo;
+    }
+
+    fprintf(stderr, "Error: formato de conversión desconocido: %s\n", formato);
+    return SALIDA_CLI_USO;
+}
+
+/*
+ * cargar_laberinto_cli
+ * Primer laberinto de un archivo de texto, o la entrada --nombre
+ * (por defecto la primera) de un paquete.
+ */
+static int cargar_laberinto_cli(const char* ruta, const char* nombre, laberinto* lab) {
+    const char* error = "archivo vacío";
+
+    if (es_paquete(ruta)) {
+        paquete* paq = abrir_paquete(ruta);
+        const entrada_paquete* entrada = NULL;
+        if (paq != NULL) {
+            entrada = nombre ? buscar_en_paquete(paq, nombre)
+                             : (paq->cabecera->num_entradas ? &paq->indice[0] : NULL);
+        }
+        laberinto* cargado = entrada ? cargar_de_paquete(paq, entrada) : NULL;
+        if (paq != NULL) cerrar_paquete(paq);
+        if (cargado == NULL) {
+            fprintf(stderr, "%s: laberinto no encontrado en el paquete\n", ruta);
+            return 0;
+        }
+        memcpy(lab, cargado, sizeof(laberinto));
+        destruir_laberinto(cargado);
+        return 1;
+    }
+
+    lector_laberintos lector;
+    memset(&lector, 0, sizeof(lector));
+    lector.inicio_de_linea = 1;
+    lector.archivo = (strcmp(ruta, "-") == 0) ? stdin : fopen(ruta, "r");
+    if (lector.archivo == NULL) {
+        fprintf(stderr, "%s: no se pudo abrir\n", ruta);
+        return 0;
+    }
+    int ok = leer_registro(&lector) > 0 &&
+             parsear_laberinto_texto(lector.registro, lector.usados, lab, &error);
+    if (!ok) fprintf(stderr, "%s: %s\n", ruta, error);
+    liberar_memoria(lector.registro);
+    if (lector.archivo != stdin) fclose(lector.archivo);
+    return ok;
+}
+
+/*
+ * leer_consultas_rutas
+ * Una consulta por línea: "f1 c1 f2 c2". Se ignoran líneas vacías y
+ * comentarios (#). Retorna la cantidad leída o -1 ante un error.
+ */
+static int leer_consultas_rutas(FILE* archivo, const char* ruta, laberinto* lab,
+                                consulta_ruta** consultas) {
+    char linea[MAX_LINEA];
+    int cantidad = 0, capacidad = 0, numero_linea = 0;
+
+    *consultas = NULL;
+    while (fgets(linea, sizeof(linea), archivo) != NULL) {
+        long v[4];
+        char* p = linea;
+        int k;
+
+        numero_linea++;
+        while (*p == ' ' || *p == '\t') p++;
+        if (*p == '\n' || *p == '\r' || *p == '\0' || *p == '#') continue;
+
+        for (k = 0; k < 4; k++) {
+            char* fin;
+            v[k] = strtol(p, &fin, 10);
+            if (fin == p) break;
+            p = fin;
+        }
+        while (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n') p++;
+        if (k < 4 || *p != '\0' || v[0] < 0 || v[0] >= lab->filas || v[1] < 0 ||
+            v[1] >= lab->columnas || v[2] < 0 || v[2] >= lab->filas || v[3] < 0 ||
+            v[3] >= lab->columnas) {
+            fprintf(stderr, "%s:%d: se espera \"f1 c1 f2 c2\" dentro del laberinto\n",
+                    ruta, numero_linea);
+            liberar_memoria(*consultas);
+            *consultas = NULL;
+            return -1;
+        }
+
+        if (cantidad == capacidad) {
+            capacidad = capacidad ? capacidad * 2 : 1024;
+            consulta_ruta* mayor = (consulta_ruta*)redimensionar_memoria(MEM_ALGORITMOS,
+                *consultas, (size_t)capacidad * sizeof(consulta_ruta));
+            if (mayor == NULL) {
+                fprintf(stderr, "%s: sin memoria\n", ruta);
+                liberar_memoria(*consultas);
+                *consultas = NULL;
+                return -1;
+            }
+            *consultas = mayor;
+        }
+        consulta_ruta* c = &(*consultas)[cantidad++];
+        c->origen = (int)(v[0] * COLUMNAS + v[1]);
+        c->destino = (int)(v[2] * COLUMNAS + v[3]);
+        c->pasos = -1;
+        c->camino = NULL;
+    }
+
+    return cantidad;
+}
+
+/*
+ * ejecutar_rutas
+ * rutas LABERINTO [CONSULTAS]: carga el laberinto una vez y responde
+ * todas las consultas en orden de entrada, resueltas por lotes.
+ */
+static int ejecutar_rutas(const opciones_cli* op) {
+    const char* ruta_consultas = op->num_entradas > 1 ? op->entradas[1] : "-";
+    consulta_ruta* consultas;
+    resumen_lote resumen;
+
+    if (op->num_entradas > 2 || strcmp(op->entradas[0], "-") == 0) {
+        fprintf(stderr, "Uso: rutas LABERINTO [CONSULTAS|-]\n");
+        return SALIDA_CLI_USO;
+    }
+    if (strcmp(op->motor, "cola") == 0 || strcmp(op->motor, "bits") == 0) {
+        fprintf(stderr, "Error: el motor de rutas es auto, bfs, lca, hpa o alt\n");
+        return SALIDA_CLI_USO;
+    }
+
+    laberinto* lab = (laberinto*)reservar_memoria(MEM_LABERINTO, sizeof(laberinto));
+    if (lab == NULL || !cargar_laberinto_cli(op->entradas[0], op->nombre, lab)) {
+        liberar_memoria(lab);
+        return SALIDA_CLI_ERROR;
+    }
+
+    FILE* archivo = strcmp(ruta_consultas, "-") == 0 ? stdin : fopen(ruta_consultas, "r");
+    if (archivo == NULL) {
+        fprintf(stderr, "%s: no se pudo abrir\n", ruta_consultas);
+        liberar_memoria(lab);
+        return SALIDA_CLI_ERROR;
+    }
+    int cantidad = leer_consultas_rutas(archivo, ruta_consultas, lab, &consultas);
+    if (archivo != stdin) fclose(archivo);
+    if (cantidad < 0) {
+        liberar_memoria(lab);
+        return SALIDA_CLI_ERROR;
+    }
+
+    // Con pocos ciclos el índice LCA responde sin buscar; si no, lotes BFS
+    // (o el índice por bloques o la tabla de hitos si se pide hpa o alt)
+    uint64_t t0 = reloj_ns();
+    arbol_lca* arbol = NULL;
+    indice_jerarquico* indice = NULL;
+    const tabla_hitos* hitos = NULL;
+    if (strcmp(op->motor, "hpa") == 0) {
+        indice = construir_indice_jerarquico(lab, TAM_BLOQUE_JERARQUICO);
+    } else if (strcmp(op->motor, "alt") == 0) {
+        hitos = hitos_en_cache(lab);
+    } else if (strcmp(op->motor, "bfs") != 0) {
+        const char* error = NULL;
+        arbol = construir_arbol_lca(lab, &error);
+        if (arbol == NULL && strcmp(op->motor, "lca") == 0) {
+            fprintf(stderr, "%s: %s\n", op->entradas[0], error);
+            liberar_memoria(consultas);
+            liberar_memoria(lab);
+            return SALIDA_CLI_ERROR;
+        }
+    }
+    int ok;
+    if (arbol != NULL) {
+        ok = resolver_lote_lca(arbol, consultas, cantidad, op->con_camino, &resumen);
+    } else if (indice != NULL) {
+        ok = resolver_lote_jerarquico(indice, consultas, cantidad, op->con_camino, &resumen);
+    } else if (hitos != NULL) {
+        ok = resolver_lote_hitos(lab, hitos, consultas, cantidad, op->con_camino, &resumen);
+    } else if (strcmp(op->motor, "hpa") == 0 || strcmp(op->motor, "alt") == 0) {
+        memset(&resumen, 0, sizeof(resumen));
+        ok = 0;
+    } else {
+        ok = resolver_lote_consultas(lab, consultas, cantidad, op->hilos,
+                                     op->con_camino, &resumen);
+    }
+    double ms = (reloj_ns() - t0) / 1e6;
+
+    FILE* flujo = ok ? abrir_salida(op) : NULL;
+    if (flujo != NULL) {
+        if (op->encabezado) {
+            fprintf(flujo, op->con_camino ? "origen\tdestino\tpasos\tcamino\n"
+                                          : "origen\tdestino\tpasos\n");
+        }
+        for (int k = 0; k < cantidad; k++) {
+            consulta_ruta* c = &consultas[k];
+            fprintf(flujo, "%d,%d\t%d,%d\t%d", c->origen / COLUMNAS, c->origen % COLUMNAS,
+                    c->destino / COLUMNAS, c->destino % COLUMNAS, c->pasos);
+            if (op->con_camino) {
+                fputc('\t', flujo);
+                for (int i = 0; c->camino != NULL && i <= c->pasos; i++) {
+                    fprintf(flujo, i ? " %d,%d" : "%d,%d", c->camino[i] / COLUMNAS,
+                            c->camino[i] % COLUMNAS);
+                }
+            }
+            fputc('\n', flujo);
+        }
+        ok = cerrar_salida(flujo);
+    } else if (!ok) {
+        fprintf(stderr, "Error: sin memoria para resolver el lote\n");
+    }
+
+    if (op->con_resumen) {
+        if (arbol != NULL) {
+            fprintf(stderr, "%d consultas, índice LCA con %d portales: ", cantidad,
+                    arbol->num_portales);
+        } else if (indice != NULL) {
+            fprintf(stderr, "%d consultas, índice de %d entradas en bloques de %d, "
+                    "%lld entradas expandidas: ", cantidad, indice->num_entradas,
+                    indice->tam_bloque, resumen.visitados);
+        } else if (hitos != NULL) {
+            fprintf(stderr, "%d consultas, %d hitos, %lld nodos expandidos: ", cantidad,
+                    hitos->num_hitos, resumen.visitados);
+        } else {
+            fprintf(stderr, "%d consultas, %d orígenes, %d hilos, %lld nodos visitados: ",
+                    cantidad, resumen.grupos, resumen.hilos, resumen.visitados);
+        }
+        fprintf(stderr, "%.2f ms (%.0f consultas/s)\n", ms,
+                ms > 0 ? cantidad / (ms / 1000.0) : 0.0);
+    }
+
+    destruir_arbol_lca(arbol);
+    destruir_indice_jerarquico(indice);
+    liberar_memoria(resumen.nodos_caminos);
+    liberar_memoria(consultas);
+    liberar_memoria(lab);
+    return ok ? SALIDA_CLI_OK : SALIDA_CLI_ERROR;
+}
+
+/*
+ * obtener_arbol_sucinto
+ * Carga un archivo .suc, arma el árbol de un laberinto perfecto o lo
+ * genera con el tamaño en celdas dado por dos números.
+ */
+static arbol_sucinto* obtener_arbol_sucinto(const opciones_cli* op) {
+    long filas, columnas;
+
+    if (op->num_entradas == 2 && leer_numero(op->entradas[0], 3, INT_MAX, &filas) &&
+        leer_numero(op->entradas[1], 3, INT_MAX, &columnas)) {
+        arbol_sucinto* arbol = crear_arbol_sucinto((int)((filas - 1) / 2), (int)((columnas - 1) / 2));
+        if (arbol == NULL || !generar_arbol_sucinto(arbol)) {
+            fprintf(stderr, "Error: sin memoria para %ldx%ld celdas\n", filas, columnas);
+            destruir_arbol_sucinto(arbol);
+            return NULL;
+        }
+        snprintf(arbol->nombre, MAX_NOMBRE, "%s", op->nombre ? op->nombre : "sucinto");
+        return arbol;
+    }
+    if (op->num_entradas != 1) {
+        fprintf(stderr, "Uso: sucinto [LABERINTO | ARCHIVO.suc | FILAS COLUMNAS]\n");
+        return NULL;
+    }
+
+    const char* ruta = op->entradas[0];
+    if (strcmp(ruta, "-") != 0 && es_archivo_sucinto(ruta)) {
+        arbol_sucinto* arbol = cargar_arbol_sucinto(ruta);
+        if (arbol == NULL) fprintf(stderr, "%s: archivo sucinto inválido\n", ruta);
+        return arbol;
+    }
+
+    laberinto* lab = (laberinto*)reservar_memoria(MEM_LABERINTO, sizeof(laberinto));
+    arbol_sucinto* arbol = NULL;
+    if (lab != NULL && cargar_laberinto_cli(ruta, op->nombre, lab)) {
+        const char* error = NULL;
+        arbol = celdas_a_sucinto(lab, &error);
+        if (arbol == NULL) fprintf(stderr, "%s: %s: %s\n", ruta, lab->nombre, error);
+    }
+    liberar_memoria(lab);
+    return arbol;
+}
+
+/*
+ * ejecutar_sucinto
+ * Árbol sucinto de un laberinto perfecto (ver obtener_arbol_sucinto).
+ * Sin --formato escribe una línea TSV con tamaño, bytes y pasos; con
+ * --formato sucinto lo guarda en --salida y con texto lo expande a celdas.
+ */
+static int ejecutar_sucinto(const opciones_cli* op) {
+    const char* formato = op->formato ? op->formato : "tsv";
+
+    if (strcmp(formato, "tsv") != 0 && strcmp(formato, "texto") != 0 &&
+        strcmp(formato, "sucinto") != 0) {
+        fprintf(stderr, "Error: --formato debe ser texto o sucinto\n");
+        return SALIDA_CLI_USO;
+    }
+    if (strcmp(formato, "sucinto") == 0 && (op->salida == NULL || strcmp(op->salida, "-") == 0)) {
+        fprintf(stderr, "Error: --formato sucinto necesita --salida ARCHIVO\n");
+        return SALIDA_CLI_USO;
+    }
+
+    uint64_t t0 = reloj_ns();
+    arbol_sucinto* arbol = obtener_arbol_sucinto(op);
+    if (arbol == NULL) return SALIDA_CLI_ERROR;
+    uint64_t t1 = reloj_ns();
+    long pasos = pasos_sucinto(arbol);
+    uint64_t t2 = reloj_ns();
+    int ok = 1;
+
+    if (strcmp(formato, "sucinto") == 0) {
+        ok = guardar_arbol_sucinto(arbol, op->salida);
+        if (!ok) fprintf(stderr, "Error: no se pudo escribir %s\n", op->salida);
+    } else if (strcmp(formato, "texto") == 0) {
+        laberinto* lab = (laberinto*)reservar_memoria(MEM_LABERINTO, sizeof(laberinto));
+        FILE* flujo = NULL;
+        ok = lab != NULL && sucinto_a_celdas(arbol, lab);
+        if (!ok) {
+            fprintf(stderr, "Error: %dx%d celdas no entran en %dx%d; recompile con "
+                    "-DFILAS/-DCOLUMNAS\n", 2 * arbol->filas + 1, 2 * arbol->columnas + 1,
+                    FILAS, COLUMNAS);
+        } else if ((flujo = abrir_salida(op)) == NULL) {
+            ok = 0;
+        } else {
+            escribir_laberinto_texto(flujo, lab);
+            ok = cerrar_salida(flujo);
+        }
+        liberar_memoria(lab);
+    } else {
+        FILE* flujo = abrir_salida(op);
+        ok = (flujo != NULL);
+        if (ok) {
+            if (op->encabezado) fprintf(flujo, "nombre\tfilas\tcolumnas\thabitaciones\tbytes\tpasos\n");
+            fprintf(flujo, "%s\t%d\t%d\t%lld\t%zu\t%ld\n", arbol->nombre,
+                    2 * arbol->filas + 1, 2 * arbol->columnas + 1,
+                    (long long)arbol->filas * arbol->columnas, bytes_arbol_sucinto(arbol), pasos);
+            ok = cerrar_salida(flujo);
+        }
+    }
+
+    if (op->con_resumen) {
+        double celdas = (2.0 * arbol->filas + 1) * (2.0 * arbol->columnas + 1);
+        fprintf(stderr, "%.0f celdas en %zu bytes (%.3f bits por celda): armado %.2f ms, "
+                "pasos %.2f ms\n", celdas, bytes_arbol_sucinto(arbol),
+                8.0 * bytes_arbol_sucinto(arbol) / celdas, (t1 - t0) / 1e6, (t2 - t1) / 1e6);
+    }
+
+    destruir_arbol_sucinto(arbol);
+    return ok ? SALIDA_CLI_OK : SALIDA_CLI_ERROR;
+}
+
+/*
+ * relleno_cli - Salida y totales de podar
+ */
+typedef struct {
+    FILE* flujo;                // Laberintos podados en texto
+    int motor;                  // RELLENO_*
+    int laberintos;             // Laberintos procesados
+    long long abiertas;         // Celdas transitables antes de podar
+    long long tapiadas;         // Celdas tapiadas en total
+} relleno_cli;
+
+static int accion_podar(laberinto* lab, const opciones_cli* op, void* contexto) {
+    relleno_cli* relleno = (relleno_cli*)contexto;
+    (void)op;
+
+    relleno->abiertas += contar_caminos_posibles(lab);
+    int tapiadas = rellenar_callejones(lab, relleno->motor);
+    if (tapiadas < 0) {
+        fprintf(stderr, "%s: sin memoria para el relleno\n", lab->nombre);
+        return 0;
+    }
+    relleno->tapiadas += tapiadas;
+    relleno->laberintos++;
+    return escribir_laberinto_texto(relleno->flujo, lab);
+}
+
+/*
+ * ejecutar_podar
+ * Escribe cada laberinto sin callejones sin salida (--motor cola|bits);
+ * la solución no cambia y el resto de los subcomandos recorre menos
+ * celdas. --resumen informa en stderr las celdas tapiadas.
+ */
+static int ejecutar_podar(const opciones_cli* op) {
+    relleno_cli relleno = {NULL, RELLENO_COLA, 0, 0, 0};
+
+    if (strcmp(op->motor, "bits") == 0) {
+        relleno.motor = RELLENO_BITS;
+    } else if (strcmp(op->motor, "auto") != 0 && strcmp(op->motor, "cola") != 0) {
+        fprintf(stderr, "Error: el motor de podar es cola o bits\n");
+        return SALIDA_CLI_USO;
+    }
+
+    relleno.flujo = abrir_salida(op);
+    if (relleno.flujo == NULL) return SALIDA_CLI_ERROR;
+
+    uint64_t t0 = reloj_ns();
+    int codigo = recorrer_entradas(op, accion_podar, &relleno);
+    uint64_t t1 = reloj_ns();
+    if (!cerrar_salida(relleno.flujo)) codigo = SALIDA_CLI_ERROR;
+
+    if (op->con_resumen) {
+        fprintf(stderr, "%d laberintos: %lld de %lld celdas abiertas tapiadas (%.1f%%) "
+                "con el motor %s en %.2f ms\n", relleno.laberintos, relleno.tapiadas,
+                relleno.abiertas, relleno.abiertas ? 100.0 * relleno.tapiadas / relleno.abiertas : 0.0,
+                relleno.motor == RELLENO_BITS ? "bits" : "cola", (t1 - t0) / 1e6);
+    }
+    return codigo;
+}
+
+/*
+ * ejecutar_servir
+ * Servidor de consultas con caché (ver servidor.c).
+ */
+static int ejecutar_servir(const opciones_cli* op) {
+    if (strcmp(op->socket, SOCKET_SERVIDOR) == 0) crear_directorio_laberintos();
+    return ejecutar_servidor(op->socket, op->capacidad) ? SALIDA_CLI_ERROR : SALIDA_CLI_OK;
+}
+
+/*
+ * ejecutar_consultar
+ * Sin argumentos manda las líneas de stdin; si no, una sola consulta
+ * formada por los argumentos (p. ej. consultar RESOLVER nombre).
+ */
+static int ejecutar_consultar(const opciones_cli* op) {
+    if (op->num_entradas == 1 && strcmp(op->entradas[0], "-") == 0) {
+        return consultar_servidor(op->socket, stdin, stdout) ? SALIDA_CLI_ERROR : SALIDA_CLI_OK;
+    }
+
+    char linea[BUFFER_CLIENTE] = "";
+    for (int i = 0; i < op->num_entradas; i++) {
+        if (i > 0) strncat(linea, " ", sizeof(linea) - strlen(linea) - 1);
+        strncat(linea, op->entradas[i], sizeof(linea) - strlen(linea) - 1);
+    }
+    FILE* consulta = fmemopen(linea, strlen(linea), "r");
+    if (consulta == NULL) return SALIDA_CLI_ERROR;
+    int codigo = consultar_servidor(op->socket, consulta, stdout);
+    fclose(consulta);
+    return codigo ? SALIDA_CLI_ERROR : SALIDA_CLI_OK;
+}
+
+// ==================== PUNTO DE ENTRADA ====================
+
+/* subcomando_cli - Nombre en español, alias en inglés y función */
+static const struct {
+    const char* nombre;
+    const char* alias;
+    int (*ejecutar)(const opciones_cli* op);
+    const char* descripcion;
+} subcomandos[] = {
+    {"generar", "generate", ejecutar_generar,
+     "Genera laberintos (--tipo, --cantidad, --semilla, --nombre)"},
+    {"resolver", "solve", ejecutar_resolver,
+     "Resuelve cada laberinto (--algoritmo dijkstra|bfs|astar|contraido|hpa|alt, --hitos, --camino)"},
+    {"estadisticas", "stats", ejecutar_estadisticas,
+     "Una línea TSV de estadísticas por laberinto"},
+    {"exportar", "export", ejecutar_exportar,
+     "Exporta a " DIRECTORIO_LABERINTOS " (--formato svg|svgz|pbm|pgm|png, --ppc, --camino)"},
+    {"convertir", "convert", ejecutar_convertir,
+     "Convierte entre texto y paquete (--formato texto|paquete, --salida)"},
+    {"rutas", "routes", ejecutar_rutas,
+     "Lote de consultas \"f1 c1 f2 c2\" sobre un laberinto (--motor, --hilos, --hitos, --camino, --resumen)"},
+    {"sucinto", "succinct", ejecutar_sucinto,
+     "Árbol de 2 bits por habitación de un laberinto perfecto (--formato texto|sucinto)"},
+    {"podar", "prune", ejecutar_podar,
+     "Tapia los callejones sin salida de cada laberinto (--motor cola|bits, --resumen)"},
+    {"servir", "serve", ejecutar_servir,
+     "Servidor con caché en un socket Unix (--socket, --capacidad)"},
+    {"consultar", "query", ejecutar_consultar,
+     "Envía consultas al servidor (argumentos o una por línea de stdin)"},
+};
+
+#define NUM_SUBCOMANDOS ((int)(sizeof(subcomandos) / sizeof(subcomandos[0])))
+
+/*
+ * mostrar_ayuda_cli
+ * Uso resumido; va a stderr para no mezclarse con los datos.
+ */
+void mostrar_ayuda_cli(const char* programa) {
+    fprintf(stderr, "Uso: %s <subcomando> [opciones] [archivo|paquete|-]...\n\n", programa);
+    fprintf(stderr, "Sin argumentos abre el menú interactivo.\n\nSubcomandos:\n");
+    for (int k = 0; k < NUM_SUBCOMANDOS; k++) {
+        fprintf(stderr, "  %-13s (%s) %s\n", subcomandos[k].nombre, subcomandos[k].alias,
+                subcomandos[k].descripcion);
+    }
+    fprintf(stderr, "\nOpciones comunes:\n"
+            "  -o, --salida RUTA     Archivo de salida (por defecto stdout)\n"
+            "  -s, --semilla N       Semilla fija: misma semilla, mismos laberintos\n"
+            "  --filas N --columnas M  Deben coincidir con el tamaño compilado (%dx%d)\n"
+            "  --sin-encabezado      Omite la línea de encabezado TSV\n\n"
+            "Las entradas son texto (varios laberintos seguidos) o paquetes .paq;\n"
+            "sin archivos se lee stdin.\n", FILAS, COLUMNAS);
+}
+
+/*
+ * ejecutar_cli
+ * Despacha el subcomando de argv[1] y retorna el código de salida.
+ */
+int ejecutar_cli(int argc, char* argv[]) {
+    opciones_cli op;
+
+    if (strcmp(argv[1], "--ayuda") == 0 || strcmp(argv[1], "-h") == 0 ||
+        strcmp(argv[1], "--help") == 0) {
+        mostrar_ayuda_cli(argv[0]);
+        return SALIDA_CLI_OK;
+    }
+
+    for (int k = 0; k < NUM_SUBCOMANDOS; k++) {
+        if (strcmp(argv[1], subcomandos[k].nombre) != 0 &&
+            strcmp(argv[1], subcomandos[k].alias) != 0) {
+            continue;
+        }
+        if (!parsear_opciones(argc, argv, &op)) return SALIDA_CLI_USO;
+
+        // Una sola siembra: sin --semilla cada proceso usa otra secuencia
+        fijar_semilla(op.tiene_semilla ? op.semilla
+                                       : (unsigned int)time(NULL) ^ ((unsigned int)getpid() << 16));
+        fijar_hitos_alt(op.hitos);
+        return subcomandos[k].ejecutar(&op);
+    }
+
+    fprintf(stderr, "Error: subcomando desconocido: %s\n", argv[1]);
+    mostrar_ayuda_cli(argv[0]);
+    return SALIDA_CLI_USO;
+}
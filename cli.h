@@ -0,0 +1,22 @@
+/*
+ * cli.h
+ * Interfaz de línea de comandos sin menús, pensada para scripts.
+ * Subcomandos generar, resolver, estadisticas, exportar y convertir.
+ */
+
+#ifndef CLI_H
+#define CLI_H
+
+// Códigos de salida
+#define SALIDA_CLI_OK 0        // Todo correcto
+#define SALIDA_CLI_ERROR 1     // Falló algún laberinto o archivo
+#define SALIDA_CLI_USO 2       // Argumentos inválidos
+
+// ============================================================================
+// PROTOTIPOS DE FUNCIONES
+// ============================================================================
+
+int ejecutar_cli(int argc, char* argv[]);
+void mostrar_ayuda_cli(const char* programa);
+
+#endif // CLI_H
@@ -0,0 +1,410 @@
+/*
+ * compacto.c
+ * Laberintos con paredes delgadas (4 bits por habitación).
+ * Convierte sin pérdida desde y hacia el formato de bloques.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <string.h>
+#include "compacto.h"
+#include "contadores.h"
+#include "distancias.h"
+
+// Desplazamientos por dirección: norte, sur, este, oeste
+static const int desplazamientos[4][2] = {{-1, 0}, {1, 0}, {0, 1}, {0, -1}};
+static const unsigned char bits_pared[4] = {PARED_NORTE, PARED_SUR, PARED_ESTE, PARED_OESTE};
+static const int direccion_opuesta[4] = {DIR_SUR, DIR_NORTE, DIR_OESTE, DIR_ESTE};
+
+// ==================== INICIALIZACIÓN Y PAREDES ====================
+
+/*
+ * inicializar_compacto
+ * Cierra todas las paredes de todas las habitaciones.
+ * INICIO y FINAL quedan sin asignar (-1).
+ */
+void inicializar_compacto(laberinto_compacto* lc) {
+    lc->filas = FILAS_COMPACTO;         // Habitaciones por columna
+    lc->columnas = COLUMNAS_COMPACTO;   // Habitaciones por fila
+    lc->fila_inicio = -1;               // Sin entrada
+    lc->columna_inicio = -1;
+    lc->fila_final = -1;                // Sin salida
+    lc->columna_final = -1;
+
+    memset(lc->paredes, TODAS_LAS_PAREDES, sizeof(lc->paredes));  // Todo cerrado
+}
+
+/*
+ * abrir_pared_compacto
+ * Quita la pared de una habitación en la dirección dada.
+ * También quita la pared opuesta de la habitación vecina.
+ */
+void abrir_pared_compacto(laberinto_compacto* lc, int fila, int columna, int direccion) {
+    lc->paredes[fila][columna] &= ~bits_pared[direccion];  // Abre este lado
+
+    int nf = fila + desplazamientos[direccion][0];     // Fila vecina
+    int nc = columna + desplazamientos[direccion][1];  // Columna vecina
+
+    // Si hay vecina (no es el borde), abre su lado opuesto
+    if (nf >= 0 && nf < lc->filas && nc >= 0 && nc < lc->columnas) {
+        lc->paredes[nf][nc] &= ~bits_pared[direccion_opuesta[direccion]];
+    }
+}
+
+/*
+ * hay_pared_compacto
+ * Indica si la habitación tiene pared en la dirección dada.
+ * Retorna 1 si hay pared, 0 si está abierta.
+ */
+int hay_pared_compacto(laberinto_compacto* lc, int fila, int columna, int direccion) {
+    return (lc->paredes[fila][columna] & bits_pared[direccion]) != 0;
+}
+
+// ==================== CONVERSIÓN ====================
+
+/*
+ * celdas_a_compacto
+ * Convierte el formato de bloques a paredes delgadas.
+ * Retorna 0 si el laberinto no sigue el formato de bloques.
+ */
+int celdas_a_compacto(laberinto* lab, laberinto_compacto* lc) {
+    inicializar_compacto(lc);  // Empieza con todo cerrado
+
+    int limite_filas = 2 * lc->filas;        // Última fila del bloque
+    int limite_columnas = 2 * lc->columnas;  // Última columna del bloque
+
+    for (int i = 0; i < FILAS; i++) {
+        for (int j = 0; j < COLUMNAS; j++) {
+            int valor = lab->celdas[i][j];  // Valor de la celda
+
+            // Registra entrada y salida en coordenadas de celdas
+            if (valor == INICIO) {
+                lc->fila_inicio = i;
+                lc->columna_inicio = j;
+            } else if (valor == FINAL) {
+                lc->fila_final = i;
+                lc->columna_final = j;
+            } else if (valor != PARED && valor != CAMINO) {
+                return 0;  // Marcas temporales no se representan
+            }
+
+            int abierta = (valor != PARED);  // Celda transitable
+
+            // Fuera del bloque solo se admiten paredes, INICIO o FINAL
+            if (i > limite_filas || j > limite_columnas) {
+                if (valor == CAMINO) return 0;
+                continue;
+            }
+
+            if (i % 2 == 1 && j % 2 == 1) {
+                if (!abierta) return 0;  // Habitación cerrada: no representable
+            } else if (i % 2 == 0 && j % 2 == 0) {
+                if (valor == CAMINO) return 0;  // Esquina abierta: no representable
+            } else if (abierta) {
+                // Pared entre habitaciones (o de borde) abierta
+                if (i % 2 == 0) {
+                    int columna = (j - 1) / 2;
+                    if (i / 2 < lc->filas) {
+                        abrir_pared_compacto(lc, i / 2, columna, DIR_NORTE);
+                    } else {
+                        abrir_pared_compacto(lc, i / 2 - 1, columna, DIR_SUR);
+                    }
+                } else {
+                    int fila = (i - 1) / 2;
+                    if (j / 2 < lc->columnas) {
+                        abrir_pared_compacto(lc, fila, j / 2, DIR_OESTE);
+                    } else {
+                        abrir_pared_compacto(lc, fila, j / 2 - 1, DIR_ESTE);
+                    }
+                }
+            }
+        }
+    }
+
+    return 1;  // Conversión exacta
+}
+
+/*
+ * compacto_a_celdas
+ * Expande las paredes delgadas al formato de bloques.
+ * Sobrescribe todas las celdas del laberinto destino.
+ */
+void compacto_a_celdas(laberinto_compacto* lc, laberinto* lab) {
+    invalidar_campo_distancias(lab);
+
+    // Todo pared por defecto
+    for (int i = 0; i < FILAS; i++) {
+        for (int j = 0; j < COLUMNAS; j++) {
+            lab->celdas[i][j] = PARED;
+        }
+    }
+
+    for (int f = 0; f < lc->filas; f++) {
+        for (int c = 0; c < lc->columnas; c++) {
+            int fila = 2 * f + 1;      // Fila de la habitación
+            int columna = 2 * c + 1;   // Columna de la habitación
+            unsigned char p = lc->paredes[f][c];
+
+            lab->celdas[fila][columna] = CAMINO;  // Habitación
+
+            // Este y sur cubren todas las paredes interiores
+            if (!(p & PARED_ESTE)) lab->celdas[fila][columna + 1] = CAMINO;
+            if (!(p & PARED_SUR)) lab->celdas[fila + 1][columna] = CAMINO;
+
+            // Norte y oeste solo hacen falta en el borde
+            if (f == 0 && !(p & PARED_NORTE)) lab->celdas[fila - 1][columna] = CAMINO;
+            if (c == 0 && !(p & PARED_OESTE)) lab->celdas[fila][columna - 1] = CAMINO;
+        }
+    }
+
+    // Restaura entrada y salida
+    if (lc->fila_inicio >= 0) lab->celdas[lc->fila_inicio][lc->columna_inicio] = INICIO;
+    if (lc->fila_final >= 0) lab->celdas[lc->fila_final][lc->columna_final] = FINAL;
+}
+
+// ==================== GENERACIÓN ====================
+
+/*
+ * generar_perfecto_compacto
+ * Genera laberinto perfecto con DFS directamente sobre habitaciones.
+ * Solo toca un byte por habitación en lugar de 4 celdas.
+ */
+void generar_perfecto_compacto(laberinto_compacto* lc) {
+    sembrar_aleatorio();    // Inicializa generador
+    inicializar_compacto(lc);  // Todas las paredes cerradas
+
+    if (lc->filas <= 0 || lc->columnas <= 0) return;  // Sin habitaciones
+
+    int pila[MAX_HABITACIONES];                    // Pila de habitaciones
+    unsigned char visitado[MAX_HABITACIONES] = {0};  // Habitaciones visitadas
+    int tope = 0;
+
+    pila[tope++] = 0;   // Empieza en la habitación (0,0)
+    visitado[0] = 1;
+    CONTAR(apilados_dfs);
+
+    while (tope > 0) {
+        int actual = pila[tope - 1];      // Habitación del tope
+        int f = actual / lc->columnas;
+        int c = actual % lc->columnas;
+
+        // Encuentra vecinas no visitadas
+        int vecinas[4];
+        int num_vecinas = 0;
+
+        for (int d = 0; d < 4; d++) {
+            int nf = f + desplazamientos[d][0];
+            int nc = c + desplazamientos[d][1];
+
+            if (nf >= 0 && nf < lc->filas && nc >= 0 && nc < lc->columnas &&
+                !visitado[nf * lc->columnas + nc]) {
+                vecinas[num_vecinas++] = d;  // Dirección candidata
+            }
+        }
+
+        if (num_vecinas > 0) {
+            int d = vecinas[rand() % num_vecinas];    // Dirección aleatoria
+            int siguiente = (f + desplazamientos[d][0]) * lc->columnas +
+                            (c + desplazamientos[d][1]);
+
+            abrir_pared_compacto(lc, f, c, d);  // Quita la pared entre ambas
+            visitado[siguiente] = 1;
+            pila[tope++] = siguiente;
+            CONTAR(apilados_dfs);
+            CONTAR(celdas_excavadas);
+        } else {
+            tope--;  // Backtrack
+        }
+    }
+}
+
+// ==================== RESOLUCIÓN ====================
+
+/*
+ * celda_abierta_compacto
+ * Indica si una celda del formato de bloques es transitable.
+ * Se calcula a partir de los bits, sin expandir el laberinto.
+ */
+static int celda_abierta_compacto(laberinto_compacto* lc, int i, int j) {
+    if ((i == lc->fila_inicio && j == lc->columna_inicio) ||
+        (i == lc->fila_final && j == lc->columna_final)) {
+        return 1;  // Entrada y salida siempre abiertas
+    }
+    if (i < 0 || j < 0 || i > 2 * lc->filas || j > 2 * lc->columnas) return 0;
+    if (i % 2 == 1 && j % 2 == 1) return 1;   // Habitación
+    if (i % 2 == 0 && j % 2 == 0) return 0;   // Esquina
+
+    if (i % 2 == 0) {  // Pared horizontal
+        int c = (j - 1) / 2;
+        if (i / 2 < lc->filas) return !hay_pared_compacto(lc, i / 2, c, DIR_NORTE);
+        return !hay_pared_compacto(lc, i / 2 - 1, c, DIR_SUR);
+    }
+
+    int f = (i - 1) / 2;  // Pared vertical
+    if (j / 2 < lc->columnas) return !hay_pared_compacto(lc, f, j / 2, DIR_OESTE);
+    return !hay_pared_compacto(lc, f, j / 2 - 1, DIR_ESTE);
+}
+
+/*
+ * enlaces_de_celda
+ * Lista las habitaciones alcanzables desde una celda cualquiera.
+ * Guarda la celda intermedia (o -1) usada para llegar a cada una.
+ */
+static int enlaces_de_celda(laberinto_compacto* lc, int fila, int columna,
+                            int habitaciones[], int intermedias[]) {
+    int total = 0;
+
+    // La celda es una habitación
+    if (fila % 2 == 1 && columna % 2 == 1 &&
+        (fila - 1) / 2 < lc->filas && (columna - 1) / 2 < lc->columnas) {
+        habitaciones[0] = ((fila - 1) / 2) * lc->columnas + (columna - 1) / 2;
+        intermedias[0] = -1;
+        return 1;
+    }
+
+    // Pared abierta (o celda especial) junto a habitaciones
+    int es_esquina = (fila % 2 == 0 && columna % 2 == 0);
+
+    for (int d = 0; d < 4; d++) {
+        int nf = fila + desplazamientos[d][0];
+        int nc = columna + desplazamientos[d][1];
+        if (!celda_abierta_compacto(lc, nf, nc)) continue;
+
+        if (!es_esquina) {
+            // Vecina directa: solo cuenta si es habitación
+            if (nf % 2 == 1 && nc % 2 == 1 &&
+                (nf - 1) / 2 < lc->filas && (nc - 1) / 2 < lc->columnas) {
+                habitaciones[total] = ((nf - 1) / 2) * lc->columnas + (nc - 1) / 2;
+                intermedias[total] = -1;
+                total++;
+            }
+            continue;
+        }
+
+        // Esquina: la vecina es una pared abierta; busca habitaciones tras ella
+        for (int e = 0; e < 4; e++) {
+            int hf = nf + desplazamientos[e][0];
+            int hc = nc + desplazamientos[e][1];
+            if (hf % 2 == 1 && hc % 2 == 1 && hf > 0 && hc > 0 &&
+                (hf - 1) / 2 < lc->filas && (hc - 1) / 2 < lc->columnas) {
+                habitaciones[total] = ((hf - 1) / 2) * lc->columnas + (hc - 1) / 2;
+                intermedias[total] = nf * COLUMNAS + nc;
+                total++;
+            }
+        }
+    }
+
+    return total;
+}
+
+/*
+ * resolver_compacto
+ * BFS sobre habitaciones desde INICIO hasta FINAL.
+ * Retorna el camino en nodos de celdas (formato de resolver_laberinto).
+ */
+int* resolver_compacto(laberinto_compacto* lc, int* longitud) {
+    static int camino[MAX_NODOS];             // Camino en nodos de celdas
+    int anterior[MAX_HABITACIONES];           // Habitación anterior (-2 = sin visitar)
+    int semilla[MAX_HABITACIONES];            // Enlace de origen de cada habitación
+    int destino[MAX_HABITACIONES];            // Enlace de destino (-1 = no es destino)
+    int cola[MAX_HABITACIONES];               // Cola para BFS
+    int frente = 0, final = 0;
+    int habitaciones_origen[8], intermedias_origen[8];
+    int habitaciones_fin[8], intermedias_fin[8];
+    int total = lc->filas * lc->columnas;
+
+    *longitud = 0;
+    if (lc->fila_inicio < 0 || lc->fila_final < 0) return NULL;  // Sin extremos
+
+    int num_origen = enlaces_de_celda(lc, lc->fila_inicio, lc->columna_inicio,
+                                      habitaciones_origen, intermedias_origen);
+    int num_fin = enlaces_de_celda(lc, lc->fila_final, lc->columna_final,
+                                   habitaciones_fin, intermedias_fin);
+
+    for (int h = 0; h < total; h++) {
+        anterior[h] = -2;   // Sin visitar
+        destino[h] = -2;    // No es destino
+    }
+    for (int k = 0; k < num_fin; k++) {
+        destino[habitaciones_fin[k]] = intermedias_fin[k];
+    }
+
+    // Siembra todas las habitaciones conectadas a INICIO
+    for (int k = 0; k < num_origen; k++) {
+        int h = habitaciones_origen[k];
+        if (anterior[h] != -2) continue;
+        anterior[h] = -1;
+        semilla[h] = intermedias_origen[k];
+        cola[final++] = h;
+    }
+
+    int encontrada = -1;  // Habitación destino alcanzada
+
+    while (frente < final) {
+        int actual = cola[frente++];
+        if (destino[actual] != -2) {
+            encontrada = actual;  // Primera habitación destino = camino mínimo
+            break;
+        }
+
+        int f = actual / lc->columnas;
+        int c = actual % lc->columnas;
+        unsigned char p = lc->paredes[f][c];
+
+        for (int d = 0; d < 4; d++) {
+            if (p & bits_pared[d]) continue;  // Pared cerrada
+            int nf = f + desplazamientos[d][0];
+            int nc = c + desplazamientos[d][1];
+            if (nf < 0 || nf >= lc->filas || nc < 0 || nc >= lc->columnas) continue;
+
+            int vecina = nf * lc->columnas + nc;
+            if (anterior[vecina] == -2) {
+                anterior[vecina] = actual;
+                semilla[vecina] = semilla[actual];
+                cola[final++] = vecina;
+            }
+        }
+    }
+
+    if (encontrada == -1) return NULL;  // Sin solución
+
+    // Recupera la cadena de habitaciones (en orden inverso)
+    int cadena[MAX_HABITACIONES];
+    int largo_cadena = 0;
+    for (int h = encontrada; h != -1; h = anterior[h]) {
+        cadena[largo_cadena++] = h;
+    }
+
+    // Prefijo: INICIO y celda intermedia
+    camino[(*longitud)++] = lc->fila_inicio * COLUMNAS + lc->columna_inicio;
+    if (semilla[encontrada] != -1) camino[(*longitud)++] = semilla[encontrada];
+
+    // Habitaciones con la pared abierta entre cada par
+    for (int k = largo_cadena - 1; k >= 0; k--) {
+        int f = cadena[k] / lc->columnas;
+        int c = cadena[k] % lc->columnas;
+        int nodo = (2 * f + 1) * COLUMNAS + (2 * c + 1);
+
+        if (k < largo_cadena - 1) {
+            camino[*longitud] = (camino[*longitud - 1] + nodo) / 2;  // Pared intermedia
+            (*longitud)++;
+        }
+        camino[(*longitud)++] = nodo;
+    }
+
+    // Sufijo: celda intermedia y FINAL
+    if (destino[encontrada] != -1) camino[(*longitud)++] = destino[encontrada];
+    camino[(*longitud)++] = lc->fila_final * COLUMNAS + lc->columna_final;
+
+    // Si INICIO o FINAL eran la propia habitación, elimina el duplicado
+    if (*longitud >= 2 && camino[0] == camino[1]) {
+        memmove(camino, camino + 1, (*longitud - 1) * sizeof(int));
+        (*longitud)--;
+    }
+    if (*longitud >= 2 && camino[*longitud - 1] == camino[*longitud - 2]) {
+        (*longitud)--;
+    }
+
+    return camino;
+}
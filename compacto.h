@@ -0,0 +1,65 @@
+/*
+ * compacto.h
+ * Representación compacta de laberintos con paredes delgadas.
+ * Cada habitación guarda sus 4 paredes como bits en un byte.
+ */
+
+#ifndef COMPACTO_H
+#define COMPACTO_H
+
+#include "laberinto.h"
+
+// ============================================================================
+// DEFINICIONES DE LA REPRESENTACIÓN COMPACTA
+// ============================================================================
+
+// Bits de pared de cada habitación
+#define PARED_NORTE 0x1
+#define PARED_SUR   0x2
+#define PARED_ESTE  0x4
+#define PARED_OESTE 0x8
+#define TODAS_LAS_PAREDES (PARED_NORTE | PARED_SUR | PARED_ESTE | PARED_OESTE)
+
+// Direcciones (índices para los bits de pared)
+#define DIR_NORTE 0
+#define DIR_SUR   1
+#define DIR_ESTE  2
+#define DIR_OESTE 3
+
+// Habitaciones: celdas impares del formato de bloques
+#define FILAS_COMPACTO ((FILAS - 1) / 2)
+#define COLUMNAS_COMPACTO ((COLUMNAS - 1) / 2)
+#define MAX_HABITACIONES (FILAS_COMPACTO * COLUMNAS_COMPACTO)
+
+/*
+ * laberinto_compacto - Laberinto con un byte de paredes por habitación
+ * La habitación (f, c) corresponde a la celda (2f+1, 2c+1) de celdas.
+ */
+typedef struct {
+    unsigned char paredes[FILAS_COMPACTO][COLUMNAS_COMPACTO];  // Bits de pared
+    int filas;              // Filas de habitaciones
+    int columnas;           // Columnas de habitaciones
+    int fila_inicio;        // Fila de INICIO (en celdas)
+    int columna_inicio;     // Columna de INICIO (en celdas)
+    int fila_final;         // Fila de FINAL (en celdas)
+    int columna_final;      // Columna de FINAL (en celdas)
+} laberinto_compacto;
+
+// ============================================================================
+// PROTOTIPOS DE FUNCIONES
+// ============================================================================
+
+/* Inicialización y paredes */
+void inicializar_compacto(laberinto_compacto* lc);
+void abrir_pared_compacto(laberinto_compacto* lc, int fila, int columna, int direccion);
+int hay_pared_compacto(laberinto_compacto* lc, int fila, int columna, int direccion);
+
+/* Conversión con el formato de bloques */
+int celdas_a_compacto(laberinto* lab, laberinto_compacto* lc);
+void compacto_a_celdas(laberinto_compacto* lc, laberinto* lab);
+
+/* Generación y resolución nativas */
+void generar_perfecto_compacto(laberinto_compacto* lc);
+int* resolver_compacto(laberinto_compacto* lc, int* longitud);
+
+#endif // COMPACTO_H
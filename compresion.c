@@ -0,0 +1,430 @@
+/*
+ * compresion.c
+ * Deflate por flujo con LZ77 (cadenas hash) y códigos Huffman fijos.
+ * Incluye CRC-32, Adler-32 y un escritor de archivos gzip.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "compresion.h"
+#include "memoria.h"
+
+#define MIN_COINCIDENCIA 3          // Coincidencia mínima de LZ77
+#define MAX_COINCIDENCIA 258        // Coincidencia máxima de deflate
+#define ANTICIPACION (MAX_COINCIDENCIA + MIN_COINCIDENCIA)  // Bytes por delante
+#define MAX_CADENA 32               // Candidatos revisados por posición
+#define FIN_BLOQUE 256              // Símbolo de fin de bloque
+
+// Tablas de deflate (RFC 1951, sección 3.2.5)
+static const int base_longitud[29] = {
+    3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+    35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258
+};
+static const int extra_longitud[29] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+    3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0
+};
+static const int base_distancia[30] = {
+    1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+    257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145,
+    8193, 12289, 16385, 24577
+};
+static const int extra_distancia[30] = {
+    0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+    7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13
+};
+
+// ==================== ESCRITURA DE BITS ====================
+
+/*
+ * emitir_byte
+ * Agrega un byte al buffer de salida.
+ * Entrega el buffer al escritor cuando se llena.
+ */
+static void emitir_byte(compresor_deflate* c, unsigned char byte) {
+    c->salida[c->usados++] = byte;
+    if (c->usados == BUFFER_SALIDA_DEFLATE) {
+        c->escritor(c->salida, c->usados, c->contexto);  // Vacía buffer
+        c->usados = 0;
+    }
+}
+
+/*
+ * poner_bits
+ * Agrega n bits (LSB primero) al flujo de salida.
+ * Emite bytes completos en cuanto se acumulan.
+ */
+static void poner_bits(compresor_deflate* c, uint32_t valor, int n) {
+    c->bits |= (uint64_t)valor << c->num_bits;
+    c->num_bits += n;
+
+    while (c->num_bits >= 8) {
+        emitir_byte(c, (unsigned char)(c->bits & 0xFF));
+        c->bits >>= 8;
+        c->num_bits -= 8;
+    }
+}
+
+/*
+ * poner_codigo
+ * Escribe un código Huffman (se transmite MSB primero).
+ * Invierte los bits antes de ponerlos en el flujo.
+ */
+static void poner_codigo(compresor_deflate* c, uint32_t codigo, int longitud) {
+    uint32_t invertido = 0;
+
+    for (int i = 0; i < longitud; i++) {
+        invertido = (invertido << 1) | ((codigo >> i) & 1);
+    }
+    poner_bits(c, invertido, longitud);
+}
+
+/*
+ * poner_simbolo
+ * Escribe un símbolo literal/longitud con la tabla Huffman fija.
+ * Rangos: 0-143 (8 bits), 144-255 (9), 256-279 (7), 280-287 (8).
+ */
+static void poner_simbolo(compresor_deflate* c, int simbolo) {
+    if (simbolo < 144) {
+        poner_codigo(c, 0x30 + simbolo, 8);
+    } else if (simbolo < 256) {
+        poner_codigo(c, 0x190 + (simbolo - 144), 9);
+    } else if (simbolo < 280) {
+        poner_codigo(c, simbolo - 256, 7);
+    } else {
+        poner_codigo(c, 0xC0 + (simbolo - 280), 8);
+    }
+}
+
+/*
+ * poner_coincidencia
+ * Escribe un par (longitud, distancia) de LZ77.
+ * Usa los códigos de longitud 257-285 y distancia 0-29.
+ */
+static void poner_coincidencia(compresor_deflate* c, int longitud, int distancia) {
+    int k = 28;
+    while (base_longitud[k] > longitud) k--;  // Código de longitud
+    poner_simbolo(c, 257 + k);
+    poner_bits(c, longitud - base_longitud[k], extra_longitud[k]);
+
+    int d = 29;
+    while (base_distancia[d] > distancia) d--;  // Código de distancia
+    poner_codigo(c, d, 5);
+    poner_bits(c, distancia - base_distancia[d], extra_distancia[d]);
+}
+
+// ==================== LZ77 ====================
+
+/*
+ * hash_posicion
+ * Hash de los 3 bytes que empiezan en la posición dada.
+ */
+static int hash_posicion(compresor_deflate* c, int pos) {
+    const unsigned char* v = c->ventana + pos;
+    return ((v[0] << 10) ^ (v[1] << 5) ^ v[2]) & ((1 << BITS_HASH_DEFLATE) - 1);
+}
+
+/*
+ * insertar_posicion
+ * Registra la posición en su cadena hash.
+ */
+static void insertar_posicion(compresor_deflate* c, int pos) {
+    int h = hash_posicion(c, pos);
+    c->previo[pos & (VENTANA_DEFLATE - 1)] = c->cabeza[h];
+    c->cabeza[h] = pos;
+}
+
+/*
+ * comprimir_hasta
+ * Comprime los bytes desde inicio hasta el límite dado.
+ * Las coincidencias pueden leer hasta el fin de los datos válidos.
+ */
+static void comprimir_hasta(compresor_deflate* c, int limite) {
+    while (c->inicio < limite) {
+        int pos = c->inicio;
+        int disponible = c->fin - pos;
+        int mejor_longitud = 0;
+        int mejor_distancia = 0;
+
+        if (disponible >= MIN_COINCIDENCIA) {
+            int maximo = (disponible < MAX_COINCIDENCIA) ? disponible : MAX_COINCIDENCIA;
+            int candidato = c->cabeza[hash_posicion(c, pos)];
+            int restantes = MAX_CADENA;
+
+            insertar_posicion(c, pos);
+
+            // Recorre candidatos dentro de la ventana, de más cerca a más lejos
+            while (candidato >= 0 && pos - candidato < VENTANA_DEFLATE && restantes-- > 0) {
+                const unsigned char* a = c->ventana + candidato;
+                const unsigned char* b = c->ventana + pos;
+
+                if (a[mejor_longitud] == b[mejor_longitud]) {
+                    int largo = 0;
+                    while (largo < maximo && a[largo] == b[largo]) largo++;
+
+                    if (largo > mejor_longitud) {
+                        mejor_longitud = largo;
+                        mejor_distancia = pos - candidato;
+                        if (largo == maximo) break;  // No se puede mejorar
+                    }
+                }
+
+                int siguiente = c->previo[candidato & (VENTANA_DEFLATE - 1)];
+                if (siguiente >= candidato) break;  // Entrada reciclada
+                candidato = siguiente;
+            }
+        }
+
+        if (mejor_longitud >= MIN_COINCIDENCIA) {
+            poner_coincidencia(c, mejor_longitud, mejor_distancia);
+
+            // Inserta las posiciones cubiertas por la coincidencia
+            for (int k = 1; k < mejor_longitud; k++) {
+                if (c->fin - (pos + k) >= MIN_COINCIDENCIA) insertar_posicion(c, pos + k);
+            }
+            c->inicio += mejor_longitud;
+        } else {
+            poner_simbolo(c, c->ventana[pos]);  // Literal
+            c->inicio++;
+        }
+    }
+}
+
+/*
+ * deslizar_ventana
+ * Descarta la mitad antigua de la ventana.
+ * Ajusta las posiciones guardadas en las cadenas hash.
+ */
+static void deslizar_ventana(compresor_deflate* c) {
+    memmove(c->ventana, c->ventana + VENTANA_DEFLATE, VENTANA_DEFLATE);
+    c->inicio -= VENTANA_DEFLATE;
+    c->fin -= VENTANA_DEFLATE;
+
+    for (int i = 0; i < (1 << BITS_HASH_DEFLATE); i++) {
+        c->cabeza[i] = (c->cabeza[i] >= VENTANA_DEFLATE) ? c->cabeza[i] - VENTANA_DEFLATE : -1;
+    }
+    for (int i = 0; i < VENTANA_DEFLATE; i++) {
+        c->previo[i] = (c->previo[i] >= VENTANA_DEFLATE) ? c->previo[i] - VENTANA_DEFLATE : -1;
+    }
+}
+
+// ==================== INTERFAZ DEL COMPRESOR ====================
+
+/*
+ * crear_compresor
+ * Reserva el estado y escribe la cabecera del bloque Huffman fijo.
+ * La salida se entrega al escritor en trozos de hasta 64 KB.
+ */
+compresor_deflate* crear_compresor(escritor_bytes escritor, void* contexto) {
+    compresor_deflate* c = (compresor_deflate*)reservar_memoria(MEM_COMPRESION,
+                                                                sizeof(compresor_deflate));
+    if (!c) return NULL;
+
+    memset(c->cabeza, 0xFF, sizeof(c->cabeza));   // Todas las cadenas vacías (-1)
+    memset(c->previo, 0xFF, sizeof(c->previo));
+    c->inicio = 0;
+    c->fin = 0;
+    c->bits = 0;
+    c->num_bits = 0;
+    c->usados = 0;
+    c->escritor = escritor;
+    c->contexto = contexto;
+
+    poner_bits(c, 0, 1);   // BFINAL = 0 (el bloque final va al terminar)
+    poner_bits(c, 1, 2);   // BTYPE = 01 (Huffman fijo)
+
+    return c;
+}
+
+/*
+ * escribir_compresor
+ * Agrega datos al flujo y comprime lo que ya tiene anticipación.
+ * Desliza la ventana cuando se llena.
+ */
+void escribir_compresor(compresor_deflate* c, const void* datos, size_t n) {
+    const unsigned char* p = (const unsigned char*)datos;
+
+    while (n > 0) {
+        size_t espacio = 2 * VENTANA_DEFLATE - c->fin;
+        size_t trozo = (n < espacio) ? n : espacio;
+
+        memcpy(c->ventana + c->fin, p, trozo);  // Copia a la ventana
+        c->fin += (int)trozo;
+        p += trozo;
+        n -= trozo;
+
+        if (c->fin - ANTICIPACION > c->inicio) {
+            comprimir_hasta(c, c->fin - ANTICIPACION);
+        }
+        if (c->fin == 2 * VENTANA_DEFLATE) {
+            deslizar_ventana(c);
+        }
+    }
+}
+
+/*
+ * terminar_compresor
+ * Comprime lo pendiente y cierra el flujo deflate.
+ * Agrega un bloque final vacío y vacía todos los bits.
+ */
+void terminar_compresor(compresor_deflate* c) {
+    comprimir_hasta(c, c->fin);     // Resto de los datos
+    poner_simbolo(c, FIN_BLOQUE);  // Cierra el bloque abierto
+
+    poner_bits(c, 1, 1);            // BFINAL = 1
+    poner_bits(c, 1, 2);            // BTYPE = 01
+    poner_simbolo(c, FIN_BLOQUE);  // Bloque vacío
+
+    if (c->num_bits > 0) poner_bits(c, 0, 8 - c->num_bits);  // Completa el byte
+    if (c->usados > 0) {
+        c->escritor(c->salida, c->usados, c->contexto);
+        c->usados = 0;
+    }
+}
+
+/*
+ * destruir_compresor
+ * Libera el estado del compresor.
+ * Simple wrapper para liberar_memoria().
+ */
+void destruir_compresor(compresor_deflate* c) {
+    if (c) {
+        liberar_memoria(c);
+    }
+}
+
+// ==================== SUMAS DE VERIFICACIÓN ====================
+
+/*
+ * actualizar_crc32
+ * CRC-32 (polinomio 0xEDB88320) usado por gzip y PNG.
+ * La tabla se calcula la primera vez.
+ */
+uint32_t actualizar_crc32(uint32_t crc, const unsigned char* datos, size_t n) {
+    static uint32_t tabla[256];
+    static int tabla_lista = 0;
+
+    if (!tabla_lista) {
+        for (uint32_t i = 0; i < 256; i++) {
+            uint32_t valor = i;
+            for (int k = 0; k < 8; k++) {
+                valor = (valor & 1) ? 0xEDB88320u ^ (valor >> 1) : valor >> 1;
+            }
+            tabla[i] = valor;
+        }
+        tabla_lista = 1;
+    }
+
+    crc = ~crc;
+    for (size_t i = 0; i < n; i++) {
+        crc = tabla[(crc ^ datos[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+/*
+ * actualizar_adler32
+ * Adler-32 usado por el envoltorio zlib de PNG.
+ * Reduce módulo 65521 cada 5552 bytes como zlib.
+ */
+uint32_t actualizar_adler32(uint32_t adler, const unsigned char* datos, size_t n) {
+    uint32_t s1 = adler & 0xFFFF;
+    uint32_t s2 = adler >> 16;
+
+    while (n > 0) {
+        size_t bloque = (n < 5552) ? n : 5552;
+        n -= bloque;
+        while (bloque-- > 0) {
+            s1 += *datos++;
+            s2 += s1;
+        }
+        s1 %= 65521;
+        s2 %= 65521;
+    }
+
+    return (s2 << 16) | s1;
+}
+
+// ==================== ARCHIVOS GZIP ====================
+
+/*
+ * escribir_en_archivo
+ * Escritor que manda los bytes comprimidos a un FILE*.
+ */
+static void escribir_en_archivo(const unsigned char* datos, size_t n, void* contexto) {
+    fwrite(datos, 1, n, (FILE*)contexto);
+}
+
+/*
+ * escribir_entero_le
+ * Escribe un entero de 32 bits en little-endian.
+ */
+static void escribir_entero_le(FILE* archivo, uint32_t valor) {
+    unsigned char bytes[4] = {
+        (unsigned char)(valor & 0xFF), (unsigned char)((valor >> 8) & 0xFF),
+        (unsigned char)((valor >> 16) & 0xFF), (unsigned char)(valor >> 24)
+    };
+    fwrite(bytes, 1, 4, archivo);
+}
+
+/*
+ * abrir_gzip
+ * Crea un archivo .gz y escribe la cabecera (RFC 1952).
+ * Retorna NULL si no se puede crear.
+ */
+archivo_gzip* abrir_gzip(const char* ruta) {
+    static const unsigned char cabecera[10] = {
+        0x1f, 0x8b, 8, 0, 0, 0, 0, 0, 0, 3   // Deflate, sin mtime, Unix
+    };
+
+    archivo_gzip* gz = (archivo_gzip*)reservar_memoria(MEM_COMPRESION, sizeof(archivo_gzip));
+    if (!gz) return NULL;
+
+    gz->archivo = fopen(ruta, "wb");
+    if (gz->archivo == NULL) {
+        liberar_memoria(gz);
+        return NULL;
+    }
+
+    gz->compresor = crear_compresor(escribir_en_archivo, gz->archivo);
+    if (!gz->compresor) {
+        fclose(gz->archivo);
+        liberar_memoria(gz);
+        return NULL;
+    }
+
+    gz->crc = 0;
+    gz->tamano = 0;
+    fwrite(cabecera, 1, sizeof(cabecera), gz->archivo);
+
+    return gz;
+}
+
+/*
+ * escribir_gzip
+ * Comprime datos hacia el archivo gzip.
+ * Actualiza CRC y tamaño para el pie del archivo.
+ */
+void escribir_gzip(archivo_gzip* gz, const void* datos, size_t n) {
+    gz->crc = actualizar_crc32(gz->crc, (const unsigned char*)datos, n);
+    gz->tamano += (uint32_t)n;
+    escribir_compresor(gz->compresor, datos, n);
+}
+
+/*
+ * cerrar_gzip
+ * Termina el flujo, escribe CRC y tamaño y cierra el archivo.
+ * Retorna 1 si todo se escribió correctamente.
+ */
+int cerrar_gzip(archivo_gzip* gz) {
+    terminar_compresor(gz->compresor);
+    escribir_entero_le(gz->archivo, gz->crc);
+    escribir_entero_le(gz->archivo, gz->tamano);
+
+    int ok = (ferror(gz->archivo) == 0);
+    ok = (fclose(gz->archivo) == 0) && ok;
+    destruir_compresor(gz->compresor);
+    liberar_memoria(gz);
+
+    return ok;
+}
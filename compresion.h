@@ -0,0 +1,72 @@
+/*
+ * compresion.h
+ * Compresor deflate mínimo (LZ77 + Huffman fijo) por flujo.
+ * Sirve para archivos .gz/.svgz y para los datos de imágenes PNG.
+ */
+
+#ifndef COMPRESION_H
+#define COMPRESION_H
+
+#include <stdio.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// ============================================================================
+// DEFINICIONES DEL COMPRESOR
+// ============================================================================
+
+#define VENTANA_DEFLATE 32768           // Distancia máxima de referencia
+#define BITS_HASH_DEFLATE 15            // Tamaño de la tabla hash (2^15)
+#define BUFFER_SALIDA_DEFLATE 65536     // Bytes comprimidos antes de emitir
+
+/* escritor_bytes - Destino de los bytes comprimidos */
+typedef void (*escritor_bytes)(const unsigned char* datos, size_t n, void* contexto);
+
+/*
+ * compresor_deflate - Estado de compresión por flujo
+ * Guarda la ventana deslizante, las cadenas hash y los bits pendientes.
+ */
+typedef struct {
+    unsigned char ventana[2 * VENTANA_DEFLATE];  // Historia + datos nuevos
+    int cabeza[1 << BITS_HASH_DEFLATE];         // Última posición por hash
+    int previo[VENTANA_DEFLATE];                // Cadena de posiciones
+    int inicio;                 // Próximo byte a comprimir
+    int fin;                    // Fin de datos válidos
+    uint64_t bits;              // Acumulador de bits
+    int num_bits;               // Bits en el acumulador
+    unsigned char salida[BUFFER_SALIDA_DEFLATE];  // Buffer de salida
+    size_t usados;              // Bytes usados en salida
+    escritor_bytes escritor;    // Función que recibe la salida
+    void* contexto;             // Contexto del escritor
+} compresor_deflate;
+
+/*
+ * archivo_gzip - Archivo .gz escrito por flujo
+ */
+typedef struct {
+    FILE* archivo;                  // Archivo destino
+    compresor_deflate* compresor;   // Compresor asociado
+    uint32_t crc;                   // CRC-32 de los datos sin comprimir
+    uint32_t tamano;                // Tamaño sin comprimir (módulo 2^32)
+} archivo_gzip;
+
+// ============================================================================
+// PROTOTIPOS DE FUNCIONES
+// ============================================================================
+
+/* Compresor deflate */
+compresor_deflate* crear_compresor(escritor_bytes escritor, void* contexto);
+void escribir_compresor(compresor_deflate* c, const void* datos, size_t n);
+void terminar_compresor(compresor_deflate* c);
+void destruir_compresor(compresor_deflate* c);
+
+/* Sumas de verificación */
+uint32_t actualizar_crc32(uint32_t crc, const unsigned char* datos, size_t n);
+uint32_t actualizar_adler32(uint32_t adler, const unsigned char* datos, size_t n);
+
+/* Archivos gzip */
+archivo_gzip* abrir_gzip(const char* ruta);
+void escribir_gzip(archivo_gzip* gz, const void* datos, size_t n);
+int cerrar_gzip(archivo_gzip* gz);
+
+#endif // COMPRESION_H
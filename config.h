@@ -7,9 +7,13 @@
 #ifndef CONFIG_H
 #define CONFIG_H
 
-// Tamaño del laberinto
+// Tamaño del laberinto (se puede cambiar al compilar, p. ej. -DFILAS=21)
+#ifndef FILAS
 #define FILAS 15
+#endif
+#ifndef COLUMNAS
 #define COLUMNAS 15
+#endif
 #define MAX_NODOS (FILAS * COLUMNAS)
 
 // Configuración de algoritmos
@@ -19,13 +23,28 @@
 // Configuración de archivos
 #define MAX_NOMBRE 100
 #define MAX_LINEA 256
+#ifndef DIRECTORIO_LABERINTOS
 #define DIRECTORIO_LABERINTOS "laberintos/"
+#endif
+#define ARCHIVO_PAQUETE DIRECTORIO_LABERINTOS "laberintos.paq"
+
+// Configuración del servidor local
+#define SOCKET_SERVIDOR DIRECTORIO_LABERINTOS "servidor.sock"
+#define CAPACIDAD_CACHE_SERVIDOR 64        // Laberintos en la caché LRU
 
 // Configuración de generación
 #define PROBABILIDAD_CAMINO 65
 #define PROBABILIDAD_DIAGONAL 20
 #define MAX_INTENTOS_BACKTRACKING 1000
 
+// Configuración de visualización
+#define LINEAS_RESERVADAS_VISTA 8          // Encabezado, leyenda y menú alrededor del laberinto
+
+// Configuración de animación
+#define INTERVALO_ANIMACION_MS 200         // Tiempo entre cuadros
+#define DURACION_MAXIMA_ANIMACION_MS 10000 // Caminos largos agrupan pasos por cuadro
+#define LINEAS_RESERVADAS_ANIMACION 4      // Contador, línea en blanco, ventana y cursor final
+
 // Colores para terminal (ANSI)
 #define COLOR_RESET   "\x1b[0m"
 #define COLOR_ROJO    "\x1b[31m"
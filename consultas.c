@@ -0,0 +1,399 @@
+/*
+ * consultas.c
+ * Resolución de lotes de rutas sobre un laberinto ya cargado.
+ * Las consultas se ordenan por origen (ordenamiento por conteo) y cada
+ * origen distinto hace un solo BFS que responde a todos sus destinos.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+#include "consultas.h"
+#include "contadores.h"
+#include "memoria.h"
+
+// ==================== VECINOS ====================
+
+/*
+ * calcular_vecinos
+ * Un byte por celda con un bit por vecino abierto (ver VECINO_*).
+ * Las paredes quedan en 0.
+ */
+void calcular_vecinos(laberinto* lab, unsigned char* vecinos) {
+    for (int i = 0; i < FILAS; i++) {
+        for (int j = 0; j < COLUMNAS; j++) {
+            int nodo = i * COLUMNAS + j;
+            vecinos[nodo] = 0;
+            if (lab->celdas[i][j] == PARED) continue;
+
+            if (i > 0 && lab->celdas[i - 1][j] != PARED) vecinos[nodo] |= 1 << VECINO_NORTE;
+            if (i < FILAS - 1 && lab->celdas[i + 1][j] != PARED) vecinos[nodo] |= 1 << VECINO_SUR;
+            if (j < COLUMNAS - 1 && lab->celdas[i][j + 1] != PARED) vecinos[nodo] |= 1 << VECINO_ESTE;
+            if (j > 0 && lab->celdas[i][j - 1] != PARED) vecinos[nodo] |= 1 << VECINO_OESTE;
+        }
+    }
+}
+
+/*
+ * recorrer_anchura_vecinos
+ * BFS completo desde origen (todas las aristas pesan 1).
+ * distancia queda en -1 donde no se llega; anterior puede ser NULL.
+ */
+void recorrer_anchura_vecinos(const unsigned char* vecinos, int origen,
+                              int* distancia, int* anterior, int* cola) {
+    int cabeza = 0, fin = 0;
+
+    for (int n = 0; n < MAX_NODOS; n++) {
+        distancia[n] = -1;
+        if (anterior != NULL) anterior[n] = -1;
+    }
+
+    distancia[origen] = 0;
+    cola[fin++] = origen;
+    while (cabeza < fin) {
+        int u = cola[cabeza++];
+        for (int d = 0; d < 4; d++) {
+            if (!(vecinos[u] & (1 << d))) continue;
+            int v = u + PASO_VECINO(d);
+            if (distancia[v] == -1) {
+                distancia[v] = distancia[u] + 1;
+                if (anterior != NULL) anterior[v] = u;
+                cola[fin++] = v;
+            }
+        }
+    }
+}
+
+// ==================== LOTES ====================
+
+/*
+ * lote_interno - Datos compartidos por los hilos de un lote
+ */
+typedef struct {
+    laberinto* lab;                 // Laberinto consultado
+    const unsigned char* vecinos;   // Vecinos por bits
+    consulta_ruta* consultas;       // Consultas del llamador
+    const int* orden;               // Índices de consultas ordenados por origen
+    const int* inicio_grupo;        // Primera posición en orden de cada grupo
+    int num_grupos;                 // Orígenes distintos
+    int con_camino;                 // 0: solo pasos; 1: escribir caminos
+    size_t* inicio_camino;          // Con caminos: posición de cada uno en su hilo
+    unsigned char* hilo_camino;     // Con caminos: hilo que escribió cada uno
+    int siguiente_grupo;            // Próximo grupo sin tomar
+    pthread_mutex_t candado;        // Protege siguiente_grupo y las reservas
+} lote_interno;
+
+/*
+ * trabajo_hilo - Arreglos propios de cada hilo
+ * Los sellos evitan reiniciar visto/objetivo en cada grupo.
+ */
+typedef struct {
+    lote_interno* lote;         // Lote compartido
+    int numero;                 // Posición del hilo en el lote
+    unsigned int sello;         // Marca del grupo actual
+    unsigned int* visto;        // visto[n] == sello: n ya alcanzado
+    unsigned int* objetivo;     // objetivo[n] == sello: n es destino del grupo
+    int* distancia;             // Pasos desde el origen del grupo
+    int* anterior;              // Árbol BFS del grupo
+    int* cola;                  // Cola del BFS
+    long long visitados;        // Nodos sacados de la cola
+    int* caminos;               // Caminos de los grupos de este hilo
+    size_t usados;              // Enteros ocupados en caminos
+    size_t capacidad;           // Enteros reservados en caminos
+    int sin_memoria;            // 1 si caminos no pudo crecer
+} trabajo_hilo;
+
+#define ABIERTA(lab, nodo) ((lab)->celdas[(nodo) / COLUMNAS][(nodo) % COLUMNAS] != PARED)
+
+static void nuevo_sello(trabajo_hilo* h) {
+    if (++h->sello == 0) {  // Dio la vuelta: se limpian las marcas
+        memset(h->visto, 0, MAX_NODOS * sizeof(unsigned int));
+        memset(h->objetivo, 0, MAX_NODOS * sizeof(unsigned int));
+        h->sello = 1;
+    }
+}
+
+/*
+ * recorrer_grupo
+ * BFS desde origen que se detiene al alcanzar todos los destinos.
+ */
+static void recorrer_grupo(trabajo_hilo* h, int origen, int pendientes) {
+    const unsigned char* vecinos = h->lote->vecinos;
+    int cabeza = 0, fin = 0;
+
+    h->visto[origen] = h->sello;
+    h->distancia[origen] = 0;
+    h->anterior[origen] = -1;
+    h->cola[fin++] = origen;
+    if (h->objetivo[origen] == h->sello) pendientes--;
+
+    while (cabeza < fin && pendientes > 0) {
+        int u = h->cola[cabeza++];
+        h->visitados++;
+        for (int d = 0; d < 4; d++) {
+            if (!(vecinos[u] & (1 << d))) continue;
+            int v = u + PASO_VECINO(d);
+            if (h->visto[v] == h->sello) continue;
+            h->visto[v] = h->sello;
+            h->distancia[v] = h->distancia[u] + 1;
+            h->anterior[v] = u;
+            h->cola[fin++] = v;
+            if (h->objetivo[v] == h->sello) pendientes--;
+        }
+    }
+}
+
+/*
+ * asegurar_caminos
+ * Crece (al doble) los caminos del hilo hasta que quepan n nodos más.
+ * La contabilidad de memoria no es concurrente: se reserva bajo el candado.
+ */
+static int asegurar_caminos(trabajo_hilo* h, size_t n) {
+    if (h->usados + n <= h->capacidad) return 1;
+
+    size_t nueva = h->capacidad ? 2 * h->capacidad : (size_t)MAX_NODOS;
+    while (nueva < h->usados + n) nueva *= 2;
+
+    pthread_mutex_lock(&h->lote->candado);
+    int* mayor = (int*)redimensionar_memoria(MEM_ALGORITMOS, h->caminos, nueva * sizeof(int));
+    pthread_mutex_unlock(&h->lote->candado);
+    if (!mayor) return 0;
+
+    h->caminos = mayor;
+    h->capacidad = nueva;
+    return 1;
+}
+
+/*
+ * resolver_grupo
+ * Un BFS para todas las consultas del grupo g. Con caminos, cada uno se
+ * copia del árbol BFS a los caminos del hilo en la misma pasada.
+ */
+static void resolver_grupo(trabajo_hilo* h, int g) {
+    lote_interno* lote = h->lote;
+    int desde = lote->inicio_grupo[g];
+    int hasta = lote->inicio_grupo[g + 1];
+    int origen = lote->consultas[lote->orden[desde]].origen;
+    int pendientes = 0;
+
+    nuevo_sello(h);
+    if (!ABIERTA(lote->lab, origen)) {
+        for (int k = desde; k < hasta; k++) lote->consultas[lote->orden[k]].pasos = -1;
+        return;
+    }
+
+    // Marca los destinos abiertos distintos del grupo
+    for (int k = desde; k < hasta; k++) {
+        int destino = lote->consultas[lote->orden[k]].destino;
+        if (ABIERTA(lote->lab, destino) && h->objetivo[destino] != h->sello) {
+            h->objetivo[destino] = h->sello;
+            pendientes++;
+        }
+    }
+    recorrer_grupo(h, origen, pendientes);
+
+    for (int k = desde; k < hasta; k++) {
+        int indice = lote->orden[k];
+        consulta_ruta* c = &lote->consultas[indice];
+        c->pasos = (h->visto[c->destino] == h->sello) ? h->distancia[c->destino] : -1;
+        if (!lote->con_camino || c->pasos < 0) continue;
+        if (!asegurar_caminos(h, (size_t)c->pasos + 1)) {
+            h->sin_memoria = 1;
+            continue;
+        }
+
+        int* camino = h->caminos + h->usados;
+        int v = c->destino;
+        for (int i = c->pasos; i >= 0; i--) {  // Del destino hacia el origen
+            camino[i] = v;
+            v = h->anterior[v];
+        }
+        lote->inicio_camino[indice] = h->usados;
+        lote->hilo_camino[indice] = (unsigned char)h->numero;
+        h->usados += (size_t)c->pasos + 1;
+    }
+}
+
+/*
+ * trabajar_lote
+ * Toma grupos de a GRUPOS_POR_TOMA hasta que no quedan.
+ */
+static void* trabajar_lote(void* argumento) {
+    trabajo_hilo* h = (trabajo_hilo*)argumento;
+    lote_interno* lote = h->lote;
+
+    for (;;) {
+        pthread_mutex_lock(&lote->candado);
+        int primero = lote->siguiente_grupo;
+        lote->siguiente_grupo += GRUPOS_POR_TOMA;
+        pthread_mutex_unlock(&lote->candado);
+
+        if (primero >= lote->num_grupos) break;
+        int ultimo = primero + GRUPOS_POR_TOMA;
+        if (ultimo > lote->num_grupos) ultimo = lote->num_grupos;
+        for (int g = primero; g < ultimo; g++) resolver_grupo(h, g);
+    }
+    volcar_contadores_hilo();   // Los contadores del hilo mueren con él
+    return NULL;
+}
+
+/*
+ * ejecutar_fase
+ * Corre trabajar_lote en hilos - 1 hilos nuevos y en el actual.
+ * Retorna los hilos que realmente trabajaron.
+ */
+static int ejecutar_fase(lote_interno* lote, trabajo_hilo* trabajos, int hilos) {
+    pthread_t ids[MAX_HILOS_CONSULTAS];
+    int creados = 0;
+
+    lote->siguiente_grupo = 0;
+    for (int t = 1; t < hilos; t++) {
+        if (pthread_create(&ids[creados], NULL, trabajar_lote, &trabajos[t]) != 0) break;
+        creados++;
+    }
+    trabajar_lote(&trabajos[0]);  // El hilo actual también trabaja
+    for (int t = 0; t < creados; t++) pthread_join(ids[t], NULL);
+
+    return creados + 1;
+}
+
+/*
+ * hilos_disponibles
+ * Procesadores en línea, acotado a MAX_HILOS_CONSULTAS.
+ */
+int hilos_disponibles(void) {
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    if (n < 1) return 1;
+    return n > MAX_HILOS_CONSULTAS ? MAX_HILOS_CONSULTAS : (int)n;
+}
+
+/*
+ * resolver_lote_consultas
+ * Llena pasos de cada consulta y, con con_camino, también camino; todo
+ * en un solo BFS por grupo. Los nodos deben estar en [0, MAX_NODOS).
+ * Retorna 0 sin memoria.
+ */
+int resolver_lote_consultas(laberinto* lab, consulta_ruta* consultas, int cantidad,
+                            int hilos, int con_camino, resumen_lote* resumen) {
+    lote_interno lote;
+    trabajo_hilo trabajos[MAX_HILOS_CONSULTAS];
+
+    memset(resumen, 0, sizeof(*resumen));
+    if (cantidad <= 0) return 1;
+    if (hilos < 1) hilos = 1;
+    if (hilos > MAX_HILOS_CONSULTAS) hilos = MAX_HILOS_CONSULTAS;
+
+    unsigned char* vecinos = (unsigned char*)reservar_memoria(MEM_ALGORITMOS, MAX_NODOS);
+    int* orden = (int*)reservar_memoria(MEM_ALGORITMOS, (size_t)cantidad * sizeof(int));
+    int* inicio_grupo = (int*)reservar_memoria(MEM_ALGORITMOS, ((size_t)cantidad + 1) * sizeof(int));
+    int* posicion = (int*)reservar_memoria_cero(MEM_ALGORITMOS, MAX_NODOS + 1, sizeof(int));
+    size_t* inicio_camino = con_camino ? (size_t*)reservar_memoria(MEM_ALGORITMOS,
+        (size_t)cantidad * (sizeof(size_t) + 1)) : NULL;
+    if (!vecinos || !orden || !inicio_grupo || !posicion || (con_camino && !inicio_camino)) {
+        liberar_memoria(vecinos);
+        liberar_memoria(orden);
+        liberar_memoria(inicio_grupo);
+        liberar_memoria(posicion);
+        liberar_memoria(inicio_camino);
+        return 0;
+    }
+    calcular_vecinos(lab, vecinos);
+
+    // Ordenamiento por conteo: los grupos quedan contiguos en orden
+    for (int k = 0; k < cantidad; k++) posicion[consultas[k].origen + 1]++;
+    for (int n = 0; n < MAX_NODOS; n++) posicion[n + 1] += posicion[n];
+    int num_grupos = 0;
+    for (int n = 0; n < MAX_NODOS; n++) {
+        if (posicion[n + 1] > posicion[n]) inicio_grupo[num_grupos++] = posicion[n];
+    }
+    inicio_grupo[num_grupos] = cantidad;
+    for (int k = 0; k < cantidad; k++) orden[posicion[consultas[k].origen]++] = k;
+    liberar_memoria(posicion);
+
+    memset(&lote, 0, sizeof(lote));
+    lote.lab = lab;
+    lote.vecinos = vecinos;
+    lote.consultas = consultas;
+    lote.orden = orden;
+    lote.inicio_grupo = inicio_grupo;
+    lote.num_grupos = num_grupos;
+    lote.con_camino = con_camino;
+    lote.inicio_camino = inicio_camino;
+    lote.hilo_camino = con_camino ? (unsigned char*)(inicio_camino + cantidad) : NULL;
+    pthread_mutex_init(&lote.candado, NULL);
+
+    // Arreglos de cada hilo: se reservan aquí (la contabilidad no es concurrente)
+    if (hilos > num_grupos) hilos = num_grupos;
+    int ok = 1;
+    for (int t = 0; t < hilos; t++) {
+        size_t bytes = MAX_NODOS * (2 * sizeof(unsigned int) + 3 * sizeof(int));
+        char* bloque = (char*)reservar_memoria_cero(MEM_ALGORITMOS, 1, bytes);
+        memset(&trabajos[t], 0, sizeof(trabajo_hilo));
+        if (!bloque) {
+            hilos = t;
+            ok = (t > 0);
+            break;
+        }
+        trabajos[t].lote = &lote;
+        trabajos[t].numero = t;
+        trabajos[t].visto = (unsigned int*)bloque;
+        trabajos[t].objetivo = trabajos[t].visto + MAX_NODOS;
+        trabajos[t].distancia = (int*)(trabajos[t].objetivo + MAX_NODOS);
+        trabajos[t].anterior = trabajos[t].distancia + MAX_NODOS;
+        trabajos[t].cola = trabajos[t].anterior + MAX_NODOS;
+    }
+
+    if (ok) {
+        resumen->hilos = ejecutar_fase(&lote, trabajos, hilos);
+        resumen->grupos = num_grupos;
+    }
+
+    // Los caminos de cada hilo se juntan en un solo bloque para el llamador
+    if (ok && con_camino) {
+        size_t total = 0;
+        for (int t = 0; t < hilos; t++) {
+            if (trabajos[t].sin_memoria) ok = 0;
+            total += trabajos[t].usados;
+        }
+        int* nodos = NULL;
+        if (ok && hilos == 1) {
+            nodos = trabajos[0].caminos;       // Un hilo: su bloque ya es el final
+            trabajos[0].caminos = NULL;
+        } else if (ok) {
+            nodos = (int*)reservar_memoria(MEM_ALGORITMOS, (total ? total : 1) * sizeof(int));
+        }
+        size_t base[MAX_HILOS_CONSULTAS];
+        size_t usado = 0;
+        for (int t = 0; t < hilos; t++) {
+            base[t] = usado;
+            if (nodos && trabajos[t].caminos) {
+                memcpy(nodos + usado, trabajos[t].caminos, trabajos[t].usados * sizeof(int));
+            }
+            usado += trabajos[t].usados;
+        }
+        for (int k = 0; k < cantidad; k++) {
+            consultas[k].camino = NULL;
+            if (nodos && consultas[k].pasos >= 0) {
+                consultas[k].camino = nodos + base[lote.hilo_camino[k]] + inicio_camino[k];
+            }
+        }
+        if (ok && !nodos && total > 0) ok = 0;
+        resumen->nodos_caminos = nodos;
+    }
+
+    for (int t = 0; t < hilos; t++) {
+        resumen->visitados += trabajos[t].visitados;
+        liberar_memoria(trabajos[t].visto);
+        liberar_memoria(trabajos[t].caminos);
+    }
+    pthread_mutex_destroy(&lote.candado);
+    liberar_memoria(vecinos);
+    liberar_memoria(orden);
+    liberar_memoria(inicio_grupo);
+    liberar_memoria(inicio_camino);
+    return ok;
+}
@@ -0,0 +1,66 @@
+/*
+ * consultas.h
+ * Lotes de consultas (origen, destino) sobre un mismo laberinto.
+ * Agrupa por origen para reusar cada árbol BFS y reparte los grupos
+ * entre varios hilos.
+ */
+
+#ifndef CONSULTAS_H
+#define CONSULTAS_H
+
+#include "laberinto.h"
+
+// ============================================================================
+// VECINOS POR BITS
+// ============================================================================
+
+// Bit d de vecinos[nodo]: la celda vecina en la dirección d está abierta
+#define VECINO_NORTE 0
+#define VECINO_SUR   1
+#define VECINO_ESTE  2
+#define VECINO_OESTE 3
+#define PASO_VECINO(d) ((d) == VECINO_NORTE ? -COLUMNAS : (d) == VECINO_SUR ? COLUMNAS : \
+                        (d) == VECINO_ESTE ? 1 : -1)
+
+#define MAX_HILOS_CONSULTAS 64      // Límite de hilos de un lote
+#define GRUPOS_POR_TOMA 8           // Grupos que toma un hilo de una vez
+
+// ============================================================================
+// ESTRUCTURAS DE CONSULTAS
+// ============================================================================
+
+/*
+ * consulta_ruta - Una pregunta del lote y su respuesta
+ */
+typedef struct {
+    int origen;         // Nodo de partida (fila * COLUMNAS + columna)
+    int destino;        // Nodo de llegada
+    int pasos;          // Resultado: pasos del camino más corto (-1 sin camino)
+    int* camino;        // Con caminos: pasos + 1 nodos de origen a destino
+} consulta_ruta;
+
+/*
+ * resumen_lote - Cómo se resolvió un lote
+ */
+typedef struct {
+    int hilos;              // Hilos usados
+    int grupos;             // Orígenes distintos (un BFS por grupo)
+    long long visitados;    // Nodos sacados de la cola en total
+    int* nodos_caminos;     // Bloque de todos los caminos (liberar_memoria)
+} resumen_lote;
+
+// ============================================================================
+// PROTOTIPOS DE FUNCIONES
+// ============================================================================
+
+/* Vecinos y recorridos */
+void calcular_vecinos(laberinto* lab, unsigned char* vecinos);
+void recorrer_anchura_vecinos(const unsigned char* vecinos, int origen,
+                              int* distancia, int* anterior, int* cola);
+
+/* Lotes */
+int resolver_lote_consultas(laberinto* lab, consulta_ruta* consultas, int cantidad,
+                            int hilos, int con_camino, resumen_lote* resumen);
+int hilos_disponibles(void);
+
+#endif // CONSULTAS_H
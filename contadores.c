@@ -0,0 +1,114 @@
+/*
+ * contadores.c
+ * Contadores de instrumentación por hilo, su total y su impresión.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <pthread.h>
+#include "contadores.h"
+
+#ifdef INSTRUMENTAR
+LOCAL_HILO contadores_algoritmo contadores_hilo;       // Del hilo, sin volcar
+static contadores_algoritmo contadores_volcados;        // De hilos que ya volcaron
+static pthread_mutex_t candado_contadores = PTHREAD_MUTEX_INITIALIZER;
+
+/*
+ * sumar_contadores
+ * destino += origen, campo a campo (todos son uint64_t).
+ */
+static void sumar_contadores(contadores_algoritmo* destino, const contadores_algoritmo* origen) {
+    uint64_t* d = (uint64_t*)destino;
+    const uint64_t* o = (const uint64_t*)origen;
+
+    for (size_t i = 0; i < sizeof(*destino) / sizeof(uint64_t); i++) d[i] += o[i];
+}
+#endif
+
+static const char* nombres_fases[NUM_FASES] = {
+    "generación", "conversión", "búsqueda", "reconstrucción", "árbol"
+};
+
+/*
+ * instrumentacion_activa
+ * 1 si el programa se compiló con contadores.
+ */
+int instrumentacion_activa(void) {
+#ifdef INSTRUMENTAR
+    return 1;
+#else
+    return 0;
+#endif
+}
+
+/*
+ * reiniciar_contadores
+ * Pone en cero el total volcado y los contadores del hilo que llama.
+ */
+void reiniciar_contadores(void) {
+#ifdef INSTRUMENTAR
+    pthread_mutex_lock(&candado_contadores);
+    memset(&contadores_volcados, 0, sizeof(contadores_volcados));
+    pthread_mutex_unlock(&candado_contadores);
+    memset(&contadores_hilo, 0, sizeof(contadores_hilo));
+#endif
+}
+
+/*
+ * obtener_contadores
+ * Copia el total volcado más los contadores del hilo que llama
+ * (todo cero sin instrumentación).
+ */
+void obtener_contadores(contadores_algoritmo* destino) {
+#ifdef INSTRUMENTAR
+    pthread_mutex_lock(&candado_contadores);
+    *destino = contadores_volcados;
+    pthread_mutex_unlock(&candado_contadores);
+    sumar_contadores(destino, &contadores_hilo);
+#else
+    memset(destino, 0, sizeof(*destino));
+#endif
+}
+
+/*
+ * volcar_contadores_hilo
+ * Suma los contadores del hilo que llama al total y los pone en cero.
+ * La llama cada hilo de trabajo antes de terminar.
+ */
+void volcar_contadores_hilo(void) {
+#ifdef INSTRUMENTAR
+    pthread_mutex_lock(&candado_contadores);
+    sumar_contadores(&contadores_volcados, &contadores_hilo);
+    pthread_mutex_unlock(&candado_contadores);
+    memset(&contadores_hilo, 0, sizeof(contadores_hilo));
+#endif
+}
+
+/*
+ * imprimir_contadores
+ * Muestra los contadores distintos de cero y el tiempo de cada fase.
+ */
+void imprimir_contadores(const char* titulo, const contadores_algoritmo* c) {
+    const struct { const char* nombre; uint64_t valor; } filas[] = {
+        {"Nodos expandidos",    c->nodos_expandidos},
+        {"Aristas examinadas",  c->aristas_examinadas},
+        {"Aristas relajadas",   c->aristas_relajadas},
+        {"Operaciones de cola", c->operaciones_cola},
+        {"Búsquedas (UF)",      c->busquedas_conjunto},
+        {"Uniones (UF)",        c->uniones_conjunto},
+        {"Apilados DFS",        c->apilados_dfs},
+        {"Celdas excavadas",    c->celdas_excavadas},
+    };
+    
+    printf("%s\n", titulo);
+    for (size_t i = 0; i < sizeof(filas) / sizeof(filas[0]); i++) {
+        if (filas[i].valor > 0) {
+            printf("  %-22s %12llu\n", filas[i].nombre, (unsigned long long)filas[i].valor);
+        }
+    }
+    for (int f = 0; f < NUM_FASES; f++) {
+        if (c->tiempo_fase[f] > 0) {
+            printf("  Tiempo %-15s %10.1f µs\n", nombres_fases[f], c->tiempo_fase[f] / 1000.0);
+        }
+    }
+}
@@ -0,0 +1,88 @@
+/*
+ * contadores.h
+ * Contadores de instrumentación para generadores y solucionadores.
+ * Solo existen al compilar con -DINSTRUMENTAR (o 'make debug', que
+ * define DEBUG); sin la bandera las macros no generan código. Cada hilo
+ * cuenta en su propia copia; los hilos de trabajo la vuelcan al total
+ * con volcar_contadores_hilo antes de terminar.
+ */
+
+#ifndef CONTADORES_H
+#define CONTADORES_H
+
+#include <stdint.h>
+
+#if defined(DEBUG) && !defined(INSTRUMENTAR)
+#define INSTRUMENTAR
+#endif
+
+// ============================================================================
+// ESTRUCTURA DE CONTADORES
+// ============================================================================
+
+// Fases con temporizador propio
+#define FASE_GENERACION 0       // Generación de celdas
+#define FASE_CONVERSION 1       // Laberinto → grafo
+#define FASE_BUSQUEDA 2         // Dijkstra / BFS
+#define FASE_RECONSTRUCCION 3   // Camino desde los anteriores
+#define FASE_ARBOL 4            // Prim / Kruskal
+#define NUM_FASES 5
+
+/*
+ * contadores_algoritmo - Operaciones contadas desde el último reinicio
+ */
+typedef struct {
+    uint64_t nodos_expandidos;      // Nodos extraídos y procesados
+    uint64_t aristas_examinadas;    // Aristas miradas desde un nodo expandido
+    uint64_t aristas_relajadas;     // Aristas que mejoraron una distancia
+    uint64_t operaciones_cola;      // Inserciones, extracciones y mejoras
+    uint64_t busquedas_conjunto;    // Llamadas a encontrar (con recursión)
+    uint64_t uniones_conjunto;      // Uniones efectivas de conjuntos
+    uint64_t apilados_dfs;          // Celdas apiladas por DFS
+    uint64_t celdas_excavadas;      // Paredes convertidas en camino
+    uint64_t tiempo_fase[NUM_FASES];    // Nanosegundos por fase
+} contadores_algoritmo;
+
+// ============================================================================
+// MACROS DE INSTRUMENTACIÓN
+// ============================================================================
+
+#ifdef INSTRUMENTAR
+
+#include "medicion.h"
+
+// _Thread_local es C11; con -std=c99 se usa la extensión de GCC/Clang
+#if defined(__GNUC__) && __STDC_VERSION__ < 201112L
+#define LOCAL_HILO __thread
+#else
+#define LOCAL_HILO _Thread_local
+#endif
+
+extern LOCAL_HILO contadores_algoritmo contadores_hilo;
+
+#define CONTAR(campo) (contadores_hilo.campo++)
+#define CONTAR_N(campo, n) (contadores_hilo.campo += (uint64_t)(n))
+#define INICIAR_FASE(marca) uint64_t marca = reloj_ns()
+#define TERMINAR_FASE(fase, marca) \
+    (contadores_hilo.tiempo_fase[fase] += reloj_ns() - (marca))
+
+#else
+
+#define CONTAR(campo) ((void)0)
+#define CONTAR_N(campo, n) ((void)0)
+#define INICIAR_FASE(marca) ((void)0)
+#define TERMINAR_FASE(fase, marca) ((void)0)
+
+#endif
+
+// ============================================================================
+// PROTOTIPOS DE FUNCIONES
+// ============================================================================
+
+int instrumentacion_activa(void);
+void reiniciar_contadores(void);
+void obtener_contadores(contadores_algoritmo* destino);
+void volcar_contadores_hilo(void);
+void imprimir_contadores(const char* titulo, const contadores_algoritmo* c);
+
+#endif // CONTADORES_H
@@ -0,0 +1,502 @@
+/*
+ * contraccion.c
+ * Contracción de pasillos en un grafo de nodos clave.
+ * Un recorrido O(celdas) sigue cada pasillo desde sus extremos. El grafo
+ * queda como lista de adyacencia (incidentes de cada nodo clave), así que
+ * ocupa O(celdas) y Dijkstra, Kruskal y Floyd-Warshall trabajan sobre un
+ * grafo mucho menor.
+ */
+
+#include <stdlib.h>
+#include "contraccion.h"
+#include "consultas.h"
+#include "algoritmos.h"
+#include "memoria.h"
+
+// ==================== CONSTRUCCIÓN ====================
+
+/*
+ * es_clave
+ * Una celda abierta es nodo clave si no tiene exactamente dos vecinos
+ * o si es INICIO, FINAL o alguna de las celdas forzadas.
+ */
+static int es_clave(laberinto* lab, const unsigned char* vecinos, int nodo,
+                    const int* forzados, int num_forzados) {
+    int tipo = lab->celdas[nodo / COLUMNAS][nodo % COLUMNAS];
+    if (tipo == PARED) return 0;
+    if (tipo == INICIO || tipo == FINAL) return 1;
+
+    int grado = 0;
+    for (int d = 0; d < 4; d++) {
+        if (vecinos[nodo] & (1 << d)) grado++;
+    }
+    if (grado != 2) return 1;
+
+    for (int k = 0; k < num_forzados; k++) {
+        if (forzados[k] == nodo) return 1;
+    }
+    return 0;
+}
+
+/*
+ * seguir_pasillo
+ * Avanza desde el nodo clave desde en la dirección dada hasta el
+ * siguiente nodo clave y retorna la celda de llegada. Deja en ultima la
+ * celda anterior a la llegada y, si interiores no es NULL, escribe allí
+ * las celdas interiores.
+ */
+static int seguir_pasillo(const grafo_contraido* contraido, const unsigned char* vecinos,
+                          int desde, int direccion, int* interiores, int* num_interiores,
+                          int* ultima) {
+    int previa = desde;
+    int actual = desde + PASO_VECINO(direccion);
+    *num_interiores = 0;
+
+    while (contraido->clave_de_celda[actual] < 0) {
+        if (interiores != NULL) interiores[*num_interiores] = actual;
+        (*num_interiores)++;
+        for (int d = 0; d < 4; d++) {
+            int siguiente = actual + PASO_VECINO(d);
+            if ((vecinos[actual] & (1 << d)) && siguiente != previa) {
+                previa = actual;
+                actual = siguiente;
+                break;
+            }
+        }
+    }
+    *ultima = previa;
+    return actual;
+}
+
+/*
+ * agregar_pasillo
+ * Registra el pasillo cuyas celdas ya están al final de celdas_pasillos.
+ */
+static void agregar_pasillo(grafo_contraido* contraido, int a, int b, int interiores,
+                            int* usadas) {
+    pasillo* p = &contraido->pasillos[contraido->num_pasillos];
+    p->extremo_a = a;
+    p->extremo_b = b;
+    p->peso = interiores + 1;
+    p->primera = *usadas;
+    *usadas += interiores;
+
+    contraido->incidentes[a][contraido->grado[a]++] = contraido->num_pasillos;
+    contraido->incidentes[b][contraido->grado[b]++] = contraido->num_pasillos;
+    contraido->num_pasillos++;
+}
+
+/*
+ * contraer_laberinto
+ * Construye el grafo contraído. Las celdas forzadas (por ejemplo los
+ * extremos de una consulta) quedan como nodos clave aunque estén dentro
+ * de un pasillo. Retorna NULL si falta memoria.
+ */
+grafo_contraido* contraer_laberinto(laberinto* lab, const int* forzados, int num_forzados) {
+    grafo_contraido* contraido = (grafo_contraido*)reservar_memoria(MEM_GRAFO,
+                                                                   sizeof(grafo_contraido));
+    unsigned char* vecinos = (unsigned char*)reservar_memoria(MEM_ALGORITMOS, 2 * MAX_NODOS);
+    if (contraido == NULL || vecinos == NULL) {
+        liberar_memoria(contraido);
+        liberar_memoria(vecinos);
+        return NULL;
+    }
+    unsigned char* cubierta = vecinos + MAX_NODOS;     // Celda ya asignada a un pasillo
+
+    contraido->num_clave = 0;
+    contraido->num_pasillos = 0;
+    contraido->celdas_abiertas = 0;
+    contraido->pasillos = NULL;
+
+    calcular_vecinos(lab, vecinos);
+    for (int n = 0; n < MAX_NODOS; n++) {
+        cubierta[n] = 0;
+        contraido->clave_de_celda[n] = -1;
+        if (lab->celdas[n / COLUMNAS][n % COLUMNAS] != PARED) contraido->celdas_abiertas++;
+        if (es_clave(lab, vecinos, n, forzados, num_forzados)) {
+            contraido->clave_de_celda[n] = contraido->num_clave;
+            contraido->celda_clave[contraido->num_clave] = n;
+            contraido->grado[contraido->num_clave] = 0;
+            contraido->num_clave++;
+        }
+    }
+
+    // Cada nodo clave tiene a lo sumo 4 pasillos y cada pasillo toca 2 veces;
+    // los ciclos sin nodos clave suman uno más por celda como máximo
+    int capacidad = 2 * contraido->num_clave + contraido->celdas_abiertas + 1;
+    contraido->pasillos = (pasillo*)reservar_memoria(MEM_GRAFO, capacidad * sizeof(pasillo));
+    if (contraido->pasillos == NULL) {
+        liberar_memoria(vecinos);
+        destruir_grafo_contraido(contraido);
+        return NULL;
+    }
+
+    // Cada pasillo se recorre desde sus dos extremos y se guarda una vez:
+    // desde el nodo de menor índice, o en un ciclo, por su celda menor.
+    // La primera pasada solo mira la llegada; la segunda copia las celdas
+    int usadas = 0;
+    for (int a = 0; a < contraido->num_clave; a++) {
+        int celda = contraido->celda_clave[a];
+        for (int d = 0; d < 4; d++) {
+            if (!(vecinos[celda] & (1 << d))) continue;
+
+            int interiores, ultima;
+            int llegada = seguir_pasillo(contraido, vecinos, celda, d, NULL, &interiores, &ultima);
+            int b = contraido->clave_de_celda[llegada];
+            if (a > b || (a == b && celda + PASO_VECINO(d) > ultima)) continue;
+
+            int* destino = contraido->celdas_pasillos + usadas;
+            seguir_pasillo(contraido, vecinos, celda, d, destino, &interiores, &ultima);
+            for (int k = 0; k < interiores; k++) cubierta[destino[k]] = 1;
+            agregar_pasillo(contraido, a, b, interiores, &usadas);
+        }
+    }
+
+    // Ciclos de celdas de grado 2 sin nodos clave: una celda pasa a serlo
+    for (int n = 0; n < MAX_NODOS; n++) {
+        if (vecinos[n] == 0 || cubierta[n] || contraido->clave_de_celda[n] >= 0) continue;
+
+        int a = contraido->num_clave++;
+        contraido->clave_de_celda[n] = a;
+        contraido->celda_clave[a] = n;
+        contraido->grado[a] = 0;
+
+        int d = 0;
+        while (!(vecinos[n] & (1 << d))) d++;
+        int interiores, ultima;
+        int* destino = contraido->celdas_pasillos + usadas;
+        seguir_pasillo(contraido, vecinos, n, d, destino, &interiores, &ultima);
+        for (int k = 0; k < interiores; k++) cubierta[destino[k]] = 1;
+        agregar_pasillo(contraido, a, a, interiores, &usadas);
+    }
+
+    liberar_memoria(vecinos);
+    return contraido;
+}
+
+/*
+ * destruir_grafo_contraido
+ * Libera el grafo contraído y sus bloques (admite NULL).
+ */
+void destruir_grafo_contraido(grafo_contraido* contraido) {
+    if (contraido == NULL) return;
+    liberar_memoria(contraido->pasillos);
+    liberar_memoria(contraido);
+}
+
+// ==================== CAMINOS ====================
+
+/*
+ * pasillo_mas_corto
+ * Pasillo de menor peso entre los nodos clave a y b (-1 si no hay).
+ */
+static int pasillo_mas_corto(const grafo_contraido* contraido, int a, int b) {
+    int mejor = -1;
+
+    for (int k = 0; k < contraido->grado[a]; k++) {
+        const pasillo* p = &contraido->pasillos[contraido->incidentes[a][k]];
+        int otro = (p->extremo_a == a) ? p->extremo_b : p->extremo_a;
+        if (otro != b || p->extremo_a == p->extremo_b) continue;
+        if (mejor < 0 || p->peso < contraido->pasillos[mejor].peso) {
+            mejor = contraido->incidentes[a][k];
+        }
+    }
+    return mejor;
+}
+
+/*
+ * expandir_camino_contraido
+ * Convierte una secuencia de nodos clave adyacentes en celdas, tomando
+ * el pasillo más corto entre cada par. camino necesita MAX_NODOS
+ * lugares; retorna las celdas escritas o 0 si dos claves no son vecinas.
+ */
+int expandir_camino_contraido(const grafo_contraido* contraido, const int* claves,
+                              int num_claves, int* camino) {
+    int longitud = 0;
+    if (num_claves <= 0) return 0;
+
+    for (int i = 0; i + 1 < num_claves; i++) {
+        int u = claves[i], v = claves[i + 1];
+        int k = pasillo_mas_corto(contraido, u, v);
+        if (k < 0) return 0;
+
+        const pasillo* p = &contraido->pasillos[k];
+        const int* celdas = contraido->celdas_pasillos + p->primera;
+        int interiores = p->peso - 1;
+
+        camino[longitud++] = contraido->celda_clave[u];
+        for (int j = 0; j < interiores; j++) {
+            camino[longitud++] = (p->extremo_a == u) ? celdas[j] : celdas[interiores - 1 - j];
+        }
+    }
+    camino[longitud++] = contraido->celda_clave[claves[num_claves - 1]];
+    return longitud;
+}
+
+/*
+ * dijkstra_contraido
+ * Dijkstra con montículo sobre los incidentes de cada nodo clave, de a
+ * hasta b. Deja en anterior el nodo clave previo (-1 en a) y retorna la
+ * distancia, -1 sin camino o -2 sin memoria.
+ */
+static int dijkstra_contraido(const grafo_contraido* contraido, int a, int b, int* anterior) {
+    int* costo = (int*)reservar_memoria(MEM_ALGORITMOS, contraido->num_clave * sizeof(int));
+    monticulo abiertos;
+    if (costo == NULL) return -2;
+    if (!crear_monticulo(&abiertos, contraido->num_clave)) {
+        liberar_memoria(costo);
+        return -2;
+    }
+
+    for (int v = 0; v < contraido->num_clave; v++) {
+        costo[v] = INFINITO;
+        anterior[v] = -1;
+    }
+    costo[a] = 0;
+    insertar_o_mejorar(&abiertos, a, 0);
+
+    int distancia = -1;
+    while (abiertos.tamano > 0) {
+        int u = extraer_minimo(&abiertos);
+        if (u == b) {
+            distancia = costo[u];
+            break;
+        }
+        for (int k = 0; k < contraido->grado[u]; k++) {
+            const pasillo* p = &contraido->pasillos[contraido->incidentes[u][k]];
+            int v = (p->extremo_a == u) ? p->extremo_b : p->extremo_a;
+            if (v == u || costo[u] + p->peso >= costo[v]) continue;
+            costo[v] = costo[u] + p->peso;
+            anterior[v] = u;
+            insertar_o_mejorar(&abiertos, v, costo[v]);
+        }
+    }
+
+    destruir_monticulo(&abiertos);
+    liberar_memoria(costo);
+    return distancia;
+}
+
+/*
+ * camino_contraido
+ * Dijkstra entre las celdas origen y destino, que deben ser nodos clave
+ * (INICIO, FINAL o forzadas al contraer). Retorna las celdas del camino
+ * expandido o 0 si no hay camino.
+ */
+int camino_contraido(const grafo_contraido* contraido, int origen, int destino, int* camino) {
+    if (origen < 0 || origen >= MAX_NODOS || destino < 0 || destino >= MAX_NODOS) return 0;
+
+    int a = contraido->clave_de_celda[origen];
+    int b = contraido->clave_de_celda[destino];
+    if (a < 0 || b < 0) return 0;
+    if (a == b) {
+        camino[0] = origen;
+        return 1;
+    }
+
+    int* anterior = (int*)reservar_memoria(MEM_ALGORITMOS, 2 * contraido->num_clave * sizeof(int));
+    if (anterior == NULL) return 0;
+    if (dijkstra_contraido(contraido, a, b, anterior) < 0) {
+        liberar_memoria(anterior);
+        return 0;
+    }
+    int* claves = anterior + contraido->num_clave;
+
+    // De b hacia a por los anteriores y luego al derecho
+    int num_claves = 0;
+    for (int v = b; v != -1; v = anterior[v]) claves[num_claves++] = v;
+    for (int i = 0; i < num_claves / 2; i++) {
+        int temp = claves[i];
+        claves[i] = claves[num_claves - 1 - i];
+        claves[num_claves - 1 - i] = temp;
+    }
+
+    int longitud = expandir_camino_contraido(contraido, claves, num_claves, camino);
+    liberar_memoria(anterior);
+    return longitud;
+}
+
+// ==================== ÁRBOL Y CAMINO CRÍTICO ====================
+
+/*
+ * arbol_contraido
+ * Árbol generador mínimo con Kruskal sobre los pasillos (sin los que
+ * vuelven a su nodo). Se libera con liberar_aristas; NULL sin memoria.
+ */
+arista* arbol_contraido(const grafo_contraido* contraido, int* num_aristas) {
+    arista* aristas = (arista*)reservar_memoria(MEM_ALGORITMOS,
+                                                (contraido->num_pasillos + 1) * sizeof(arista));
+    *num_aristas = 0;
+    if (aristas == NULL) return NULL;
+
+    int total = 0;
+    for (int k = 0; k < contraido->num_pasillos; k++) {
+        const pasillo* p = &contraido->pasillos[k];
+        if (p->extremo_a == p->extremo_b) continue;
+        aristas[total].origen = p->extremo_a;
+        aristas[total].destino = p->extremo_b;
+        aristas[total].peso = p->peso;
+        total++;
+    }
+
+    arista* arbol = kruskal_aristas(aristas, total, contraido->num_clave, num_aristas);
+    liberar_memoria(aristas);
+    return arbol;
+}
+
+/*
+ * distancias_entre_claves
+ * Matriz num_clave x num_clave con el pasillo más corto entre cada par
+ * y cerrada con Floyd-Warshall. Se libera con liberar_matriz_adyacencia.
+ */
+static int** distancias_entre_claves(const grafo_contraido* contraido) {
+    int n = contraido->num_clave;
+    int** distancias = (int**)reservar_memoria(MEM_ALGORITMOS, (n ? n : 1) * sizeof(int*));
+    if (distancias == NULL) return NULL;
+
+    for (int i = 0; i < n; i++) {
+        distancias[i] = (int*)reservar_memoria(MEM_ALGORITMOS, n * sizeof(int));
+        if (distancias[i] == NULL) {
+            liberar_matriz_adyacencia(distancias, i);
+            return NULL;
+        }
+        for (int j = 0; j < n; j++) distancias[i][j] = (i == j) ? 0 : INFINITO;
+    }
+
+    for (int k = 0; k < contraido->num_pasillos; k++) {
+        const pasillo* p = &contraido->pasillos[k];
+        int a = p->extremo_a, b = p->extremo_b;
+        if (a != b && p->peso < distancias[a][b]) {
+            distancias[a][b] = p->peso;
+            distancias[b][a] = p->peso;
+        }
+    }
+
+    floyd_warshall_en_sitio(distancias, n);
+    return distancias;
+}
+
+/*
+ * celda_interior
+ * Celda a s pasos de extremo_a dentro del pasillo (0 < s < peso).
+ */
+static int celda_interior(const grafo_contraido* contraido, const pasillo* p, int s) {
+    return contraido->celdas_pasillos[p->primera + s - 1];
+}
+
+/*
+ * distancia_interior
+ * De la celda a s pasos dentro de p al nodo clave v: se sale por uno de
+ * los dos extremos. INFINITO si no hay camino.
+ */
+static int distancia_interior(int** distancias, const pasillo* p, int s, int v) {
+    int por_a = distancias[p->extremo_a][v];
+    int por_b = distancias[p->extremo_b][v];
+    if (por_a != INFINITO) por_a += s;
+    if (por_b != INFINITO) por_b += p->peso - s;
+    return (por_a < por_b) ? por_a : por_b;
+}
+
+/*
+ * mas_lejana_en_tramo
+ * Máximo de min(hasta_c + t, hasta_d + largo - t) para t entre minimo y
+ * largo - 1 (INFINITO = no se llega por ese lado); deja en t dónde se
+ * alcanza. Son dos rectas, así que basta mirar junto a su cruce.
+ * Retorna -1 si el tramo está vacío o no se llega.
+ */
+static int mas_lejana_en_tramo(int hasta_c, int hasta_d, int largo, int minimo, int* t) {
+    int maximo = largo - 1;
+    if (minimo > maximo || (hasta_c == INFINITO && hasta_d == INFINITO)) return -1;
+    if (hasta_c == INFINITO) {
+        *t = minimo;
+        return hasta_d + largo - minimo;
+    }
+    if (hasta_d == INFINITO) {
+        *t = maximo;
+        return hasta_c + maximo;
+    }
+
+    int diferencia = hasta_d + largo - hasta_c;
+    int cruce = (diferencia >= 0) ? diferencia / 2 : -((1 - diferencia) / 2);
+    int mejor = -1;
+    for (int candidato = cruce; candidato <= cruce + 1; candidato++) {
+        int u = (candidato < minimo) ? minimo : (candidato > maximo) ? maximo : candidato;
+        int por_c = hasta_c + u, por_d = hasta_d + largo - u;
+        int valor = (por_c < por_d) ? por_c : por_d;
+        if (valor > mejor) {
+            mejor = valor;
+            *t = u;
+        }
+    }
+    return mejor;
+}
+
+/*
+ * diametro_contraido
+ * Camino crítico de todas las celdas con Floyd-Warshall solo entre nodos
+ * clave. Las celdas interiores se miden después contra esas distancias:
+ * en un ciclo la más lejana puede quedar a mitad de un pasillo.
+ * Retorna la distancia (-1 sin memoria) y sus celdas extremas.
+ */
+int diametro_contraido(const grafo_contraido* contraido, int* celda_a, int* celda_b) {
+    int** distancias = distancias_entre_claves(contraido);
+    if (distancias == NULL) return -1;
+
+    int mejor = 0;
+    *celda_a = -1;
+    *celda_b = -1;
+
+    for (int i = 0; i < contraido->num_clave; i++) {
+        for (int j = i + 1; j < contraido->num_clave; j++) {
+            if (distancias[i][j] != INFINITO && distancias[i][j] > mejor) {
+                mejor = distancias[i][j];
+                *celda_a = contraido->celda_clave[i];
+                *celda_b = contraido->celda_clave[j];
+            }
+        }
+    }
+
+    // Cada celda interior contra nodos clave, contra los pasillos
+    // siguientes y contra su propio pasillo rodeando por fuera
+    for (int i = 0; i < contraido->num_pasillos; i++) {
+        const pasillo* p = &contraido->pasillos[i];
+        int rodeo = distancias[p->extremo_a][p->extremo_b];
+
+        for (int s = 1; s < p->peso; s++) {
+            int x = celda_interior(contraido, p, s);
+
+            for (int v = 0; v < contraido->num_clave; v++) {
+                int d = distancia_interior(distancias, p, s, v);
+                if (d != INFINITO && d > mejor) {
+                    mejor = d;
+                    *celda_a = x;
+                    *celda_b = contraido->celda_clave[v];
+                }
+            }
+
+            for (int j = i + 1; j < contraido->num_pasillos; j++) {
+                const pasillo* q = &contraido->pasillos[j];
+                int t;
+                int d = mas_lejana_en_tramo(distancia_interior(distancias, p, s, q->extremo_a),
+                                            distancia_interior(distancias, p, s, q->extremo_b),
+                                            q->peso, 1, &t);
+                if (d > mejor) {
+                    mejor = d;
+                    *celda_a = x;
+                    *celda_b = celda_interior(contraido, q, t);
+                }
+            }
+
+            int t;
+            int d = mas_lejana_en_tramo(-s, s + rodeo, p->peso, s + 1, &t);
+            if (d > mejor) {
+                mejor = d;
+                *celda_a = x;
+                *celda_b = celda_interior(contraido, p, t);
+            }
+        }
+    }
+
+    liberar_matriz_adyacencia(distancias, contraido->num_clave);
+    return mejor;
+}
@@ -0,0 +1,63 @@
+/*
+ * contraccion.h
+ * Grafo de pasillos contraído: los pasillos de celdas con dos vecinos
+ * abiertos se reducen a una arista con peso entre nodos clave (cruces,
+ * callejones sin salida, INICIO y FINAL). Guarda las celdas de cada
+ * pasillo para volver a expandir los caminos.
+ */
+
+#ifndef CONTRACCION_H
+#define CONTRACCION_H
+
+#include "laberinto.h"
+#include "grafo.h"
+
+// ============================================================================
+// DEFINICIONES DEL GRAFO CONTRAÍDO
+// ============================================================================
+
+/*
+ * pasillo - Celdas de grado 2 entre dos nodos clave
+ * Las celdas interiores van de extremo_a hacia extremo_b. Un pasillo que
+ * vuelve a su nodo (extremo_a == extremo_b) no entra en la matriz.
+ */
+typedef struct {
+    int extremo_a;      // Nodo clave de un extremo
+    int extremo_b;      // Nodo clave del otro extremo
+    int peso;           // Pasos de un extremo al otro (interiores + 1)
+    int primera;        // Primera celda interior en celdas_pasillos
+} pasillo;
+
+/*
+ * grafo_contraido - Nodos clave y pasillos
+ * Los pasillos son las aristas; incidentes[a][0..grado[a]) es la lista
+ * de adyacencia de cada nodo clave. Todo ocupa O(celdas): no hay matriz.
+ */
+typedef struct {
+    int num_clave;                      // Nodos del grafo contraído
+    int num_pasillos;                   // Pasillos (aristas con sus celdas)
+    int celdas_abiertas;                // Celdas transitables del laberinto
+    int celda_clave[MAX_NODOS];         // Nodo de celdas de cada nodo clave
+    int clave_de_celda[MAX_NODOS];      // Nodo clave de cada celda (-1 si no lo es)
+    int grado[MAX_NODOS];               // Pasillos que tocan cada nodo clave
+    int incidentes[MAX_NODOS][4];       // Índices de esos pasillos
+    int celdas_pasillos[MAX_NODOS];     // Celdas interiores de todos los pasillos
+    pasillo* pasillos;                  // Pasillos encontrados
+} grafo_contraido;
+
+// ============================================================================
+// PROTOTIPOS DE FUNCIONES
+// ============================================================================
+
+/* Construcción */
+grafo_contraido* contraer_laberinto(laberinto* lab, const int* forzados, int num_forzados);
+void destruir_grafo_contraido(grafo_contraido* contraido);
+
+/* Caminos y medidas sobre el grafo contraído */
+int expandir_camino_contraido(const grafo_contraido* contraido, const int* claves,
+                              int num_claves, int* camino);
+int camino_contraido(const grafo_contraido* contraido, int origen, int destino, int* camino);
+arista* arbol_contraido(const grafo_contraido* contraido, int* num_aristas);
+int diametro_contraido(const grafo_contraido* contraido, int* celda_a, int* celda_b);
+
+#endif // CONTRACCION_H
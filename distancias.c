@@ -0,0 +1,127 @@
+/*
+ * distancias.c
+ * Campo de distancias y direcciones hacia FINAL.
+ * Se calcula una vez por laberinto con un BFS inverso desde la salida
+ * (todas las aristas pesan 1, así que coincide con Dijkstra).
+ */
+
+#include <stdlib.h>
+#include "distancias.h"
+#include "consultas.h"
+#include "memoria.h"
+
+// ==================== CAMPO ====================
+
+/*
+ * buscar_salida
+ * Nodo de la celda FINAL o -1 si el laberinto no tiene.
+ */
+static int buscar_salida(laberinto* lab) {
+    for (int i = 0; i < lab->filas; i++) {
+        for (int j = 0; j < lab->columnas; j++) {
+            if (lab->celdas[i][j] == FINAL) return i * COLUMNAS + j;
+        }
+    }
+    return -1;
+}
+
+/*
+ * preparar_campo_distancias
+ * Calcula distancia_final y direccion_final si no están al día.
+ * Retorna 0 solo si falta memoria para el recorrido.
+ */
+int preparar_campo_distancias(laberinto* lab) {
+    if (lab->campo_valido) return 1;
+
+    // Vecinos, árbol y cola en un solo bloque
+    size_t bytes = MAX_NODOS * (2 * sizeof(int) + 1);
+    int* anterior = (int*)reservar_memoria(MEM_ALGORITMOS, bytes);
+    if (anterior == NULL) return 0;
+    int* cola = anterior + MAX_NODOS;
+    unsigned char* vecinos = (unsigned char*)(cola + MAX_NODOS);
+
+    for (int k = 0; k < (MAX_NODOS + 3) / 4; k++) lab->direccion_final[k] = 0;
+
+    int salida = buscar_salida(lab);
+    if (salida < 0) {
+        for (int n = 0; n < MAX_NODOS; n++) lab->distancia_final[n] = -1;
+    } else {
+        calcular_vecinos(lab, vecinos);
+        recorrer_anchura_vecinos(vecinos, salida, lab->distancia_final, anterior, cola);
+
+        // El padre en el árbol es el vecino un paso más cerca de FINAL
+        for (int n = 0; n < MAX_NODOS; n++) {
+            if (anterior[n] < 0) continue;
+            for (int d = 0; d < 4; d++) {
+                if (n + PASO_VECINO(d) == anterior[n]) {
+                    lab->direccion_final[n >> 2] |= (unsigned char)(d << ((n & 3) * 2));
+                    break;
+                }
+            }
+        }
+    }
+
+    liberar_memoria(anterior);
+    lab->campo_valido = 1;
+    return 1;
+}
+
+/*
+ * invalidar_campo_distancias
+ * Marca el campo para recalcular tras modificar celdas.
+ */
+void invalidar_campo_distancias(laberinto* lab) {
+    lab->campo_valido = 0;
+}
+
+// ==================== CONSULTAS ====================
+
+/*
+ * distancia_a_salida
+ * Pasos de nodo a FINAL; -1 en paredes, fuera de rango o sin camino.
+ */
+int distancia_a_salida(laberinto* lab, int nodo) {
+    if (nodo < 0 || nodo >= MAX_NODOS || !preparar_campo_distancias(lab)) return -1;
+    return lab->distancia_final[nodo];
+}
+
+/*
+ * direccion_a_salida
+ * Vecino (VECINO_*) por el que sigue el camino más corto a FINAL.
+ */
+int direccion_a_salida(laberinto* lab, int nodo) {
+    if (distancia_a_salida(lab, nodo) <= 0) return SIN_DIRECCION;
+    return DIRECCION_CAMPO(lab, nodo);
+}
+
+/*
+ * camino_a_salida
+ * Sigue las direcciones desde nodo hasta FINAL en O(L).
+ * camino debe tener lugar para MAX_NODOS nodos; retorna los nodos
+ * escritos (distancia + 1) o 0 si no hay camino.
+ */
+int camino_a_salida(laberinto* lab, int nodo, int* camino) {
+    int pasos = distancia_a_salida(lab, nodo);
+    if (pasos < 0) return 0;
+
+    camino[0] = nodo;
+    for (int k = 1; k <= pasos; k++) {
+        nodo += PASO_VECINO(DIRECCION_CAMPO(lab, nodo));
+        camino[k] = nodo;
+    }
+    return pasos + 1;
+}
+
+/*
+ * nombre_direccion
+ * Nombre legible de una dirección VECINO_*.
+ */
+const char* nombre_direccion(int direccion) {
+    switch (direccion) {
+        case VECINO_NORTE: return "norte";
+        case VECINO_SUR: return "sur";
+        case VECINO_ESTE: return "este";
+        case VECINO_OESTE: return "oeste";
+        default: return "ninguna";
+    }
+}
@@ -0,0 +1,37 @@
+/*
+ * distancias.h
+ * Campo de distancias hasta la salida guardado en el laberinto.
+ * Un BFS inverso desde FINAL deja los pasos y la dirección a seguir
+ * en cada celda; pistas y caminos hacia la salida son consultas directas.
+ */
+
+#ifndef DISTANCIAS_H
+#define DISTANCIAS_H
+
+#include "laberinto.h"
+
+// ============================================================================
+// DEFINICIONES DEL CAMPO
+// ============================================================================
+
+#define SIN_DIRECCION -1    // En FINAL, en paredes o sin camino a la salida
+
+// Dirección (VECINO_*) guardada en 2 bits por celda
+#define DIRECCION_CAMPO(lab, nodo) \
+    (((lab)->direccion_final[(nodo) >> 2] >> (((nodo) & 3) * 2)) & 3)
+
+// ============================================================================
+// PROTOTIPOS DE FUNCIONES
+// ============================================================================
+
+/* Campo */
+int preparar_campo_distancias(laberinto* lab);
+void invalidar_campo_distancias(laberinto* lab);
+
+/* Consultas sobre el campo */
+int distancia_a_salida(laberinto* lab, int nodo);
+int direccion_a_salida(laberinto* lab, int nodo);
+int camino_a_salida(laberinto* lab, int nodo, int* camino);
+const char* nombre_direccion(int direccion);
+
+#endif // DISTANCIAS_H
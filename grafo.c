@@ -9,6 +9,33 @@
 #include <time.h>
 #include <string.h>
 #include "grafo.h"
+#include "contadores.h"
+#include "memoria.h"
+
+// ==================== NÚMEROS ALEATORIOS ====================
+
+static int semilla_fijada = 0;   // 1 si se llamó a fijar_semilla
+
+/*
+ * fijar_semilla
+ * Siembra rand() una sola vez con un valor conocido.
+ * Desde entonces los generadores continúan la misma secuencia.
+ */
+void fijar_semilla(unsigned int semilla) {
+    srand(semilla);
+    semilla_fijada = 1;
+}
+
+/*
+ * sembrar_aleatorio
+ * Resiembra con la hora al iniciar cada generador (comportamiento del menú).
+ * No hace nada si la semilla se fijó con fijar_semilla.
+ */
+void sembrar_aleatorio(void) {
+    if (!semilla_fijada) {
+        srand(time(NULL));
+    }
+}
 
 // ==================== GENERACIÓN DE GRAFOS CON CAMINO ====================
 
@@ -18,7 +45,7 @@
  * Añade conexiones aleatorias para caminos alternativos.
  */
 void generar_grafo_con_camino(grafo_matriz* grafo) {
-    srand(time(NULL));                    // Inicializa generador aleatorio
+    sembrar_aleatorio();                // Inicializa generador aleatorio
     
     int num_nodos = grafo->num_nodos;     // Obtiene tamaño del grafo
     
@@ -204,14 +231,14 @@ void agregar_arista_lista(grafo_lista* grafo, int origen, int destino, int peso)
     }
     
     // Agrega a lista del nodo origen
-    nodo_lista* nuevo = (nodo_lista*)malloc(sizeof(nodo_lista));
+    nodo_lista* nuevo = (nodo_lista*)reservar_memoria(MEM_GRAFO, sizeof(nodo_lista));
     nuevo->destino = destino;          // Nodo destino
     nuevo->peso = peso;                // Peso de la arista
     nuevo->siguiente = grafo->lista[origen];  // Inserta al inicio
     grafo->lista[origen] = nuevo;      // Actualiza cabeza de lista
     
     // Agrega a lista del nodo destino (grafo no dirigido)
-    nuevo = (nodo_lista*)malloc(sizeof(nodo_lista));
+    nuevo = (nodo_lista*)reservar_memoria(MEM_GRAFO, sizeof(nodo_lista));
     nuevo->destino = origen;           // Nodo origen
     nuevo->peso = peso;                // Mismo peso
     nuevo->siguiente = grafo->lista[destino];  // Inserta al inicio
@@ -242,7 +269,7 @@ void eliminar_arista_lista(grafo_lista* grafo, int origen, int destino) {
             // Está en medio de la lista
             anterior->siguiente = actual->siguiente;
         }
-        free(actual);    // Libera memoria
+        liberar_memoria(actual);    // Libera memoria
     }
     
     // Busca en lista del destino (conexión inversa)
@@ -263,7 +290,7 @@ void eliminar_arista_lista(grafo_lista* grafo, int origen, int destino) {
             // Está en medio de la lista
             anterior->siguiente = actual->siguiente;
         }
-        free(actual);    // Libera memoria
+        liberar_memoria(actual);    // Libera memoria
     }
 }
 
@@ -323,7 +350,7 @@ void liberar_grafo_lista(grafo_lista* grafo) {
         while (actual != NULL) {
             nodo_lista* temp = actual;     // Nodo a liberar
             actual = actual->siguiente;    // Avanza al siguiente
-            free(temp);                    // Libera memoria
+            liberar_memoria(temp);                    // Libera memoria
         }
         
         grafo->lista[i] = NULL;    // Lista vacía
@@ -350,6 +377,7 @@ void hacer_conjunto(conjunto_disjunto* cd, int x) {
  * Implementa compresión de caminos.
  */
 int encontrar(conjunto_disjunto* cd, int x) {
+    CONTAR(busquedas_conjunto);
     if (cd->padre[x] != x) {                          // No es el representante
         cd->padre[x] = encontrar(cd, cd->padre[x]);   // Compresión de caminos
     }
@@ -367,6 +395,8 @@ void unir(conjunto_disjunto* cd, int x, int y) {
     
     // Solo une si son diferentes conjuntos
     if (raiz_x != raiz_y) {
+        CONTAR(uniones_conjunto);
+        
         // Unión por rango
         if (cd->rango[raiz_x] < cd->rango[raiz_y]) {
             cd->padre[raiz_x] = raiz_y;    // Raíz_x bajo raíz_y
@@ -429,7 +459,7 @@ void lista_a_matriz(grafo_lista* origen, grafo_matriz* destino) {
  * Conecta vecinos con probabilidad configurable.
  */
 void generar_grafo_aleatorio(grafo_matriz* grafo) {
-    srand(time(NULL));    // Inicializa generador
+    sembrar_aleatorio(); // Inicializa generador
     
     // Conecta cada nodo con sus vecinos ortogonales
     for (int i = 0; i < FILAS; i++) {
@@ -482,7 +512,7 @@ void generar_grafo_aleatorio(grafo_matriz* grafo) {
  * Crea camino que visita todas las celdas.
  */
 void generar_grafo_backtracking(grafo_matriz* grafo) {
-    srand(time(NULL));    // Inicializa generador
+    sembrar_aleatorio(); // Inicializa generador
     
     int visitado[MAX_NODOS] = {0};    // Array de visitados
     int pila[MAX_NODOS];              // Pila para backtracking
@@ -492,6 +522,7 @@ void generar_grafo_backtracking(grafo_matriz* grafo) {
     int celda_inicial = rand() % grafo->num_nodos;
     pila[tope++] = celda_inicial;    // Empuja a la pila
     visitado[celda_inicial] = 1;     // Marca como visitado
+    CONTAR(apilados_dfs);
     
     while (tope > 0) {               // Mientras haya celdas en pila
         int celda_actual = pila[tope - 1];    // Tope de la pila
@@ -545,6 +576,7 @@ void generar_grafo_backtracking(grafo_matriz* grafo) {
             
             visitado[vecino] = 1;          // Marca como visitado
             pila[tope++] = vecino;         // Empuja a la pila
+            CONTAR(apilados_dfs);
         } else {
             tope--;    // Backtrack: retrocede en la pila
         }
@@ -590,4 +622,24 @@ void generar_grafo_cuadricula(grafo_matriz* grafo) {
             }
         }
     }
-}
\ No newline at end of file
+}
+/*
+ * generar_grafo_con_densidad
+ * Grafo conexo con el porcentaje indicado de todas las aristas posibles.
+ * Primero une cada nodo con uno anterior (árbol aleatorio), luego agrega el resto.
+ */
+void generar_grafo_con_densidad(grafo_matriz* grafo, int porcentaje) {
+    // Árbol aleatorio: garantiza que Prim y Kruskal vean un solo componente
+    for (int i = 1; i < grafo->num_nodos; i++) {
+        agregar_arista_matriz(grafo, i, rand() % i, rand() % 20 + 1);
+    }
+    
+    // Aristas adicionales con la probabilidad pedida
+    for (int i = 0; i < grafo->num_nodos; i++) {
+        for (int j = i + 1; j < grafo->num_nodos; j++) {
+            if (grafo->matriz[i][j] == 0 && rand() % 100 < porcentaje) {
+                agregar_arista_matriz(grafo, i, j, rand() % 20 + 1);    // Peso 1-20
+            }
+        }
+    }
+}
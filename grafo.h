@@ -73,11 +73,16 @@ void unir(conjunto_disjunto* cd, int x, int y);
 void matriz_a_lista(grafo_matriz* origen, grafo_lista* destino);
 void lista_a_matriz(grafo_lista* origen, grafo_matriz* destino);
 
+/* Números aleatorios */
+void fijar_semilla(unsigned int semilla);
+void sembrar_aleatorio(void);
+
 /* Generación de grafos */
 void generar_grafo_aleatorio(grafo_matriz* grafo);
 void generar_grafo_backtracking(grafo_matriz* grafo);
 void generar_grafo_completo(grafo_matriz* grafo);
 void generar_grafo_cuadricula(grafo_matriz* grafo);
+void generar_grafo_con_densidad(grafo_matriz* grafo, int porcentaje);
 void generar_grafo_con_camino(grafo_matriz* grafo);
 
 #endif // GRAFO_H
\ No newline at end of file
@@ -0,0 +1,416 @@
+/*
+ * hitos.c
+ * Elección de hitos por punto más lejano y heurística ALT. Sobre el
+ * grafo_matriz las distancias salen de Dijkstra (pesos cualesquiera);
+ * sobre las celdas del laberinto, de un BFS por hito. La tabla de las
+ * celdas se guarda en caché y responde A* sin armar la matriz.
+ */
+
+#include <string.h>
+#include "hitos.h"
+#include "algoritmos.h"
+#include "consultas.h"
+#include "memoria.h"
+
+/*
+ * recorrido_hitos - Cómo llenar la fila de distancias de un hito
+ */
+typedef struct {
+    int (*recorrer)(const void* datos, int origen, int* distancia);     // 0 sin memoria
+    const void* datos;                  // Grafo o vecinos del laberinto
+    const unsigned char* utilizable;    // Nodos que pueden ser hito
+} recorrido_hitos;
+
+// ==================== DISTANCIAS ====================
+
+/*
+ * distancias_grafo
+ * Dijkstra completo sobre la matriz de adyacencia.
+ * Retorna 0 si falta memoria.
+ */
+static int distancias_grafo(const void* datos, int origen, int* distancia) {
+    grafo_matriz* grafo = (grafo_matriz*)datos;
+    monticulo abiertos;
+
+    for (int i = 0; i < grafo->num_nodos; i++) distancia[i] = INFINITO;
+    if (!crear_monticulo(&abiertos, grafo->num_nodos)) return 0;
+    distancia[origen] = 0;
+    insertar_o_mejorar(&abiertos, origen, 0);
+
+    while (abiertos.tamano > 0) {
+        int u = extraer_minimo(&abiertos);
+        for (int v = 0; v < grafo->num_nodos; v++) {
+            int peso = grafo->matriz[u][v];
+            if (peso == 0 || distancia[u] + peso >= distancia[v]) continue;
+            distancia[v] = distancia[u] + peso;
+            insertar_o_mejorar(&abiertos, v, distancia[v]);
+        }
+    }
+    destruir_monticulo(&abiertos);
+    return 1;
+}
+
+/*
+ * distancias_laberinto
+ * BFS sobre las celdas; la propia fila marca las visitadas. Siempre
+ * retorna 1.
+ */
+static int distancias_laberinto(const void* datos, int origen, int* distancia) {
+    const unsigned char* vecinos = (const unsigned char*)datos;
+    int cola[MAX_NODOS];
+    int cabeza = 0, fin = 0;
+
+    for (int i = 0; i < MAX_NODOS; i++) distancia[i] = INFINITO;
+    distancia[origen] = 0;
+    cola[fin++] = origen;
+
+    while (cabeza < fin) {
+        int n = cola[cabeza++];
+        for (int d = 0; d < 4; d++) {
+            if (!(vecinos[n] & (1 << d))) continue;
+            int m = n + PASO_VECINO(d);
+            if (distancia[m] != INFINITO) continue;
+            distancia[m] = distancia[n] + 1;
+            cola[fin++] = m;
+        }
+    }
+    return 1;
+}
+
+// ==================== ELECCIÓN ====================
+
+/*
+ * elegir_hitos
+ * Punto más lejano: el primer hito es el nodo más alejado del primer
+ * nodo utilizable y cada uno de los siguientes el que más lejos queda
+ * de los ya elegidos (un nodo de otra componente cuenta como infinito).
+ * Retorna NULL si falta memoria.
+ */
+static tabla_hitos* elegir_hitos(int num_nodos, int k, const recorrido_hitos* recorrido) {
+    if (k < 1) k = 1;
+    if (k > MAX_HITOS) k = MAX_HITOS;
+
+    tabla_hitos* tabla = (tabla_hitos*)reservar_memoria_cero(MEM_ALGORITMOS, 1, sizeof(tabla_hitos));
+    if (tabla == NULL) return NULL;
+    tabla->num_nodos = num_nodos;
+    tabla->distancias = (int*)reservar_memoria(MEM_ALGORITMOS,
+                                               (size_t)k * (num_nodos ? num_nodos : 1) * sizeof(int));
+    int* cercania = (int*)reservar_memoria(MEM_ALGORITMOS, (num_nodos ? num_nodos : 1) * sizeof(int));
+    if (tabla->distancias == NULL || cercania == NULL) {
+        liberar_memoria(cercania);
+        destruir_tabla_hitos(tabla);
+        return NULL;
+    }
+
+    int primero = 0;
+    while (primero < num_nodos && !recorrido->utilizable[primero]) primero++;
+    if (primero == num_nodos) {
+        liberar_memoria(cercania);
+        return tabla;      // Sin nodos: la heurística vale 0
+    }
+
+    // La fila 0 sirve de borrador para encontrar el primer hito
+    if (!recorrido->recorrer(recorrido->datos, primero, tabla->distancias)) {
+        liberar_memoria(cercania);
+        destruir_tabla_hitos(tabla);
+        return NULL;
+    }
+    for (int v = 0; v < num_nodos; v++) cercania[v] = 0;
+    for (int v = 0; v < num_nodos; v++) {
+        int d = tabla->distancias[v];
+        if (recorrido->utilizable[v] && d != INFINITO) cercania[v] = d;
+    }
+
+    for (int i = 0; i < k; i++) {
+        int hito = -1;
+        for (int v = 0; v < num_nodos; v++) {
+            if (!recorrido->utilizable[v]) continue;
+            if (hito == -1 || cercania[v] > cercania[hito]) hito = v;
+        }
+        if (hito == -1 || (i > 0 && cercania[hito] == 0)) break;    // No quedan nodos nuevos
+
+        int* fila = tabla->distancias + (size_t)i * num_nodos;
+        if (!recorrido->recorrer(recorrido->datos, hito, fila)) {
+            liberar_memoria(cercania);
+            destruir_tabla_hitos(tabla);
+            return NULL;
+        }
+        tabla->hitos[i] = hito;
+        tabla->num_hitos++;
+
+        if (i == 0) {
+            for (int v = 0; v < num_nodos; v++) cercania[v] = fila[v];
+        } else {
+            for (int v = 0; v < num_nodos; v++) {
+                if (fila[v] < cercania[v]) cercania[v] = fila[v];
+            }
+        }
+    }
+
+    liberar_memoria(cercania);
+    return tabla;
+}
+
+// ==================== CONSTRUCCIÓN ====================
+
+/*
+ * hitos_desde_grafo
+ * k hitos sobre un grafo_matriz no dirigido; los nodos sin aristas no
+ * se eligen. Cuesta k Dijkstra sobre la matriz.
+ * Retorna NULL si falta memoria.
+ */
+tabla_hitos* hitos_desde_grafo(grafo_matriz* grafo, int k) {
+    unsigned char* utilizable = (unsigned char*)reservar_memoria_cero(
+        MEM_ALGORITMOS, grafo->num_nodos ? grafo->num_nodos : 1, 1);
+    if (utilizable == NULL) return NULL;
+
+    for (int u = 0; u < grafo->num_nodos; u++) {
+        for (int v = 0; v < grafo->num_nodos && !utilizable[u]; v++) {
+            if (grafo->matriz[u][v] != 0) utilizable[u] = 1;
+        }
+    }
+
+    recorrido_hitos recorrido = {distancias_grafo, grafo, utilizable};
+    tabla_hitos* tabla = elegir_hitos(grafo->num_nodos, k, &recorrido);
+    liberar_memoria(utilizable);
+    return tabla;
+}
+
+/*
+ * hitos_desde_laberinto
+ * k hitos entre las celdas abiertas, con un BFS por hito: O(k * celdas).
+ * Los nodos son los de laberinto_a_grafo. Retorna NULL si falta memoria.
+ */
+tabla_hitos* hitos_desde_laberinto(laberinto* lab, int k) {
+    unsigned char* vecinos = (unsigned char*)reservar_memoria(MEM_ALGORITMOS, 2 * MAX_NODOS);
+    if (vecinos == NULL) return NULL;
+    unsigned char* utilizable = vecinos + MAX_NODOS;
+
+    calcular_vecinos(lab, vecinos);
+    for (int n = 0; n < MAX_NODOS; n++) {
+        utilizable[n] = lab->celdas[n / COLUMNAS][n % COLUMNAS] != PARED;
+    }
+
+    recorrido_hitos recorrido = {distancias_laberinto, vecinos, utilizable};
+    tabla_hitos* tabla = elegir_hitos(MAX_NODOS, k, &recorrido);
+    liberar_memoria(vecinos);
+    return tabla;
+}
+
+/*
+ * destruir_tabla_hitos
+ * Libera la tabla y sus distancias (admite NULL).
+ */
+void destruir_tabla_hitos(tabla_hitos* tabla) {
+    if (tabla == NULL) return;
+    liberar_memoria(tabla->distancias);
+    liberar_memoria(tabla);
+}
+
+// ==================== CACHÉ ====================
+
+static int hitos_alt = HITOS_DEFECTO;           // k de la caché
+static tabla_hitos* tabla_cache = NULL;         // Última tabla construida
+static uint64_t huella_cache = 0;               // Huella de sus celdas
+static int hitos_cache = 0;                     // k con que se construyó
+
+/*
+ * fijar_hitos_alt
+ * Cambia la cantidad de hitos de hitos_en_cache (acotada a [1, MAX_HITOS]);
+ * la próxima consulta reconstruye la tabla.
+ */
+void fijar_hitos_alt(int k) {
+    if (k < 1) k = 1;
+    if (k > MAX_HITOS) k = MAX_HITOS;
+    hitos_alt = k;
+}
+
+/*
+ * hitos_en_cache
+ * Tabla de hitos_desde_laberinto para el laberinto; se reutiliza mientras
+ * las celdas y k no cambien, igual que indice_jerarquico_en_cache. No
+ * liberar el resultado; la caché es una sola y no se protege para varios
+ * hilos. Retorna NULL si falta memoria.
+ */
+const tabla_hitos* hitos_en_cache(laberinto* lab) {
+    uint64_t huella = huella_celdas(lab);
+
+    if (tabla_cache != NULL && huella == huella_cache && hitos_alt == hitos_cache) {
+        return tabla_cache;
+    }
+    destruir_tabla_hitos(tabla_cache);
+    tabla_cache = hitos_desde_laberinto(lab, hitos_alt);
+    huella_cache = huella;
+    hitos_cache = hitos_alt;
+    return tabla_cache;
+}
+
+// ==================== HEURÍSTICA ====================
+
+/*
+ * heuristica_hitos
+ * max |d(h, fin) - d(h, nodo)| sobre los hitos que alcanzan a ambos.
+ * Por la desigualdad triangular es una cota consistente en grafos no
+ * dirigidos; sin hitos vale 0 y A* se comporta como Dijkstra.
+ */
+int heuristica_hitos(int nodo, int fin, const void* contexto) {
+    const tabla_hitos* tabla = (const tabla_hitos*)contexto;
+    int cota = 0;
+
+    for (int i = 0; i < tabla->num_hitos; i++) {
+        const int* fila = tabla->distancias + (size_t)i * tabla->num_nodos;
+        if (fila[nodo] == INFINITO || fila[fin] == INFINITO) continue;
+        int diferencia = fila[fin] - fila[nodo];
+        if (diferencia < 0) diferencia = -diferencia;
+        if (diferencia > cota) cota = diferencia;
+    }
+    return cota;
+}
+
+// ==================== CONSULTAS ====================
+
+/*
+ * calcular_vecinos_hitos
+ * calcular_vecinos más ABIERTA_HITOS en las celdas que no son pared:
+ * una celda abierta puede no tener vecinos.
+ */
+void calcular_vecinos_hitos(laberinto* lab, unsigned char* vecinos) {
+    calcular_vecinos(lab, vecinos);
+    for (int n = 0; n < MAX_NODOS; n++) {
+        if (lab->celdas[n / COLUMNAS][n % COLUMNAS] != PARED) vecinos[n] |= ABIERTA_HITOS;
+    }
+}
+
+/*
+ * camino_hitos
+ * A* sobre las celdas (vecinos de calcular_vecinos_hitos) con la cota
+ * de los hitos; cada paso cuesta 1. Deja en expandidos los nodos
+ * sacados del montículo (admite NULL).
+ * Retorna los nodos del camino, 0 si no hay y -1 si falta memoria.
+ */
+int camino_hitos(const unsigned char* vecinos, const tabla_hitos* tabla, int origen,
+                 int destino, int* camino, int* expandidos) {
+    if (expandidos != NULL) *expandidos = 0;
+    if (origen < 0 || origen >= MAX_NODOS || destino < 0 || destino >= MAX_NODOS) return 0;
+    if (!(vecinos[origen] & ABIERTA_HITOS) || !(vecinos[destino] & ABIERTA_HITOS)) return 0;
+    if (origen == destino) {
+        camino[0] = origen;
+        return 1;
+    }
+
+    int* distancia = (int*)reservar_memoria(MEM_ALGORITMOS, 2 * MAX_NODOS * sizeof(int));
+    monticulo abiertos;
+    if (distancia == NULL) return -1;
+    if (!crear_monticulo(&abiertos, MAX_NODOS)) {
+        liberar_memoria(distancia);
+        return -1;
+    }
+    int* anterior = distancia + MAX_NODOS;
+
+    for (int i = 0; i < MAX_NODOS; i++) {
+        distancia[i] = INFINITO;
+        anterior[i] = -1;
+    }
+    distancia[origen] = 0;
+    insertar_o_mejorar(&abiertos, origen, heuristica_hitos(origen, destino, tabla));
+
+    // La cota es consistente: un nodo extraído ya no mejora
+    while (abiertos.tamano > 0) {
+        int n = extraer_minimo(&abiertos);
+        if (expandidos != NULL) (*expandidos)++;
+        if (n == destino) break;
+
+        for (int d = 0; d < 4; d++) {
+            if (!(vecinos[n] & (1 << d))) continue;
+            int m = n + PASO_VECINO(d);
+            if (distancia[n] + 1 >= distancia[m]) continue;
+            distancia[m] = distancia[n] + 1;
+            anterior[m] = n;
+            insertar_o_mejorar(&abiertos, m, distancia[m] + heuristica_hitos(m, destino, tabla));
+        }
+    }
+
+    int largo = 0;
+    if (distancia[destino] != INFINITO) {
+        largo = distancia[destino] + 1;
+        int nodo = destino;
+        for (int i = largo - 1; i >= 0; i--) {
+            camino[i] = nodo;
+            nodo = anterior[nodo];
+        }
+    }
+
+    destruir_monticulo(&abiertos);
+    liberar_memoria(distancia);
+    return largo;
+}
+
+/*
+ * resolver_lote_hitos
+ * Igual que resolver_lote_jerarquico pero con A* y la tabla de hitos,
+ * que se arma una vez para todo el lote. Retorna 0 sin memoria.
+ */
+int resolver_lote_hitos(laberinto* lab, const tabla_hitos* tabla, consulta_ruta* consultas,
+                        int cantidad, int con_camino, resumen_lote* resumen) {
+    memset(resumen, 0, sizeof(*resumen));
+    resumen->hilos = 1;
+    if (cantidad <= 0) return 1;
+
+    unsigned char* vecinos = (unsigned char*)reservar_memoria(MEM_ALGORITMOS, MAX_NODOS);
+    int* camino = (int*)reservar_memoria(MEM_ALGORITMOS, MAX_NODOS * sizeof(int));
+    size_t* inicio = con_camino ? (size_t*)reservar_memoria(MEM_ALGORITMOS,
+                                                           (size_t)cantidad * sizeof(size_t)) : NULL;
+    if (vecinos == NULL || camino == NULL || (con_camino && inicio == NULL)) {
+        liberar_memoria(vecinos);
+        liberar_memoria(camino);
+        liberar_memoria(inicio);
+        return 0;
+    }
+    calcular_vecinos_hitos(lab, vecinos);
+
+    int* nodos = NULL;
+    size_t usado = 0, capacidad = 0;
+    int ok = 1;
+    for (int k = 0; k < cantidad && ok; k++) {
+        int expandidos;
+        int largo = camino_hitos(vecinos, tabla, consultas[k].origen, consultas[k].destino,
+                                 camino, &expandidos);
+        if (largo < 0) {
+            ok = 0;
+            break;
+        }
+        consultas[k].camino = NULL;
+        consultas[k].pasos = largo - 1;
+        resumen->visitados += expandidos;
+        if (!con_camino || largo == 0) continue;
+
+        if (usado + (size_t)largo > capacidad) {
+            size_t nueva = capacidad ? 2 * capacidad : (size_t)MAX_NODOS;
+            while (nueva < usado + (size_t)largo) nueva *= 2;
+            int* mayor = (int*)redimensionar_memoria(MEM_ALGORITMOS, nodos, nueva * sizeof(int));
+            if (mayor == NULL) {
+                ok = 0;
+                break;
+            }
+            nodos = mayor;
+            capacidad = nueva;
+        }
+        memcpy(nodos + usado, camino, (size_t)largo * sizeof(int));
+        inicio[k] = usado;
+        usado += (size_t)largo;
+    }
+
+    // El bloque pudo moverse al crecer: los punteros se fijan al final
+    if (ok && con_camino) {
+        for (int k = 0; k < cantidad; k++) {
+            if (consultas[k].pasos >= 0) consultas[k].camino = nodos + inicio[k];
+        }
+        resumen->nodos_caminos = nodos;
+    } else if (!ok) {
+        liberar_memoria(nodos);
+    }
+    liberar_memoria(vecinos);
+    liberar_memoria(camino);
+    liberar_memoria(inicio);
+    return ok;
+}
@@ -0,0 +1,61 @@
+/*
+ * hitos.h
+ * Hitos (landmarks) para A*: se guardan las distancias desde k nodos
+ * elegidos y la desigualdad triangular da una cota inferior de la
+ * distancia entre dos nodos cualesquiera (ALT). Sirve para grafos no
+ * dirigidos; la memoria es k enteros por nodo.
+ */
+
+#ifndef HITOS_H
+#define HITOS_H
+
+#include "grafo.h"
+#include "laberinto.h"
+#include "consultas.h"
+
+// ============================================================================
+// DEFINICIONES DE LOS HITOS
+// ============================================================================
+
+#ifndef HITOS_DEFECTO
+#define HITOS_DEFECTO 8     // Hitos del comparador y, salvo fijar_hitos_alt, de la caché
+#endif
+
+#define MAX_HITOS 32        // Tope de k
+
+#define ABIERTA_HITOS 0x10  // Bit de celda transitable en vecinos
+
+/*
+ * tabla_hitos - Hitos y sus distancias a todos los nodos
+ * La fila i de distancias (num_nodos enteros) sale del hito i;
+ * INFINITO marca los nodos que no alcanza.
+ */
+typedef struct {
+    int num_hitos;              // Hitos elegidos (puede ser menos que k)
+    int num_nodos;              // Columnas de cada fila
+    int hitos[MAX_HITOS];       // Nodo de cada hito
+    int* distancias;            // num_hitos * num_nodos distancias
+} tabla_hitos;
+
+// ============================================================================
+// PROTOTIPOS DE FUNCIONES
+// ============================================================================
+
+/* Construcción */
+tabla_hitos* hitos_desde_grafo(grafo_matriz* grafo, int k);
+tabla_hitos* hitos_desde_laberinto(laberinto* lab, int k);
+void destruir_tabla_hitos(tabla_hitos* tabla);
+void fijar_hitos_alt(int k);
+const tabla_hitos* hitos_en_cache(laberinto* lab);
+
+/* Heurística para a_estrella (contexto = tabla_hitos) */
+int heuristica_hitos(int nodo, int fin, const void* contexto);
+
+/* Consultas sobre las celdas */
+void calcular_vecinos_hitos(laberinto* lab, unsigned char* vecinos);
+int camino_hitos(const unsigned char* vecinos, const tabla_hitos* tabla, int origen,
+                 int destino, int* camino, int* expandidos);
+int resolver_lote_hitos(laberinto* lab, const tabla_hitos* tabla, consulta_ruta* consultas,
+                        int cantidad, int con_camino, resumen_lote* resumen);
+
+#endif // HITOS_H
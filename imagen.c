@@ -0,0 +1,335 @@
+/*
+ * imagen.c
+ * Exportación raster de laberintos.
+ * Cada fila de celdas se convierte en líneas de píxeles que se escriben
+ * de inmediato; PNG usa el compresor deflate de compresion.c.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "imagen.h"
+#include "compresion.h"
+#include "memoria.h"
+
+// ==================== COLORES ====================
+
+static const unsigned char RGB_PARED[3]    = {0x33, 0x33, 0x33};
+static const unsigned char RGB_CAMINO[3]   = {0xFF, 0xFF, 0xFF};
+static const unsigned char RGB_INICIO[3]   = {0x4C, 0xAF, 0x50};
+static const unsigned char RGB_FINAL[3]    = {0xF4, 0x43, 0x36};
+static const unsigned char RGB_SOLUCION[3] = {0x21, 0x96, 0xF3};
+
+// ==================== FUNCIONES AUXILIARES ====================
+
+/*
+ * escribir_entero_be
+ * Escribe un entero de 32 bits en orden big-endian (formato PNG).
+ */
+static void escribir_entero_be(FILE* archivo, uint32_t valor) {
+    unsigned char bytes[4];
+    bytes[0] = (unsigned char)(valor >> 24);
+    bytes[1] = (unsigned char)(valor >> 16);
+    bytes[2] = (unsigned char)(valor >> 8);
+    bytes[3] = (unsigned char)valor;
+    fwrite(bytes, 1, 4, archivo);
+}
+
+/*
+ * escribir_chunk_png
+ * Escribe un chunk PNG: longitud, tipo, datos y CRC de tipo + datos.
+ */
+static void escribir_chunk_png(FILE* archivo, const char* tipo,
+                               const unsigned char* datos, size_t n) {
+    uint32_t crc = actualizar_crc32(0, (const unsigned char*)tipo, 4);
+    crc = actualizar_crc32(crc, datos, n);
+    
+    escribir_entero_be(archivo, (uint32_t)n);
+    fwrite(tipo, 1, 4, archivo);
+    if (n > 0) fwrite(datos, 1, n, archivo);
+    escribir_entero_be(archivo, crc);
+}
+
+/*
+ * escribir_idat
+ * Escritor del compresor: cada bloque comprimido es un chunk IDAT.
+ */
+static void escribir_idat(const unsigned char* datos, size_t n, void* contexto) {
+    escribir_chunk_png((FILE*)contexto, "IDAT", datos, n);
+}
+
+/*
+ * calcular_distancias_entrada
+ * BFS sobre la rejilla desde la celda de inicio (4 vecinos).
+ * Deja -1 en celdas inalcanzables y retorna la distancia máxima.
+ */
+static int calcular_distancias_entrada(laberinto* lab, int distancia[]) {
+    int cola[MAX_NODOS];       // Cola de nodos
+    int frente = 0, final = 0; // Índices de cola
+    int maxima = 0;            // Distancia máxima encontrada
+    static const int df[4] = {-1, 1, 0, 0};
+    static const int dc[4] = {0, 0, 1, -1};
+    
+    for (int k = 0; k < MAX_NODOS; k++) distancia[k] = -1;
+    
+    for (int i = 0; i < lab->filas; i++) {
+        for (int j = 0; j < lab->columnas; j++) {
+            if (lab->celdas[i][j] == INICIO) {
+                distancia[i * COLUMNAS + j] = 0;
+                cola[final++] = i * COLUMNAS + j;
+            }
+        }
+    }
+    
+    while (frente < final) {
+        int actual = cola[frente++];
+        int fila = actual / COLUMNAS;
+        int col = actual % COLUMNAS;
+        
+        for (int d = 0; d < 4; d++) {
+            int nf = fila + df[d];
+            int nc = col + dc[d];
+            if (nf < 0 || nf >= lab->filas || nc < 0 || nc >= lab->columnas) continue;
+            if (lab->celdas[nf][nc] == PARED) continue;
+            
+            int vecino = nf * COLUMNAS + nc;
+            if (distancia[vecino] >= 0) continue;
+            
+            distancia[vecino] = distancia[actual] + 1;
+            if (distancia[vecino] > maxima) maxima = distancia[vecino];
+            cola[final++] = vecino;
+        }
+    }
+    
+    return maxima;
+}
+
+/*
+ * color_celda
+ * Color base de una celda (sin la marca de solución).
+ * Con mapa de calor, los caminos van de azul (cerca) a rojo (lejos).
+ */
+static void color_celda(int tipo, int distancia, int maxima, int mapa_calor,
+                        unsigned char rgb[3]) {
+    if (tipo == PARED) {
+        memcpy(rgb, RGB_PARED, 3);
+    } else if (tipo == INICIO) {
+        memcpy(rgb, RGB_INICIO, 3);
+    } else if (tipo == FINAL) {
+        memcpy(rgb, RGB_FINAL, 3);
+    } else if (mapa_calor && distancia >= 0 && maxima > 0) {
+        int t = distancia * 255 / maxima;   // 0 = cerca, 255 = lejos
+        rgb[0] = (unsigned char)t;
+        rgb[1] = (unsigned char)(64 + (t < 128 ? t : 255 - t));
+        rgb[2] = (unsigned char)(255 - t);
+    } else {
+        memcpy(rgb, RGB_CAMINO, 3);
+    }
+}
+
+/*
+ * armar_linea
+ * Genera la línea de píxeles 'y' (0..ppc-1) de una fila de celdas.
+ * La solución se dibuja como un cuadrado interior de cada celda.
+ */
+static void armar_linea(const opciones_imagen* opciones, int columnas,
+                        unsigned char colores[][3], const unsigned char en_camino[],
+                        const unsigned char es_pared[], int y, unsigned char* linea) {
+    int ppc = opciones->pixeles_por_celda;
+    int margen = ppc / 4;                         // Borde alrededor de la marca
+    int fila_interior = (y >= margen && y < ppc - margen);
+    int x = 0;                                    // Píxel actual en la línea
+    
+    if (opciones->formato == FORMATO_PBM) {
+        memset(linea, 0, (size_t)(columnas * ppc + 7) / 8);
+    }
+    
+    for (int j = 0; j < columnas; j++) {
+        for (int px = 0; px < ppc; px++, x++) {
+            int marca = en_camino[j] && fila_interior && px >= margen && px < ppc - margen;
+            
+            if (opciones->formato == FORMATO_PBM) {
+                if (es_pared[j] || marca) {
+                    linea[x >> 3] |= (unsigned char)(0x80 >> (x & 7));  // 1 = negro
+                }
+                continue;
+            }
+            
+            const unsigned char* rgb = marca ? RGB_SOLUCION : colores[j];
+            if (opciones->formato == FORMATO_PGM) {
+                linea[x] = (unsigned char)((rgb[0] * 77 + rgb[1] * 150 + rgb[2] * 29) >> 8);
+            } else {
+                memcpy(&linea[1 + x * 3], rgb, 3);   // Byte 0 = filtro PNG
+            }
+        }
+    }
+}
+
+// ==================== FUNCIONES PRINCIPALES ====================
+
+/*
+ * inicializar_opciones_imagen
+ * Valores por defecto: PNG, 8 píxeles por celda, sin superposiciones.
+ */
+void inicializar_opciones_imagen(opciones_imagen* opciones) {
+    opciones->formato = FORMATO_PNG;
+    opciones->pixeles_por_celda = 8;
+    opciones->camino = NULL;
+    opciones->longitud = 0;
+    opciones->mapa_calor = 0;
+}
+
+/*
+ * exportar_laberinto_imagen
+ * Escribe el laberinto como PBM, PGM o PNG en DIRECTORIO_LABERINTOS.
+ * Solo guarda una línea de píxeles en memoria. Retorna 1 si tuvo éxito.
+ */
+int exportar_laberinto_imagen(laberinto* lab, const char* nombre_archivo,
+                              const opciones_imagen* opciones) {
+    static const char* extensiones[] = {"", "pbm", "pgm", "png"};
+    static const unsigned char firma_png[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    char nombre_completo[MAX_NOMBRE + 50]; // Nombre completo con ruta
+    int ppc = opciones->pixeles_por_celda;
+    
+    if (opciones->formato < FORMATO_PBM || opciones->formato > FORMATO_PNG) {
+        printf("Error: formato de imagen no válido\n");
+        return 0;
+    }
+    if (ppc < 1 || ppc > MAX_PIXELES_CELDA) {
+        printf("Error: píxeles por celda deben estar entre 1 y %d\n", MAX_PIXELES_CELDA);
+        return 0;
+    }
+    
+    int ancho = lab->columnas * ppc;
+    int alto = lab->filas * ppc;
+    
+    // Tamaño de una línea según el formato
+    size_t bytes_linea;
+    if (opciones->formato == FORMATO_PBM) {
+        bytes_linea = (size_t)(ancho + 7) / 8;
+    } else if (opciones->formato == FORMATO_PGM) {
+        bytes_linea = (size_t)ancho;
+    } else {
+        bytes_linea = 1 + (size_t)ancho * 3;
+    }
+    
+    sprintf(nombre_completo, "%s%s.%s", DIRECTORIO_LABERINTOS, nombre_archivo,
+            extensiones[opciones->formato]);
+    
+    FILE* archivo = fopen(nombre_completo, "wb");
+    if (archivo == NULL) {
+        printf("Error al crear archivo de imagen\n");
+        return 0;
+    }
+    
+    unsigned char* linea = (unsigned char*)reservar_memoria_cero(MEM_ARCHIVOS, bytes_linea, 1);
+    if (!linea) {
+        fclose(archivo);
+        return 0;
+    }
+    
+    // Superposiciones: nodos de la solución y distancias desde la entrada
+    unsigned char en_camino_nodo[MAX_NODOS] = {0};
+    if (opciones->camino != NULL) {
+        for (int k = 0; k < opciones->longitud; k++) {
+            en_camino_nodo[opciones->camino[k]] = 1;
+        }
+    }
+    
+    int distancia[MAX_NODOS];
+    int maxima = 0;
+    if (opciones->mapa_calor) {
+        maxima = calcular_distancias_entrada(lab, distancia);
+    }
+    
+    // Encabezado del formato
+    compresor_deflate* compresor = NULL;
+    uint32_t adler = 1;
+    
+    if (opciones->formato == FORMATO_PBM) {
+        fprintf(archivo, "P4\n%d %d\n", ancho, alto);
+    } else if (opciones->formato == FORMATO_PGM) {
+        fprintf(archivo, "P5\n%d %d\n255\n", ancho, alto);
+    } else {
+        unsigned char ihdr[13];
+        static const unsigned char cabecera_zlib[2] = {0x78, 0x01};
+        
+        ihdr[0] = (unsigned char)(ancho >> 24); ihdr[1] = (unsigned char)(ancho >> 16);
+        ihdr[2] = (unsigned char)(ancho >> 8);  ihdr[3] = (unsigned char)ancho;
+        ihdr[4] = (unsigned char)(alto >> 24);  ihdr[5] = (unsigned char)(alto >> 16);
+        ihdr[6] = (unsigned char)(alto >> 8);   ihdr[7] = (unsigned char)alto;
+        ihdr[8] = 8;     // Bits por canal
+        ihdr[9] = 2;     // RGB
+        ihdr[10] = 0;    // Deflate
+        ihdr[11] = 0;    // Filtro adaptativo estándar
+        ihdr[12] = 0;    // Sin entrelazado
+        
+        fwrite(firma_png, 1, sizeof(firma_png), archivo);
+        escribir_chunk_png(archivo, "IHDR", ihdr, sizeof(ihdr));
+        escribir_chunk_png(archivo, "IDAT", cabecera_zlib, sizeof(cabecera_zlib));
+        
+        compresor = crear_compresor(escribir_idat, archivo);
+        if (!compresor) {
+            liberar_memoria(linea);
+            fclose(archivo);
+            return 0;
+        }
+    }
+    
+    // Filas de celdas: colores una vez por fila, luego ppc líneas de píxeles
+    unsigned char colores[COLUMNAS][3];
+    unsigned char en_camino[COLUMNAS];
+    unsigned char es_pared[COLUMNAS];
+    
+    for (int i = 0; i < lab->filas; i++) {
+        for (int j = 0; j < lab->columnas; j++) {
+            int nodo = i * COLUMNAS + j;
+            int tipo = lab->celdas[i][j];
+            
+            color_celda(tipo, opciones->mapa_calor ? distancia[nodo] : -1, maxima,
+                        opciones->mapa_calor, colores[j]);
+            en_camino[j] = en_camino_nodo[nodo] && tipo != INICIO && tipo != FINAL;
+            es_pared[j] = (tipo == PARED);
+        }
+        
+        for (int y = 0; y < ppc; y++) {
+            armar_linea(opciones, lab->columnas, colores, en_camino, es_pared, y, linea);
+            
+            if (compresor != NULL) {
+                adler = actualizar_adler32(adler, linea, bytes_linea);
+                escribir_compresor(compresor, linea, bytes_linea);
+            } else {
+                fwrite(linea, 1, bytes_linea, archivo);
+            }
+        }
+    }
+    
+    // Cierre del PNG: resto del flujo, Adler-32 y chunk final
+    if (compresor != NULL) {
+        unsigned char pie_zlib[4];
+        
+        terminar_compresor(compresor);
+        destruir_compresor(compresor);
+        
+        pie_zlib[0] = (unsigned char)(adler >> 24);
+        pie_zlib[1] = (unsigned char)(adler >> 16);
+        pie_zlib[2] = (unsigned char)(adler >> 8);
+        pie_zlib[3] = (unsigned char)adler;
+        escribir_chunk_png(archivo, "IDAT", pie_zlib, sizeof(pie_zlib));
+        escribir_chunk_png(archivo, "IEND", NULL, 0);
+    }
+    
+    liberar_memoria(linea);
+    
+    int ok = (ferror(archivo) == 0);
+    ok = (fclose(archivo) == 0) && ok;
+    
+    if (ok) {
+        printf("Laberinto exportado a imagen: %s (%d x %d píxeles)\n",
+               nombre_completo, ancho, alto);
+    } else {
+        printf("Error al escribir archivo de imagen\n");
+    }
+    return ok;
+}
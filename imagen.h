@@ -0,0 +1,42 @@
+/*
+ * imagen.h
+ * Exportación de laberintos a imágenes raster (PBM, PGM y PNG).
+ * Se escribe una línea de píxeles a la vez para acotar la memoria.
+ */
+
+#ifndef IMAGEN_H
+#define IMAGEN_H
+
+#include "laberinto.h"
+
+// ============================================================================
+// DEFINICIONES DE IMAGEN
+// ============================================================================
+
+// Formatos soportados
+#define FORMATO_PBM 1   // 1 bit por píxel (blanco y negro)
+#define FORMATO_PGM 2   // 8 bits por píxel (escala de grises)
+#define FORMATO_PNG 3   // RGB de 8 bits comprimido con deflate
+
+#define MAX_PIXELES_CELDA 64    // Límite de píxeles por celda
+
+/*
+ * opciones_imagen - Parámetros de la exportación raster
+ */
+typedef struct {
+    int formato;              // FORMATO_PBM, FORMATO_PGM o FORMATO_PNG
+    int pixeles_por_celda;    // Lado de cada celda en píxeles
+    int* camino;              // Solución a superponer (o NULL)
+    int longitud;             // Nodos en la solución
+    int mapa_calor;           // 1 para colorear por distancia a la entrada
+} opciones_imagen;
+
+// ============================================================================
+// PROTOTIPOS DE FUNCIONES
+// ============================================================================
+
+void inicializar_opciones_imagen(opciones_imagen* opciones);
+int exportar_laberinto_imagen(laberinto* lab, const char* nombre_archivo,
+                              const opciones_imagen* opciones);
+
+#endif // IMAGEN_H
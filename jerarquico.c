@@ -0,0 +1,466 @@
+/*
+ * jerarquico.c
+ * Índice por bloques y búsqueda en dos niveles. Como todas las celdas de
+ * cruce son entradas y las distancias internas salen de un BFS dentro del
+ * bloque, el camino del grafo abstracto, refinado, es el más corto.
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include "jerarquico.h"
+#include "algoritmos.h"
+#include "memoria.h"
+
+// ==================== BLOQUES ====================
+
+/*
+ * bloque_de
+ * Bloque que contiene la celda.
+ */
+static int bloque_de(const indice_jerarquico* indice, int nodo) {
+    int fila = nodo / COLUMNAS, columna = nodo % COLUMNAS;
+    return (fila / indice->tam_bloque) * indice->columnas_bloques + columna / indice->tam_bloque;
+}
+
+/*
+ * local_de
+ * Posición de la celda dentro de su bloque (fila * tam_bloque + columna).
+ */
+static int local_de(const indice_jerarquico* indice, int nodo) {
+    int fila = nodo / COLUMNAS, columna = nodo % COLUMNAS;
+    return (fila % indice->tam_bloque) * indice->tam_bloque + columna % indice->tam_bloque;
+}
+
+/*
+ * celda_de_local
+ * Inversa de local_de para un bloque dado.
+ */
+static int celda_de_local(const indice_jerarquico* indice, int bloque, int local) {
+    int fila = (bloque / indice->columnas_bloques) * indice->tam_bloque + local / indice->tam_bloque;
+    int columna = (bloque % indice->columnas_bloques) * indice->tam_bloque + local % indice->tam_bloque;
+    return fila * COLUMNAS + columna;
+}
+
+/*
+ * recorrer_bloque
+ * BFS desde origen sin salir de su bloque. distancia y anterior se
+ * indexan por posición local (-1 = no alcanzada); anterior apunta hacia
+ * el origen. Los tres arreglos tienen tam_bloque² posiciones.
+ */
+static void recorrer_bloque(const indice_jerarquico* indice, int origen,
+                            int* distancia, int* anterior, int* cola) {
+    int bloque = bloque_de(indice, origen);
+    int area = indice->tam_bloque * indice->tam_bloque;
+    int cabeza = 0, fin = 0;
+
+    for (int i = 0; i < area; i++) distancia[i] = -1;
+    distancia[local_de(indice, origen)] = 0;
+    anterior[local_de(indice, origen)] = -1;
+    cola[fin++] = origen;
+
+    while (cabeza < fin) {
+        int n = cola[cabeza++];
+        int ln = local_de(indice, n);
+
+        for (int d = 0; d < 4; d++) {
+            if (!(indice->vecinos[n] & (1 << d))) continue;
+            int m = n + PASO_VECINO(d);
+            if (bloque_de(indice, m) != bloque) continue;
+            int lm = local_de(indice, m);
+            if (distancia[lm] >= 0) continue;
+            distancia[lm] = distancia[ln] + 1;
+            anterior[lm] = ln;
+            cola[fin++] = m;
+        }
+    }
+}
+
+/*
+ * buscar_entrada
+ * Entrada de una celda del bloque (búsqueda binaria: dentro de cada
+ * bloque van en orden de nodo). Retorna -1 si la celda no es entrada.
+ */
+static int buscar_entrada(const indice_jerarquico* indice, int celda) {
+    int bloque = bloque_de(indice, celda);
+    int bajo = indice->primera_entrada[bloque];
+    int alto = indice->primera_entrada[bloque + 1] - 1;
+
+    while (bajo <= alto) {
+        int medio = (bajo + alto) / 2;
+        if (indice->celda_entrada[medio] == celda) return medio;
+        if (indice->celda_entrada[medio] < celda) bajo = medio + 1;
+        else alto = medio - 1;
+    }
+    return -1;
+}
+
+/*
+ * es_entrada
+ * Celda abierta con algún vecino abierto en otro bloque.
+ */
+static int es_entrada(const indice_jerarquico* indice, int nodo) {
+    if (!(indice->vecinos[nodo] & ABIERTA_JERARQUICO)) return 0;
+    for (int d = 0; d < 4; d++) {
+        if ((indice->vecinos[nodo] & (1 << d)) &&
+            bloque_de(indice, nodo + PASO_VECINO(d)) != bloque_de(indice, nodo)) return 1;
+    }
+    return 0;
+}
+
+// ==================== CONSTRUCCIÓN ====================
+
+/*
+ * agregar_enlace
+ * Añade una arista al final del arreglo, que crece al doble cuando se
+ * llena. Retorna 0 sin memoria.
+ */
+static int agregar_enlace(indice_jerarquico* indice, int* capacidad, int destino, int peso) {
+    if (indice->num_enlaces == *capacidad) {
+        int nueva = *capacidad ? 2 * *capacidad : 64;
+        enlace_jerarquico* enlaces = (enlace_jerarquico*)redimensionar_memoria(
+            MEM_ALGORITMOS, indice->enlaces, (size_t)nueva * sizeof(enlace_jerarquico));
+        if (enlaces == NULL) return 0;
+        indice->enlaces = enlaces;
+        *capacidad = nueva;
+    }
+    indice->enlaces[indice->num_enlaces].destino = destino;
+    indice->enlaces[indice->num_enlaces].peso = peso;
+    indice->num_enlaces++;
+    return 1;
+}
+
+/*
+ * construir_indice_jerarquico
+ * Parte el laberinto en bloques de tam_bloque x tam_bloque, encuentra
+ * las entradas y une cada una con sus vecinas de otros bloques (peso 1)
+ * y con las de su bloque que alcanza sin salir de él (distancia BFS).
+ * Retorna NULL si falta memoria.
+ */
+indice_jerarquico* construir_indice_jerarquico(laberinto* lab, int tam_bloque) {
+    if (tam_bloque < 1) tam_bloque = TAM_BLOQUE_JERARQUICO;
+
+    indice_jerarquico* indice = (indice_jerarquico*)reservar_memoria_cero(
+        MEM_ALGORITMOS, 1, sizeof(indice_jerarquico));
+    if (indice == NULL) return NULL;
+
+    indice->tam_bloque = tam_bloque;
+    indice->filas_bloques = (FILAS + tam_bloque - 1) / tam_bloque;
+    indice->columnas_bloques = (COLUMNAS + tam_bloque - 1) / tam_bloque;
+    int num_bloques = indice->filas_bloques * indice->columnas_bloques;
+    int area = tam_bloque * tam_bloque;
+
+    indice->vecinos = (unsigned char*)reservar_memoria(MEM_ALGORITMOS, MAX_NODOS);
+    indice->primera_entrada = (int*)reservar_memoria_cero(MEM_ALGORITMOS, num_bloques + 1,
+                                                          sizeof(int));
+    int* trabajo = (int*)reservar_memoria(MEM_ALGORITMOS, (size_t)3 * area * sizeof(int));
+    if (!indice->vecinos || !indice->primera_entrada || !trabajo) {
+        liberar_memoria(trabajo);
+        destruir_indice_jerarquico(indice);
+        return NULL;
+    }
+    int* distancia = trabajo;
+    int* anterior = distancia + area;
+    int* cola = anterior + area;
+
+    calcular_vecinos(lab, indice->vecinos);
+    for (int n = 0; n < MAX_NODOS; n++) {
+        if (lab->celdas[n / COLUMNAS][n % COLUMNAS] != PARED) indice->vecinos[n] |= ABIERTA_JERARQUICO;
+    }
+
+    // Entradas por bloque: conteo, sumas prefijas y reparto en orden de nodo
+    for (int n = 0; n < MAX_NODOS; n++) {
+        if (es_entrada(indice, n)) {
+            indice->primera_entrada[bloque_de(indice, n) + 1]++;
+            indice->num_entradas++;
+        }
+    }
+    for (int b = 0; b < num_bloques; b++) indice->primera_entrada[b + 1] += indice->primera_entrada[b];
+
+    int entradas = indice->num_entradas ? indice->num_entradas : 1;
+    indice->celda_entrada = (int*)reservar_memoria(MEM_ALGORITMOS, (size_t)entradas * sizeof(int));
+    indice->primer_enlace = (int*)reservar_memoria(MEM_ALGORITMOS, ((size_t)entradas + 1) * sizeof(int));
+    int* siguiente = (int*)reservar_memoria(MEM_ALGORITMOS, (size_t)num_bloques * sizeof(int));
+    if (!indice->celda_entrada || !indice->primer_enlace || !siguiente) {
+        liberar_memoria(siguiente);
+        liberar_memoria(trabajo);
+        destruir_indice_jerarquico(indice);
+        return NULL;
+    }
+    memcpy(siguiente, indice->primera_entrada, (size_t)num_bloques * sizeof(int));
+    for (int n = 0; n < MAX_NODOS; n++) {
+        if (es_entrada(indice, n)) indice->celda_entrada[siguiente[bloque_de(indice, n)]++] = n;
+    }
+    liberar_memoria(siguiente);
+
+    // Aristas: las de cada entrada quedan contiguas (CSR)
+    int capacidad = 0, ok = 1;
+    for (int e = 0; e < indice->num_entradas && ok; e++) {
+        int celda = indice->celda_entrada[e];
+        int bloque = bloque_de(indice, celda);
+        indice->primer_enlace[e] = indice->num_enlaces;
+
+        for (int d = 0; d < 4 && ok; d++) {
+            if (!(indice->vecinos[celda] & (1 << d))) continue;
+            int m = celda + PASO_VECINO(d);
+            if (bloque_de(indice, m) != bloque) ok = agregar_enlace(indice, &capacidad,
+                                                                    buscar_entrada(indice, m), 1);
+        }
+
+        recorrer_bloque(indice, celda, distancia, anterior, cola);
+        for (int f = indice->primera_entrada[bloque]; f < indice->primera_entrada[bloque + 1] && ok; f++) {
+            int d = distancia[local_de(indice, indice->celda_entrada[f])];
+            if (f != e && d > 0) ok = agregar_enlace(indice, &capacidad, f, d);
+        }
+    }
+    indice->primer_enlace[indice->num_entradas] = indice->num_enlaces;
+    liberar_memoria(trabajo);
+
+    if (!ok) {
+        destruir_indice_jerarquico(indice);
+        return NULL;
+    }
+    return indice;
+}
+
+void destruir_indice_jerarquico(indice_jerarquico* indice) {
+    if (indice == NULL) return;
+    liberar_memoria(indice->celda_entrada);
+    liberar_memoria(indice->primera_entrada);
+    liberar_memoria(indice->primer_enlace);
+    liberar_memoria(indice->enlaces);
+    liberar_memoria(indice->vecinos);
+    liberar_memoria(indice);
+}
+
+// ==================== CACHÉ ====================
+
+static indice_jerarquico* indice_cache = NULL;   // Último índice construido
+static uint64_t huella_cache = 0;                // Huella de sus celdas
+
+/*
+ * indice_jerarquico_en_cache
+ * Índice con TAM_BLOQUE_JERARQUICO para el laberinto; se reutiliza
+ * mientras las celdas no cambien. No liberar el resultado; la caché es
+ * una sola y no se protege para varios hilos. Retorna NULL si falta memoria.
+ */
+const indice_jerarquico* indice_jerarquico_en_cache(laberinto* lab) {
+    uint64_t huella = huella_celdas(lab);
+
+    if (indice_cache != NULL && huella == huella_cache) return indice_cache;
+    destruir_indice_jerarquico(indice_cache);
+    indice_cache = construir_indice_jerarquico(lab, TAM_BLOQUE_JERARQUICO);
+    huella_cache = huella;
+    return indice_cache;
+}
+
+// ==================== CONSULTAS ====================
+
+/*
+ * camino_jerarquico
+ * Camino más corto de origen a destino. Un BFS local enlaza el origen
+ * y el destino con las entradas de sus bloques, A* recorre el grafo
+ * abstracto y el resultado se refina celda por celda. Deja en
+ * expandidos las entradas sacadas del montículo (admite NULL).
+ * Retorna los nodos del camino, 0 si no hay y -1 si falta memoria.
+ */
+int camino_jerarquico(const indice_jerarquico* indice, int origen, int destino,
+                      int* camino, int* expandidos) {
+    if (expandidos != NULL) *expandidos = 0;
+    if (origen < 0 || origen >= MAX_NODOS || destino < 0 || destino >= MAX_NODOS) return 0;
+    if (!(indice->vecinos[origen] & ABIERTA_JERARQUICO) ||
+        !(indice->vecinos[destino] & ABIERTA_JERARQUICO)) return 0;
+    if (origen == destino) {
+        camino[0] = origen;
+        return 1;
+    }
+
+    int area = indice->tam_bloque * indice->tam_bloque;
+    int entradas = indice->num_entradas ? indice->num_entradas : 1;
+    int* trabajo = (int*)reservar_memoria(MEM_ALGORITMOS,
+                                          ((size_t)5 * area + 2 * (size_t)entradas) * sizeof(int));
+    monticulo abiertos;
+    if (trabajo == NULL) return -1;
+    if (!crear_monticulo(&abiertos, entradas)) {
+        liberar_memoria(trabajo);
+        return -1;
+    }
+    int* distancia_o = trabajo;
+    int* anterior_o = distancia_o + area;
+    int* distancia_d = anterior_o + area;
+    int* anterior_d = distancia_d + area;
+    int* cola = anterior_d + area;
+    int* costo = cola + area;
+    int* previa = costo + entradas;
+
+    int bloque_o = bloque_de(indice, origen);
+    int bloque_d = bloque_de(indice, destino);
+    recorrer_bloque(indice, origen, distancia_o, anterior_o, cola);
+    recorrer_bloque(indice, destino, distancia_d, anterior_d, cola);
+
+    // Candidato directo: ambos en el mismo bloque y unidos por dentro
+    int mejor = INFINITO, ultima = -1, sacadas = 0;
+    if (bloque_o == bloque_d && distancia_o[local_de(indice, destino)] >= 0) {
+        mejor = distancia_o[local_de(indice, destino)];
+    }
+
+    for (int e = 0; e < indice->num_entradas; e++) {
+        costo[e] = INFINITO;
+        previa[e] = -1;
+    }
+    for (int e = indice->primera_entrada[bloque_o]; e < indice->primera_entrada[bloque_o + 1]; e++) {
+        int d = distancia_o[local_de(indice, indice->celda_entrada[e])];
+        if (d < 0) continue;
+        costo[e] = d;
+        insertar_o_mejorar(&abiertos, e, d + heuristica_manhattan(indice->celda_entrada[e], destino, NULL));
+    }
+
+    while (abiertos.tamano > 0) {
+        int u = extraer_minimo(&abiertos);
+        if (abiertos.prioridad[u] >= mejor) break;
+        sacadas++;
+
+        int celda = indice->celda_entrada[u];
+        if (bloque_de(indice, celda) == bloque_d) {
+            int d = distancia_d[local_de(indice, celda)];
+            if (d >= 0 && costo[u] + d < mejor) {
+                mejor = costo[u] + d;
+                ultima = u;
+            }
+        }
+
+        for (int k = indice->primer_enlace[u]; k < indice->primer_enlace[u + 1]; k++) {
+            int v = indice->enlaces[k].destino;
+            int nuevo = costo[u] + indice->enlaces[k].peso;
+            if (nuevo >= costo[v]) continue;
+            costo[v] = nuevo;
+            previa[v] = u;
+            insertar_o_mejorar(&abiertos, v,
+                               nuevo + heuristica_manhattan(indice->celda_entrada[v], destino, NULL));
+        }
+    }
+    destruir_monticulo(&abiertos);
+    if (expandidos != NULL) *expandidos = sacadas;
+
+    int largo = 0;
+    if (mejor == INFINITO) {
+        largo = 0;
+    } else if (ultima < 0) {
+        // Sin salir del bloque: anterior_o lleva del destino al origen
+        largo = mejor + 1;
+        int local = local_de(indice, destino);
+        for (int i = largo - 1; i >= 0; i--) {
+            camino[i] = celda_de_local(indice, bloque_o, local);
+            local = anterior_o[local];
+        }
+    } else {
+        // Entradas elegidas, en orden (costo ya no se usa)
+        int* tramo = costo;
+        int num_tramo = 0;
+        for (int e = ultima; e >= 0; e = previa[e]) tramo[num_tramo++] = e;
+        for (int i = 0; i < num_tramo / 2; i++) {
+            int temp = tramo[i];
+            tramo[i] = tramo[num_tramo - 1 - i];
+            tramo[num_tramo - 1 - i] = temp;
+        }
+
+        // Origen hasta la primera entrada
+        int primera = indice->celda_entrada[tramo[0]];
+        int local = local_de(indice, primera);
+        largo = distancia_o[local] + 1;
+        for (int i = largo - 1; i >= 0; i--) {
+            camino[i] = celda_de_local(indice, bloque_o, local);
+            local = anterior_o[local];
+        }
+
+        // Entre entradas: un paso si cambian de bloque, BFS local si no
+        for (int i = 0; i + 1 < num_tramo; i++) {
+            int a = indice->celda_entrada[tramo[i]];
+            int b = indice->celda_entrada[tramo[i + 1]];
+            int bloque = bloque_de(indice, a);
+            if (bloque_de(indice, b) != bloque) {
+                camino[largo++] = b;
+                continue;
+            }
+            recorrer_bloque(indice, b, distancia_o, anterior_o, cola);
+            for (int l = anterior_o[local_de(indice, a)]; l >= 0; l = anterior_o[l]) {
+                camino[largo++] = celda_de_local(indice, bloque, l);
+            }
+        }
+
+        // Última entrada hasta el destino: anterior_d apunta al destino
+        int desde = indice->celda_entrada[ultima];
+        for (int l = anterior_d[local_de(indice, desde)]; l >= 0; l = anterior_d[l]) {
+            camino[largo++] = celda_de_local(indice, bloque_d, l);
+        }
+    }
+
+    liberar_memoria(trabajo);
+    return largo;
+}
+
+/*
+ * resolver_lote_jerarquico
+ * Igual que resolver_lote_consultas pero sobre el índice. Los pasos solo
+ * se conocen al terminar cada búsqueda, así que el bloque de caminos
+ * crece al doble cuando hace falta. Retorna 0 sin memoria.
+ */
+int resolver_lote_jerarquico(const indice_jerarquico* indice, consulta_ruta* consultas,
+                             int cantidad, int con_camino, resumen_lote* resumen) {
+    memset(resumen, 0, sizeof(*resumen));
+    resumen->hilos = 1;
+    if (cantidad <= 0) return 1;
+
+    int* camino = (int*)reservar_memoria(MEM_ALGORITMOS, MAX_NODOS * sizeof(int));
+    size_t* inicio = con_camino ? (size_t*)reservar_memoria(MEM_ALGORITMOS,
+                                                           (size_t)cantidad * sizeof(size_t)) : NULL;
+    if (camino == NULL || (con_camino && inicio == NULL)) {
+        liberar_memoria(camino);
+        liberar_memoria(inicio);
+        return 0;
+    }
+
+    int* nodos = NULL;
+    size_t usado = 0, capacidad = 0;
+    int ok = 1;
+    for (int k = 0; k < cantidad && ok; k++) {
+        int expandidos;
+        int largo = camino_jerarquico(indice, consultas[k].origen, consultas[k].destino,
+                                      camino, &expandidos);
+        if (largo < 0) {
+            ok = 0;
+            break;
+        }
+        consultas[k].camino = NULL;
+        consultas[k].pasos = largo - 1;
+        resumen->visitados += expandidos;
+        if (!con_camino || largo == 0) continue;
+
+        if (usado + (size_t)largo > capacidad) {
+            size_t nueva = capacidad ? 2 * capacidad : (size_t)MAX_NODOS;
+            while (nueva < usado + (size_t)largo) nueva *= 2;
+            int* mayor = (int*)redimensionar_memoria(MEM_ALGORITMOS, nodos, nueva * sizeof(int));
+            if (mayor == NULL) {
+                ok = 0;
+                break;
+            }
+            nodos = mayor;
+            capacidad = nueva;
+        }
+        memcpy(nodos + usado, camino, (size_t)largo * sizeof(int));
+        inicio[k] = usado;
+        usado += (size_t)largo;
+    }
+
+    // El bloque pudo moverse al crecer: los punteros se fijan al final
+    if (ok && con_camino) {
+        for (int k = 0; k < cantidad; k++) {
+            if (consultas[k].pasos >= 0) consultas[k].camino = nodos + inicio[k];
+        }
+        resumen->nodos_caminos = nodos;
+    } else if (!ok) {
+        liberar_memoria(nodos);
+    }
+    liberar_memoria(camino);
+    liberar_memoria(inicio);
+    return ok;
+}
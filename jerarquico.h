@@ -0,0 +1,67 @@
+/*
+ * jerarquico.h
+ * Búsqueda jerárquica (HPA*) para laberintos grandes. La cuadrícula se
+ * parte en bloques fijos; las celdas de cruce entre bloques son los
+ * nodos de un grafo abstracto con las distancias internas de cada bloque
+ * ya calculadas. Una consulta busca en ese grafo y solo recorre celda por
+ * celda los bloques del origen, del destino y los tramos elegidos.
+ */
+
+#ifndef JERARQUICO_H
+#define JERARQUICO_H
+
+#include "laberinto.h"
+#include "consultas.h"
+
+// ============================================================================
+// DEFINICIONES DEL ÍNDICE
+// ============================================================================
+
+#ifndef TAM_BLOQUE_JERARQUICO
+#define TAM_BLOQUE_JERARQUICO 16    // Lado de cada bloque en celdas
+#endif
+
+#define ABIERTA_JERARQUICO 0x10     // Bit de celda transitable en vecinos
+
+/* enlace_jerarquico - Arista del grafo abstracto */
+typedef struct {
+    int destino;        // Entrada de llegada
+    int peso;           // Pasos (1 entre bloques, distancia BFS dentro de uno)
+} enlace_jerarquico;
+
+/*
+ * indice_jerarquico - Bloques, entradas y grafo abstracto
+ * Las entradas (celdas abiertas con un vecino abierto en otro bloque) van
+ * ordenadas por bloque: las del bloque b son [primera_entrada[b],
+ * primera_entrada[b + 1]). Las aristas están en formato CSR. Todas las
+ * celdas de cruce son entradas, así que las distancias son exactas.
+ */
+typedef struct {
+    int tam_bloque;                 // Lado de los bloques
+    int filas_bloques;              // Bloques por columna de la cuadrícula
+    int columnas_bloques;           // Bloques por fila
+    int num_entradas;               // Nodos del grafo abstracto
+    int num_enlaces;                // Aristas (cada sentido cuenta)
+    int* celda_entrada;             // Celda de cada entrada
+    int* primera_entrada;           // Por bloque, más un final
+    int* primer_enlace;             // Por entrada, más un final
+    enlace_jerarquico* enlaces;     // Aristas de todas las entradas
+    unsigned char* vecinos;         // Bits VECINO_* y ABIERTA_JERARQUICO por celda
+} indice_jerarquico;
+
+// ============================================================================
+// PROTOTIPOS DE FUNCIONES
+// ============================================================================
+
+/* Construcción */
+indice_jerarquico* construir_indice_jerarquico(laberinto* lab, int tam_bloque);
+void destruir_indice_jerarquico(indice_jerarquico* indice);
+const indice_jerarquico* indice_jerarquico_en_cache(laberinto* lab);
+
+/* Consultas */
+int camino_jerarquico(const indice_jerarquico* indice, int origen, int destino,
+                      int* camino, int* expandidos);
+int resolver_lote_jerarquico(const indice_jerarquico* indice, consulta_ruta* consultas,
+                             int cantidad, int con_camino, resumen_lote* resumen);
+
+#endif // JERARQUICO_H
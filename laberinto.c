@@ -8,10 +8,17 @@
 #include <stdlib.h>
 #include <time.h>
 #include <string.h>
-#include <unistd.h>
 #include "laberinto.h"
 #include "algoritmos.h"
+#include "compacto.h"
 #include "memes.h"
+#include "pantalla.h"
+#include "contadores.h"
+#include "memoria.h"
+#include "distancias.h"
+#include "contraccion.h"
+#include "jerarquico.h"
+#include "hitos.h"
 
 // Variables globales para generación
 #define MURO 1
@@ -26,7 +33,7 @@
  * Asigna nombre aleatorio o personalizado.
  */
 laberinto* crear_laberinto_segun_tipo(int tipo_generacion, const char* nombre) {
-    laberinto* lab = (laberinto*)malloc(sizeof(laberinto));  // Asigna memoria
+    laberinto* lab = (laberinto*)reservar_memoria(MEM_LABERINTO, sizeof(laberinto));
     if (!lab) return NULL;  // Verifica asignación
     
     // Configura dimensiones básicas
@@ -43,6 +50,21 @@ laberinto* crear_laberinto_segun_tipo(int tipo_generacion, const char* nombre) {
         lab->nombre[MAX_NOMBRE - 1] = '\0';  // Asegura terminación
     }
     
+    generar_celdas_segun_tipo(lab, tipo_generacion);  // Celdas, entrada y salida
+    calcular_solucion(lab);                           // Verifica y cuenta pasos
+    
+    return lab;  // Retorna laberinto creado
+}
+
+/*
+ * generar_celdas_segun_tipo
+ * Llena las celdas con el generador indicado y coloca entrada y salida.
+ * No calcula la solución (ver calcular_solucion).
+ */
+void generar_celdas_segun_tipo(laberinto* lab, int tipo_generacion) {
+    INICIAR_FASE(inicio_generacion);
+    invalidar_campo_distancias(lab);  // El campo anterior deja de valer
+    
     // Inicializa todas las celdas como paredes
     for (int i = 0; i < FILAS; i++) {
         for (int j = 0; j < COLUMNAS; j++) {
@@ -71,29 +93,33 @@ laberinto* crear_laberinto_segun_tipo(int tipo_generacion, const char* nombre) {
     if (lab->celdas[FILAS-2][COLUMNAS-1] == PARED) 
         lab->celdas[FILAS-2][COLUMNAS-1] = CAMINO; // Arriba de salida
     
-    // Verifica si tiene solución
-    lab->tiene_solucion = verificar_solucion(lab);
+    TERMINAR_FASE(FASE_GENERACION, inicio_generacion);
+}
+
+/*
+ * calcular_solucion
+ * Verifica si el laberinto tiene solución y guarda sus pasos.
+ * Recalcula el campo hasta FINAL y lee la distancia desde INICIO.
+ */
+void calcular_solucion(laberinto* lab) {
+    int fila, col;  // Posición de la entrada
     
-    // Calcula pasos de solución si existe
-    if (lab->tiene_solucion) {
-        int longitud;  // Longitud del camino
-        int* camino = resolver_laberinto(lab, 1, &longitud);  // Usa Dijkstra
-        if (camino && longitud > 0) {
-            lab->pasos_solucion = longitud - 1;  // Pasos totales
-        }
-    }
+    invalidar_campo_distancias(lab);  // Las celdas pueden haber cambiado
+    buscar_celda(lab, INICIO, &fila, &col);
+    int pasos = distancia_a_salida(lab, convertir_a_nodo(fila, col));
     
-    return lab;  // Retorna laberinto creado
+    lab->tiene_solucion = (pasos >= 0);
+    lab->pasos_solucion = lab->tiene_solucion ? pasos : 0;
 }
 
 /*
  * destruir_laberinto
  * Libera memoria de un laberinto.
- * Simple wrapper para free().
+ * Simple wrapper para liberar_memoria().
  */
 void destruir_laberinto(laberinto* lab) {
     if (lab) {         // Si no es NULL
-        free(lab);     // Libera memoria
+        liberar_memoria(lab);  // Libera memoria
     }
 }
 
@@ -105,7 +131,7 @@ void destruir_laberinto(laberinto* lab) {
  * Crea un camino principal (tronco) y múltiples ramas como un árbol.
  */
 void generar_aleatorio(laberinto* lab) {
-    srand(time(NULL));  // Inicializa generador aleatorio
+    sembrar_aleatorio(); // Inicializa generador aleatorio
     
     // Inicializa todas las celdas como paredes
     for (int i = 0; i < FILAS; i++) {
@@ -122,12 +148,25 @@ void generar_aleatorio(laberinto* lab) {
     int i = 0, j = 0;
     
     while (i < FILAS - 1 || j < COLUMNAS - 1) {
+        // El tronco puede repetir celdas: si llena el buffer se empieza de nuevo
+        if (longitud_principal == FILAS * COLUMNAS - 1) {
+            for (int f = 0; f < FILAS; f++) {
+                for (int c = 0; c < COLUMNAS; c++) {
+                    lab->celdas[f][c] = PARED;
+                }
+            }
+            longitud_principal = 0;
+            i = 0;
+            j = 0;
+        }
+        
         // Guardar posición actual en el camino principal
         camino_principal[longitud_principal][0] = i;
         camino_principal[longitud_principal][1] = j;
         longitud_principal++;
         
         lab->celdas[i][j] = CAMINO;  // Marcar como camino
+        CONTAR(celdas_excavadas);
         
         // Decidir dirección con tendencia hacia la salida
         int movimientos_posibles[4][2] = {{1,0}, {0,1}, {-1,0}, {0,-1}};  // abajo, derecha, arriba, izquierda
@@ -211,6 +250,7 @@ void generar_aleatorio(laberinto* lab) {
     camino_principal[longitud_principal][1] = j;
     longitud_principal++;
     lab->celdas[i][j] = CAMINO;
+    CONTAR(celdas_excavadas);
     
     // ===== PASO 2: Crear ramas desde el tronco principal =====
     int dirs[4][2] = {{-1,0}, {1,0}, {0,-1}, {0,1}};  // arriba, abajo, izquierda, derecha
@@ -301,6 +341,7 @@ void generar_aleatorio(laberinto* lab) {
                     if (rand() % 100 < 80) {
                         for (int r = 0; r < longitud_rama_real; r++) {
                             lab->celdas[rama_f[r]][rama_c[r]] = CAMINO;
+                            CONTAR(celdas_excavadas);
                             
                             // 20% de probabilidad de crear sub-ramas desde esta rama
                             if (rand() % 100 < 20 && r < longitud_rama_real - 1) {
@@ -347,6 +388,7 @@ void generar_aleatorio(laberinto* lab) {
                                         }
                                         
                                         lab->celdas[srf][src] = CAMINO;
+                                        CONTAR(celdas_excavadas);
                                     }
                                 }
                             }
@@ -407,6 +449,7 @@ void generar_aleatorio(laberinto* lab) {
                 }
                 
                 lab->celdas[nf][nc] = CAMINO;
+                CONTAR(celdas_excavadas);
             }
         }
     }
@@ -433,6 +476,7 @@ void generar_aleatorio(laberinto* lab) {
                     else if (f < FILAS-1) lab->celdas[f+1][c] = CAMINO;
                     else if (c > 0) lab->celdas[f][c-1] = CAMINO;
                     else if (c < COLUMNAS-1) lab->celdas[f][c+1] = CAMINO;
+                    CONTAR(celdas_excavadas);
                 }
             }
         }
@@ -446,7 +490,7 @@ void generar_aleatorio(laberinto* lab) {
  * Crea laberinto con múltiples caminos posibles y algunos ciclos.
  */
 void generar_desde_grafo(laberinto* lab) {
-    srand(time(NULL));  // Inicializa generador
+    sembrar_aleatorio(); // Inicializa generador
     
     // Inicializa todo como paredes
     for (int i = 0; i < FILAS; i++) {
@@ -462,6 +506,7 @@ void generar_desde_grafo(laberinto* lab) {
     for (int i = 1; i < FILAS-1; i += 2) {
         for (int j = 1; j < COLUMNAS-1; j += 2) {
             lab->celdas[i][j] = CAMINO;  // Celda de camino (nodo del grafo)
+            CONTAR(celdas_excavadas);
         }
     }
     
@@ -543,6 +588,7 @@ void generar_desde_grafo(laberinto* lab) {
             if (conjunto[nodo1_fila][nodo1_col] != conjunto[nodo2_fila][nodo2_col]) {
                 // Quitar la pared
                 lab->celdas[fila_pared][col_pared] = CAMINO;
+                CONTAR(celdas_excavadas);
                 
                 // Unir conjuntos
                 int conjunto_viejo = conjunto[nodo2_fila][nodo2_col];
@@ -559,6 +605,7 @@ void generar_desde_grafo(laberinto* lab) {
                 // Ocasionalmente permitir ciclos (30% de probabilidad)
                 if (rand() % 100 < 30) {
                     lab->celdas[fila_pared][col_pared] = CAMINO;
+                    CONTAR(celdas_excavadas);
                 }
             }
         }
@@ -568,11 +615,13 @@ void generar_desde_grafo(laberinto* lab) {
     // Conectar entrada (0,0)
     if (lab->celdas[1][0] == PARED && lab->celdas[0][1] == PARED) {
         lab->celdas[1][0] = CAMINO;  // Conectar hacia abajo
+        CONTAR(celdas_excavadas);
     }
     
     // Conectar salida (FILAS-1, COLUMNAS-1)
     if (lab->celdas[FILAS-2][COLUMNAS-1] == PARED && lab->celdas[FILAS-1][COLUMNAS-2] == PARED) {
         lab->celdas[FILAS-1][COLUMNAS-2] = CAMINO;  // Conectar hacia izquierda
+        CONTAR(celdas_excavadas);
     }
     
     // Añadir algunos caminos adicionales aleatorios para más complejidad
@@ -595,6 +644,7 @@ void generar_desde_grafo(laberinto* lab) {
                 // 50% de probabilidad de añadir este camino extra
                 if (rand() % 100 < 50) {
                     lab->celdas[pared_fila][pared_col] = CAMINO;
+                    CONTAR(celdas_excavadas);
                 }
             }
         }
@@ -607,7 +657,7 @@ void generar_desde_grafo(laberinto* lab) {
  * Garantiza un único camino entre cualquier par de nodos.
  */
 void generar_perfecto(laberinto* lab) {
-    srand(time(NULL));  // Inicializa generador
+    sembrar_aleatorio(); // Inicializa generador
     
     // Inicializa todo como paredes
     for (int i = 0; i < FILAS; i++) {
@@ -620,6 +670,7 @@ void generar_perfecto(laberinto* lab) {
     for (int i = 1; i < FILAS-1; i += 2) {
         for (int j = 1; j < COLUMNAS-1; j += 2) {
             lab->celdas[i][j] = CAMINO;  // Celda de camino
+            CONTAR(celdas_excavadas);
         }
     }
     
@@ -632,6 +683,7 @@ void generar_perfecto(laberinto* lab) {
     pila[tope][0] = fila;  // Guarda fila
     pila[tope][1] = col;   // Guarda columna
     tope++;                // Incrementa tope
+    CONTAR(apilados_dfs);
     
     int visitado[FILAS][COLUMNAS] = {0};  // Matriz de visitados
     visitado[fila][col] = 1;              // Marca como visitado
@@ -664,11 +716,13 @@ void generar_perfecto(laberinto* lab) {
             
             // Quita la pared entre las celdas
             lab->celdas[fila + direcciones[dir][0]/2][col + direcciones[dir][1]/2] = CAMINO;
+            CONTAR(celdas_excavadas);
             
             visitado[nf][nc] = 1;          // Marca como visitado
             pila[tope][0] = nf;            // Guarda nueva fila
             pila[tope][1] = nc;            // Guarda nueva columna
             tope++;                        // Incrementa tope
+            CONTAR(apilados_dfs);
         } else {
             tope--;  // Backtrack: retrocede
         }
@@ -677,97 +731,14 @@ void generar_perfecto(laberinto* lab) {
 
 /*
  * generar_con_backtracking
- * Genera laberinto usando backtracking recursivo.
- * Implementación clásica de generación de laberintos.
+ * Genera laberinto usando backtracking sobre la representación compacta.
+ * Trabaja con un byte por habitación y luego expande a celdas.
  */
 void generar_con_backtracking(laberinto* lab) {
-    srand(time(NULL));  // Inicializa generador
-    
-    // Inicializa todo como paredes
-    for (int i = 0; i < FILAS; i++) {
-        for (int j = 0; j < COLUMNAS; j++) {
-            lab->celdas[i][j] = PARED;  // Pared por defecto
-        }
-    }
+    laberinto_compacto compacto;            // Habitaciones con bits de pared
     
-    // Calcula dimensiones internas (celdas impares)
-    int filas_interiores = (FILAS - 1) / 2;
-    int cols_interiores = (COLUMNAS - 1) / 2;
-    
-    int maze[filas_interiores][cols_interiores];  // Laberinto interno
-    
-    // Inicializa laberinto interno
-    for (int i = 0; i < filas_interiores; i++) {
-        for (int j = 0; j < cols_interiores; j++) {
-            maze[i][j] = 0;  // 0 = no visitado
-        }
-    }
-    
-    int pila[filas_interiores * cols_interiores][2];  // Pila para backtracking
-    int tope = 0;                                     // Índice del tope
-    
-    // Empieza desde (0,0)
-    int x = 0, y = 0;
-    maze[x][y] = 1;            // Marca como visitado
-    pila[tope][0] = x;         // Guarda x
-    pila[tope][1] = y;         // Guarda y
-    tope++;                    // Incrementa tope
-    
-    int direcciones[4][2] = {{0, 1}, {1, 0}, {0, -1}, {-1, 0}};  // 4 direcciones
-    
-    while (tope > 0) {  // Mientras haya celdas en pila
-        x = pila[tope-1][0];  // Obtiene x del tope
-        y = pila[tope-1][1];  // Obtiene y del tope
-        
-        // Encuentra vecinos no visitados
-        int vecinos[4];
-        int num_vecinos = 0;
-        
-        for (int d = 0; d < 4; d++) {
-            int nx = x + direcciones[d][0];  // Nuevo x
-            int ny = y + direcciones[d][1];  // Nuevo y
-            
-            // Verifica límites y si no está visitado
-            if (nx >= 0 && nx < filas_interiores && ny >= 0 && ny < cols_interiores &&
-                maze[nx][ny] == 0) {
-                vecinos[num_vecinos++] = d;  // Agrega dirección
-            }
-        }
-        
-        if (num_vecinos > 0) {  // Si hay vecinos disponibles
-            int dir = vecinos[rand() % num_vecinos];  // Dirección aleatoria
-            int nx = x + direcciones[dir][0];         // Nuevo x
-            int ny = y + direcciones[dir][1];         // Nuevo y
-            
-            maze[nx][ny] = 1;  // Marca como visitado
-            
-            // Convierte coordenadas internas a reales
-            int real_x1 = x * 2 + 1;
-            int real_y1 = y * 2 + 1;
-            int real_x2 = nx * 2 + 1;
-            int real_y2 = ny * 2 + 1;
-            
-            // Crea caminos en el laberinto real
-            lab->celdas[real_x1][real_y1] = CAMINO;                         // Celda actual
-            lab->celdas[real_x2][real_y2] = CAMINO;                         // Celda vecina
-            lab->celdas[(real_x1 + real_x2) / 2][(real_y1 + real_y2) / 2] = CAMINO;  // Pared entre
-            
-            pila[tope][0] = nx;  // Guarda nuevo x
-            pila[tope][1] = ny;  // Guarda nuevo y
-            tope++;              // Incrementa tope
-        } else {
-            tope--;  // Backtrack: retrocede
-        }
-    }
-    
-    // Copia caminos del laberinto interno al real
-    for (int i = 0; i < filas_interiores; i++) {
-        for (int j = 0; j < cols_interiores; j++) {
-            if (maze[i][j] == 1) {
-                lab->celdas[i * 2 + 1][j * 2 + 1] = CAMINO;  // Convierte a camino real
-            }
-        }
-    }
+    generar_perfecto_compacto(&compacto);   // Backtracking nativo en habitaciones
+    compacto_a_celdas(&compacto, lab);      // Expande al formato de bloques
 }
 
 
@@ -777,168 +748,130 @@ void generar_con_backtracking(laberinto* lab) {
 /*
  * imprimir_laberinto
  * Muestra el laberinto en formato gráfico.
- * Usa caracteres especiales y colores ANSI.
+ * Arma el cuadro completo en el buffer de pantalla.c y lo escribe de una vez.
  */
 void imprimir_laberinto(laberinto* lab) {
-    printf(COLOR_CYAN "\n=== LABERINTO: %s ===\n" COLOR_RESET, lab->nombre);
-    printf("Tamaño: %d x %d | Solución: %s | Pasos solución: %d\n\n", 
-           lab->filas, lab->columnas,
-           lab->tiene_solucion ? "SÍ" : "NO",
-           lab->pasos_solucion);
-    
-    // Leyenda de símbolos
-    printf(COLOR_VERDE "E" COLOR_RESET "=Entrada  ");
-    printf(COLOR_ROJO "S" COLOR_RESET "=Salida  ");
-    printf("  =Camino  ");
-    printf(COLOR_BLANCO "*️⃣" COLOR_RESET "=Pared\n\n");
-    
-    // Borde superior
-    printf("  ");
-    for (int j = 0; j < lab->columnas; j++) {
-        printf(COLOR_BLANCO "*️⃣*️⃣" COLOR_RESET);  // Dos caracteres por celda
-    }
-    printf(COLOR_BLANCO "*️⃣\n" COLOR_RESET);
+    int alto, ancho;    // Celdas que caben en la terminal
     
-    // Contenido del laberinto
-    for (int i = 0; i < lab->filas; i++) {
-        printf("  " COLOR_BLANCO "*️⃣" COLOR_RESET);  // Borde izquierdo
-        
-        for (int j = 0; j < lab->columnas; j++) {
-            // Selecciona símbolo según tipo de celda
-            switch (lab->celdas[i][j]) {
-                case INICIO:
-                    printf(COLOR_VERDE "E " COLOR_RESET);  // Entrada (verde)
-                    break;
-                case FINAL:
-                    printf(COLOR_ROJO "S " COLOR_RESET);   // Salida (rojo)
-                    break;
-                case CAMINO:
-                    printf("  ");                         // Camino (espacio)
-                    break;
-                case PARED:
-                    printf(COLOR_BLANCO "*️⃣ " COLOR_RESET); // Pared (blanco)
-                    break;
-                case VISITADO:
-                    printf(COLOR_AMARILLO ". " COLOR_RESET); // Visitado (amarillo)
-                    break;
-                case SOLUCION:
-                    printf(COLOR_VERDE "· " COLOR_RESET);   // Solución (verde)
-                    break;
-                default:
-                    printf("  ");                         // Por defecto
-                    break;
-            }
-        }
-        
-        printf(COLOR_BLANCO "*️⃣\n" COLOR_RESET);  // Borde derecho
-    }
+    iniciar_marco();    // Cuadro nuevo en el buffer compartido
+    
+    marco_color(COLOR_CYAN);
+    marco_formato("\n=== LABERINTO: %s ===\n", lab->nombre);
+    marco_color(COLOR_RESET);
+    marco_formato("Tamaño: %d x %d | Solución: %s | Pasos solución: %d\n\n", 
+                  lab->filas, lab->columnas,
+                  lab->tiene_solucion ? "SÍ" : "NO",
+                  lab->pasos_solucion);
     
-    // Borde inferior
-    printf("  ");
-    for (int j = 0; j < lab->columnas; j++) {
-        printf(COLOR_BLANCO "*️⃣*️⃣" COLOR_RESET);  // Dos caracteres por celda
+    marco_leyenda(0);             // Leyenda de símbolos
+    
+    // Si no cabe en la terminal, solo se dibuja la ventana alrededor de la entrada
+    celdas_visibles(LINEAS_RESERVADAS_VISTA, &alto, &ancho);
+    if (lab->filas <= alto && lab->columnas <= ancho) {
+        marco_laberinto(lab, NULL);   // Rejilla con bordes
+    } else {
+        int fila, col;
+        buscar_celda(lab, INICIO, &fila, &col);
+        marco_ventana(lab, NULL, fila, col, alto, ancho);
     }
-    printf(COLOR_BLANCO "*️⃣\n" COLOR_RESET);
+    volcar_marco();               // Una sola escritura
 }
 
 /*
- * imprimir_laberinto_con_solucion
- * Muestra laberinto con camino solución resaltado.
- * Copia temporalmente el laberinto para marcar solución.
+ * imprimir_laberinto_ventana
+ * Muestra solo la parte del laberinto que cabe en la terminal
+ * alrededor de la celda foco.
  */
-void imprimir_laberinto_con_solucion(laberinto* lab, int* camino, int longitud) {
-    printf(COLOR_CYAN "\n=== LABERINTO CON SOLUCIÓN ===\n" COLOR_RESET);
-    
-    int temp[FILAS][COLUMNAS];  // Matriz temporal
+void imprimir_laberinto_ventana(laberinto* lab, int fila_foco, int col_foco) {
+    int alto, ancho;    // Celdas que caben en la terminal
     
-    // Copia el laberinto original
-    for (int i = 0; i < FILAS; i++) {
-        for (int j = 0; j < COLUMNAS; j++) {
-            temp[i][j] = lab->celdas[i][j];  // Copia valor
-        }
-    }
+    celdas_visibles(LINEAS_RESERVADAS_VISTA, &alto, &ancho);
     
-    // Marca el camino de solución
-    for (int i = 0; i < longitud; i++) {
-        int nodo = camino[i];                     // Nodo del camino
-        int fila = nodo / COLUMNAS;               // Calcula fila
-        int col = nodo % COLUMNAS;                // Calcula columna
+    iniciar_marco();
+    marco_color(COLOR_CYAN);
+    marco_formato("\n=== LABERINTO: %s (%d x %d) ===\n", lab->nombre, lab->filas, lab->columnas);
+    marco_color(COLOR_RESET);
+    marco_ventana(lab, NULL, fila_foco, col_foco, alto, ancho);
+    volcar_marco();
+}
+
+/*
+ * imprimir_vista_general
+ * Muestra el laberinto reducido a bloques de k x k celdas.
+ * Con bloque <= 0 elige el menor bloque que cabe en la terminal.
+ * El mapa (crear_mapa_vista) se arma una vez y sirve para todos los cuadros.
+ */
+void imprimir_vista_general(laberinto* lab, const mapa_vista* mapa, int bloque) {
+    if (bloque <= 0) {
+        int alto, ancho;
+        celdas_visibles(LINEAS_RESERVADAS_VISTA, &alto, &ancho);
         
-        // Marca como solución (excepto entrada/salida)
-        if (temp[fila][col] != INICIO && temp[fila][col] != FINAL) {
-            temp[fila][col] = SOLUCION;  // Celda de solución
+        bloque = 1;
+        while ((lab->filas + bloque - 1) / bloque > alto ||
+               (lab->columnas + bloque - 1) / bloque > ancho) {
+            bloque++;   // Agranda el bloque hasta que quepa
         }
     }
     
-    printf("Tamaño: %d x %d\n\n", lab->filas, lab->columnas);
-    
-    // Leyenda de símbolos
-    printf(COLOR_VERDE "E" COLOR_RESET "=Entrada  ");
-    printf(COLOR_ROJO "S" COLOR_RESET "=Salida  ");
-    printf(COLOR_VERDE "·" COLOR_RESET "=Solución  ");
-    printf(COLOR_BLANCO "*️⃣" COLOR_RESET "=Pared\n\n");
-    
-    // Borde superior
-    printf("  ");
-    for (int j = 0; j < lab->columnas; j++) {
-        printf(COLOR_BLANCO "*️⃣*️⃣" COLOR_RESET);  // Dos caracteres por celda
-    }
-    printf(COLOR_BLANCO "*️⃣\n" COLOR_RESET);
-    
-    // Contenido del laberinto con solución
+    iniciar_marco();
+    marco_color(COLOR_CYAN);
+    marco_formato("\n=== LABERINTO: %s (%d x %d) ===\n", lab->nombre, lab->filas, lab->columnas);
+    marco_color(COLOR_RESET);
+    marco_vista_general(lab, mapa, bloque);
+    volcar_marco();
+}
+
+/*
+ * buscar_celda
+ * Busca la primera celda del tipo indicado.
+ * Deja (0, 0) si no existe.
+ */
+void buscar_celda(laberinto* lab, int tipo, int* fila, int* col) {
+    *fila = 0;
+    *col = 0;
     for (int i = 0; i < lab->filas; i++) {
-        printf("  " COLOR_BLANCO "*️⃣" COLOR_RESET);  // Borde izquierdo
-        
         for (int j = 0; j < lab->columnas; j++) {
-            // Selecciona símbolo según tipo de celda
-            switch (temp[i][j]) {
-                case INICIO:
-                    printf(COLOR_VERDE "E " COLOR_RESET);  // Entrada
-                    break;
-                case FINAL:
-                    printf(COLOR_ROJO "S " COLOR_RESET);   // Salida
-                    break;
-                case CAMINO:
-                    printf("  ");                         // Camino normal
-                    break;
-                case PARED:
-                    printf(COLOR_BLANCO "*️⃣ " COLOR_RESET); // Pared
-                    break;
-                case VISITADO:
-                    printf(COLOR_AMARILLO ". " COLOR_RESET); // Visitado
-                    break;
-                case SOLUCION:
-                    printf(COLOR_VERDE "· " COLOR_RESET);   // Solución
-                    break;
-                default:
-                    printf("  ");                         // Por defecto
-                    break;
+            if (lab->celdas[i][j] == tipo) {
+                *fila = i;
+                *col = j;
+                return;
             }
         }
-        
-        printf(COLOR_BLANCO "*️⃣\n" COLOR_RESET);  // Borde derecho
     }
+}
+
+/*
+ * imprimir_laberinto_con_solucion
+ * Muestra laberinto con camino solución resaltado.
+ * Superpone las marcas del camino sin copiar la matriz.
+ */
+void imprimir_laberinto_con_solucion(laberinto* lab, int* camino, int longitud) {
+    unsigned char marcas[MAX_NODOS];   // Nodos de la solución
     
-    // Borde inferior
-    printf("  ");
-    for (int j = 0; j < lab->columnas; j++) {
-        printf(COLOR_BLANCO "*️⃣*️⃣" COLOR_RESET);  // Dos caracteres por celda
-    }
-    printf(COLOR_BLANCO "*️⃣\n" COLOR_RESET);
+    marcar_camino(marcas, camino, longitud);
+    iniciar_marco();
+    
+    marco_color(COLOR_CYAN);
+    marco_texto("\n=== LABERINTO CON SOLUCIÓN ===\n");
+    marco_color(COLOR_RESET);
+    marco_formato("Tamaño: %d x %d\n\n", lab->filas, lab->columnas);
     
-    printf("\nLongitud del camino solución: %d pasos\n", longitud - 1);
+    marco_leyenda(1);               // Leyenda de símbolos
+    marco_laberinto(lab, marcas);   // Rejilla con la solución superpuesta
+    marco_formato("\nLongitud del camino solución: %d pasos\n", longitud - 1);
+    volcar_marco();
 }
 
 // ==================== RESOLUCIÓN ====================
 
 /*
- * resolver_laberinto
- * Convierte laberinto a grafo y aplica algoritmo de resolución.
- * Soporta Dijkstra y BFS para encontrar caminos.
+ * laberinto_a_grafo
+ * Convierte el laberinto en grafo: un nodo por celda y aristas de peso 1
+ * entre celdas adyacentes que no son pared.
  */
-int* resolver_laberinto(laberinto* lab, int algoritmo, int* longitud) {
-    grafo_matriz grafo;  // Grafo para representación
-    inicializar_grafo_matriz(&grafo, FILAS * COLUMNAS);  // Inicializa grafo
+void laberinto_a_grafo(laberinto* lab, grafo_matriz* grafo) {
+    INICIAR_FASE(inicio_conversion);
+    inicializar_grafo_matriz(grafo, FILAS * COLUMNAS);  // Inicializa grafo
     
     // Convierte laberinto a grafo (conexiones entre celdas adyacentes)
     for (int i = 0; i < FILAS; i++) {
@@ -948,40 +881,52 @@ int* resolver_laberinto(laberinto* lab, int algoritmo, int* longitud) {
                 
                 // Conexión con vecino arriba
                 if (i > 0 && lab->celdas[i-1][j] != PARED) {
-                    agregar_arista_matriz(&grafo, nodo, (i-1)*COLUMNAS + j, 1);
+                    agregar_arista_matriz(grafo, nodo, (i-1)*COLUMNAS + j, 1);
                 }
                 // Conexión con vecino izquierda
                 if (j > 0 && lab->celdas[i][j-1] != PARED) {
-                    agregar_arista_matriz(&grafo, nodo, i*COLUMNAS + (j-1), 1);
+                    agregar_arista_matriz(grafo, nodo, i*COLUMNAS + (j-1), 1);
                 }
                 // Conexión con vecino abajo
                 if (i < FILAS-1 && lab->celdas[i+1][j] != PARED) {
-                    agregar_arista_matriz(&grafo, nodo, (i+1)*COLUMNAS + j, 1);
+                    agregar_arista_matriz(grafo, nodo, (i+1)*COLUMNAS + j, 1);
                 }
                 // Conexión con vecino derecha
                 if (j < COLUMNAS-1 && lab->celdas[i][j+1] != PARED) {
-                    agregar_arista_matriz(&grafo, nodo, i*COLUMNAS + (j+1), 1);
+                    agregar_arista_matriz(grafo, nodo, i*COLUMNAS + (j+1), 1);
                 }
             }
         }
     }
     
-    int inicio = 0;                          // Entrada en (0,0)
-    int fin = FILAS * COLUMNAS - 1;          // Salida en última posición
-    static int camino[MAX_NODOS];            // Array para camino
-    *longitud = 0;                           // Inicializa longitud
+    TERMINAR_FASE(FASE_CONVERSION, inicio_conversion);
+}
+
+/*
+ * resolver_con_matriz
+ * Dijkstra (1), BFS (2) y A* (3) sobre la matriz de celdas.
+ * La matriz (MAX_NODOS² enteros) va en el heap: en la pila no cabe en
+ * laberintos grandes. Deja el camino en camino y su largo en longitud.
+ */
+static void resolver_con_matriz(laberinto* lab, int algoritmo, int inicio, int fin,
+                                int* camino, int* longitud) {
+    grafo_matriz* grafo = (grafo_matriz*)reservar_memoria(MEM_GRAFO, sizeof(grafo_matriz));
+    if (grafo == NULL) {  // Sin memoria: el llamador lo informa como sin camino
+        return;
+    }
+    laberinto_a_grafo(lab, grafo);  // Conexiones entre celdas adyacentes
     
     switch (algoritmo) {
         case 1: { // Dijkstra
             int distancia;  // Distancia total
-            int* anterior = dijkstra_con_estados(&grafo, inicio, fin, &distancia, 0);
+            int* anterior = dijkstra_con_estados(grafo, inicio, fin, &distancia, 0);
             
             if (distancia == -1 || anterior == NULL) {  // Si no hay camino
-                printf("No hay camino desde inicio a fin\n");
-                break;
+                break;                                   // El llamador lo informa
             }
             
             // Reconstruye camino desde fin hasta inicio
+            INICIAR_FASE(inicio_reconstruccion);
             int nodo = fin;
             while (nodo != -1) {
                 camino[*longitud] = nodo;  // Agrega nodo al camino
@@ -995,11 +940,12 @@ int* resolver_laberinto(laberinto* lab, int algoritmo, int* longitud) {
                 camino[i] = camino[*longitud - i - 1];  // Intercambia
                 camino[*longitud - i - 1] = temp;       // Completa intercambio
             }
+            TERMINAR_FASE(FASE_RECONSTRUCCION, inicio_reconstruccion);
             break;
         }
         
         case 2: { // BFS
-            int* anterior = bfs(&grafo, inicio);  // BFS desde inicio
+            int* anterior = bfs(grafo, inicio);  // BFS desde inicio
             
             if (anterior == NULL) {  // Si error en BFS
                 printf("Error en BFS\n");
@@ -1007,6 +953,7 @@ int* resolver_laberinto(laberinto* lab, int algoritmo, int* longitud) {
             }
             
             // Reconstruye camino desde fin hasta inicio
+            INICIAR_FASE(inicio_reconstruccion);
             int nodo = fin;
             while (nodo != -1 && anterior[nodo] != -1) {
                 camino[*longitud] = nodo;  // Agrega nodo al camino
@@ -1021,8 +968,7 @@ int* resolver_laberinto(laberinto* lab, int algoritmo, int* longitud) {
             }
             
             if (*longitud == 0) {  // Si no se encontró camino
-                printf("No hay camino desde inicio a fin\n");
-                break;
+                break;             // El llamador lo informa
             }
             
             // Invierte el camino
@@ -1031,6 +977,29 @@ int* resolver_laberinto(laberinto* lab, int algoritmo, int* longitud) {
                 camino[i] = camino[*longitud - i - 1];  // Intercambia
                 camino[*longitud - i - 1] = temp;       // Completa intercambio
             }
+            TERMINAR_FASE(FASE_RECONSTRUCCION, inicio_reconstruccion);
+            break;
+        }
+        
+        case 3: { // A* con distancia Manhattan (pasos de peso 1)
+            int distancia;
+            int* anterior = a_estrella(grafo, inicio, fin, &distancia,
+                                       heuristica_manhattan, NULL, NULL);
+            
+            if (distancia == -1 || anterior == NULL) {
+                break;
+            }
+            
+            INICIAR_FASE(inicio_reconstruccion);
+            for (int nodo = fin; nodo != -1; nodo = anterior[nodo]) {
+                camino[(*longitud)++] = nodo;
+            }
+            for (int i = 0; i < *longitud / 2; i++) {
+                int temp = camino[i];
+                camino[i] = camino[*longitud - i - 1];
+                camino[*longitud - i - 1] = temp;
+            }
+            TERMINAR_FASE(FASE_RECONSTRUCCION, inicio_reconstruccion);
             break;
         }
         
@@ -1040,7 +1009,49 @@ int* resolver_laberinto(laberinto* lab, int algoritmo, int* longitud) {
             break;
     }
     
-    liberar_grafo_matriz(&grafo);  // Libera grafo
+    liberar_grafo_matriz(grafo);  // Libera grafo
+    liberar_memoria(grafo);
+}
+
+/*
+ * resolver_laberinto
+ * Aplica un algoritmo de resolución al laberinto.
+ * Soporta Dijkstra (1), BFS (2), A* (3), Dijkstra sobre el grafo de
+ * pasillos contraído (4), búsqueda jerárquica por bloques (5) y A* con
+ * hitos (6, k de fijar_hitos_alt) para encontrar caminos. Solo 1, 2 y 3
+ * construyen la matriz de celdas.
+ */
+int* resolver_laberinto(laberinto* lab, int algoritmo, int* longitud) {
+    int inicio = 0;                          // Entrada en (0,0)
+    int fin = FILAS * COLUMNAS - 1;          // Salida en última posición
+    static int camino[MAX_NODOS];            // Array para camino
+    *longitud = 0;                           // Inicializa longitud
+    
+    if (algoritmo == 4) {  // Grafo contraído
+        int extremos[2] = {inicio, fin};     // Quedan como nodos clave
+        grafo_contraido* contraido = contraer_laberinto(lab, extremos, 2);
+        if (contraido != NULL) {
+            *longitud = camino_contraido(contraido, inicio, fin, camino);
+            destruir_grafo_contraido(contraido);
+        }
+    } else if (algoritmo == 5) {  // Índice por bloques, reutilizado mientras no cambie
+        const indice_jerarquico* indice = indice_jerarquico_en_cache(lab);
+        if (indice != NULL) {
+            *longitud = camino_jerarquico(indice, inicio, fin, camino, NULL);
+            if (*longitud < 0) *longitud = 0;   // Sin memoria: igual que sin camino
+        }
+    } else if (algoritmo == 6) {  // Tabla de hitos, reutilizada mientras no cambie
+        const tabla_hitos* hitos = hitos_en_cache(lab);
+        unsigned char* vecinos = (unsigned char*)reservar_memoria(MEM_ALGORITMOS, MAX_NODOS);
+        if (hitos != NULL && vecinos != NULL) {
+            calcular_vecinos_hitos(lab, vecinos);
+            *longitud = camino_hitos(vecinos, hitos, inicio, fin, camino, NULL);
+            if (*longitud < 0) *longitud = 0;   // Sin memoria: igual que sin camino
+        }
+        liberar_memoria(vecinos);
+    } else {
+        resolver_con_matriz(lab, algoritmo, inicio, fin, camino, longitud);
+    }
     
     if (*longitud > 0) {
         return camino;  // Retorna camino si existe
@@ -1090,7 +1101,7 @@ int contar_caminos_posibles(laberinto* lab) {
  * Usa índice aleatorio para seleccionar nombre.
  */
 int obtener_nombre_aleatorio(char* buffer) {
-    srand(time(NULL));                    // Inicializa generador
+    sembrar_aleatorio();                // Inicializa generador
     int indice = rand() % NUM_MEMES;      // Índice aleatorio
     strcpy(buffer, memes_anarquismo[indice]);  // Copia nombre
     return indice;                        // Retorna índice
@@ -1125,10 +1136,62 @@ int es_valida(int fila, int columna) {
             columna >= 0 && columna < COLUMNAS);  // Columna válida
 }
 
+/*
+ * huella_celdas
+ * FNV-1a de 64 bits sobre la cuadrícula: distingue laberintos sin
+ * guardar una copia de las celdas. La usan las cachés de índices.
+ */
+uint64_t huella_celdas(laberinto* lab) {
+    const unsigned char* bytes = (const unsigned char*)lab->celdas;
+    uint64_t huella = 1469598103934665603ULL;
+
+    for (size_t i = 0; i < sizeof(lab->celdas); i++) {
+        huella ^= bytes[i];
+        huella *= 1099511628211ULL;
+    }
+    return huella;
+}
+
+/*
+ * ventana_animacion - Parte del laberinto que muestra la animación
+ * Si el laberinto no cabe en la terminal es una ventana que se desplaza
+ * con el camino; las marcas guardan los pasos ya mostrados para
+ * redibujarla.
+ */
+typedef struct {
+    int f0, c0;                 // Primera fila y columna visibles
+    int alto, ancho;            // Celdas visibles
+    int linea_base;             // Línea de terminal de la fila f0
+    unsigned char* marcas;      // Pasos mostrados (NULL si cabe completo)
+} ventana_animacion;
+
+/*
+ * dibujar_cuadro_animacion
+ * Cuadro completo: contador y laberinto entero, o la ventana centrada
+ * en (fila, col) si no cabe.
+ */
+static void dibujar_cuadro_animacion(laberinto* lab, ventana_animacion* v, int fila, int col,
+                                     int mostrados, int longitud) {
+    iniciar_marco();
+    marco_texto("\033[2J\033[H");  // Limpia pantalla (ANSI)
+    marco_formato("Tamaño: %d x %d | Paso: %d/%d\n\n", lab->filas, lab->columnas,
+                  mostrados, longitud);
+    if (v->marcas == NULL) {
+        marco_laberinto(lab, NULL);
+    } else {
+        v->f0 = recortar_ventana(fila, &v->alto, lab->filas);
+        v->c0 = recortar_ventana(col, &v->ancho, lab->columnas);
+        marco_ventana(lab, v->marcas, fila, col, v->alto, v->ancho);
+    }
+    volcar_marco();
+}
+
 /*
  * animar_solucion
  * Muestra animación paso a paso del camino solución.
- * Limpia pantalla entre cada paso para efecto animado.
+ * Dibuja el laberinto una vez y luego solo las celdas nuevas de cada
+ * cuadro. Si no cabe en la terminal anima una ventana que se redibuja
+ * centrada en el camino cuando este sale de ella.
  */
 void animar_solucion(laberinto* lab, int* camino, int longitud) {
     if (longitud == 0 || camino == NULL) {  // Si no hay solución
@@ -1138,82 +1201,70 @@ void animar_solucion(laberinto* lab, int* camino, int longitud) {
     
     printf(COLOR_MAGENTA "\n=== ANIMANDO SOLUCIÓN ===\n" COLOR_RESET);
     
-    for (int paso = 0; paso < longitud; paso++) {
-        printf("\033[2J\033[H");  // Limpia pantalla (ANSI)
-        
-        int temp[FILAS][COLUMNAS];  // Matriz temporal
-        
-        // Copia el laberinto original
-        for (int i = 0; i < FILAS; i++) {
-            for (int j = 0; j < COLUMNAS; j++) {
-                temp[i][j] = lab->celdas[i][j];  // Copia valor
-            }
-        }
+    // Cuadro base: encabezado (línea 1), línea en blanco, borde y rejilla;
+    // la ventana agrega su línea de título
+    ventana_animacion v = {0, 0, lab->filas, lab->columnas, 4, NULL};
+    int alto, ancho;
+    celdas_visibles(LINEAS_RESERVADAS_ANIMACION, &alto, &ancho);
+    if (lab->filas > alto || lab->columnas > ancho) {
+        v.marcas = (unsigned char*)reservar_memoria_cero(MEM_PANTALLA, MAX_NODOS, 1);
+        if (v.marcas == NULL) return;
+        v.alto = alto;
+        v.ancho = ancho;
+        v.linea_base = 5;
+    }
+    dibujar_cuadro_animacion(lab, &v, camino[0] / COLUMNAS, camino[0] % COLUMNAS, 0, longitud);
+    
+    // Caminos largos agrupan pasos para no pasar de la duración máxima
+    int cuadros = DURACION_MAXIMA_ANIMACION_MS / INTERVALO_ANIMACION_MS;
+    int pasos_por_cuadro = (longitud + cuadros - 1) / cuadros;
+    if (pasos_por_cuadro < 1) pasos_por_cuadro = 1;
+    
+    long inicio = tiempo_monotonico_ms();   // Reloj monotónico
+    int mostrados = 0;                      // Pasos ya dibujados
+    
+    while (mostrados < longitud) {
+        // Cuadros vencidos hasta ahora: si hubo retraso, se ponen al día juntos
+        int cuadro = (int)((tiempo_monotonico_ms() - inicio) / INTERVALO_ANIMACION_MS) + 1;
+        int objetivo = cuadro * pasos_por_cuadro;
+        if (objetivo > longitud) objetivo = longitud;
+        int fuera = 0;                       // Algún paso quedó fuera de la ventana
         
-        // Marca camino hasta este paso
-        for (int i = 0; i <= paso; i++) {
-            int nodo = camino[i];          // Nodo del camino
-            int fila = nodo / COLUMNAS;    // Calcula fila
-            int col = nodo % COLUMNAS;     // Calcula columna
+        iniciar_marco();
+        for (; mostrados < objetivo; mostrados++) {
+            int fila = camino[mostrados] / COLUMNAS;   // Calcula fila
+            int col = camino[mostrados] % COLUMNAS;    // Calcula columna
             
-            // Marca como solución (excepto entrada/salida)
-            if (temp[fila][col] != INICIO && temp[fila][col] != FINAL) {
-                temp[fila][col] = SOLUCION;  // Celda de solución
+            if (v.marcas != NULL) v.marcas[camino[mostrados]] = 1;
+            if (fila < v.f0 || fila >= v.f0 + v.alto || col < v.c0 || col >= v.c0 + v.ancho) {
+                fuera = 1;
+                continue;
             }
-        }
-        
-        printf("Tamaño: %d x %d | Paso: %d/%d\n\n", 
-               lab->filas, lab->columnas, paso+1, longitud);
-        
-        // Borde superior
-        printf("  ");
-        for (int j = 0; j < lab->columnas; j++) {
-            printf(COLOR_BLANCO "*️⃣*️⃣" COLOR_RESET);  // Dos caracteres por celda
-        }
-        printf(COLOR_BLANCO "*️⃣\n" COLOR_RESET);
-        
-        // Contenido del laberinto
-        for (int i = 0; i < lab->filas; i++) {
-            printf("  " COLOR_BLANCO "*️⃣" COLOR_RESET);  // Borde izquierdo
             
-            for (int j = 0; j < lab->columnas; j++) {
-                // Selecciona símbolo según tipo de celda
-                switch (temp[i][j]) {
-                    case INICIO:
-                        printf(COLOR_VERDE "E " COLOR_RESET);  // Entrada
-                        break;
-                    case FINAL:
-                        printf(COLOR_ROJO "S " COLOR_RESET);   // Salida
-                        break;
-                    case CAMINO:
-                        printf("  ");                         // Camino
-                        break;
-                    case PARED:
-                        printf(COLOR_BLANCO "*️⃣ " COLOR_RESET); // Pared
-                        break;
-                    case SOLUCION:
-                        printf(COLOR_VERDE "· " COLOR_RESET);   // Solución
-                        break;
-                    default:
-                        printf("  ");                         // Por defecto
-                        break;
-                }
+            // Entrada y salida conservan su símbolo
+            if (lab->celdas[fila][col] != INICIO && lab->celdas[fila][col] != FINAL) {
+                marco_celda_en(v.linea_base, fila - v.f0, col - v.c0, SOLUCION);
             }
-            
-            printf(COLOR_BLANCO "*️⃣\n" COLOR_RESET);  // Borde derecho
         }
         
-        // Borde inferior
-        printf("  ");
-        for (int j = 0; j < lab->columnas; j++) {
-            printf(COLOR_BLANCO "*️⃣*️⃣" COLOR_RESET);  // Dos caracteres por celda
+        if (fuera) {
+            // El camino salió de la ventana: se centra en el último paso
+            int ultimo = camino[mostrados - 1];
+            dibujar_cuadro_animacion(lab, &v, ultimo / COLUMNAS, ultimo % COLUMNAS,
+                                     mostrados, longitud);
+        } else {
+            marco_color(COLOR_RESET);
+            marco_formato("\033[1;1HTamaño: %d x %d | Paso: %d/%d\033[K",
+                          lab->filas, lab->columnas, mostrados, longitud);
+            volcar_marco();
         }
-        printf(COLOR_BLANCO "*️⃣\n" COLOR_RESET);
         
-        #ifdef _WIN32
-            Sleep(200);  // 200ms para Windows
-        #else
-            sleep(200000);  // 200ms para Unix/Linux (200,000 microsegundos)
-        #endif
+        if (mostrados < longitud) {
+            dormir_hasta_ms(inicio + (long)cuadro * INTERVALO_ANIMACION_MS);
+        }
     }
+    
+    // Deja el cursor debajo del borde inferior
+    printf("\033[%d;1H\n", v.linea_base + v.alto + 1);
+    liberar_memoria(v.marcas);
 }
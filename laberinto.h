@@ -6,6 +6,7 @@
 #ifndef LABERINTO_H
 #define LABERINTO_H
 
+#include <stdint.h>
 #include "grafo.h"
 
 // ============================================================================
@@ -22,8 +23,14 @@ typedef struct {
     char nombre[MAX_NOMBRE];        // Nombre del laberinto
     int tiene_solucion;             // 1 si tiene solución
     int pasos_solucion;             // Pasos en solución óptima
+    // Campo hasta FINAL (ver distancias.h); quien cambie celdas lo invalida
+    int campo_valido;                               // 1 si el campo está al día
+    int distancia_final[MAX_NODOS];                 // Pasos hasta FINAL (-1 inalcanzable)
+    unsigned char direccion_final[(MAX_NODOS + 3) / 4]; // 2 bits por celda: VECINO_* hacia FINAL
 } laberinto;
 
+struct mapa_vista;   // pantalla.h
+
 // ============================================================================
 // PROTOTIPOS DE FUNCIONES
 // ============================================================================
@@ -31,10 +38,15 @@ typedef struct {
 /* Creación y destrucción */
 laberinto* crear_laberinto_segun_tipo(int tipo_generacion, const char* nombre);
 void destruir_laberinto(laberinto* lab);
+void generar_celdas_segun_tipo(laberinto* lab, int tipo_generacion);
+void calcular_solucion(laberinto* lab);
 
 /* Visualización */
 void imprimir_laberinto(laberinto* lab);
 void imprimir_laberinto_con_solucion(laberinto* lab, int* camino, int longitud);
+void imprimir_laberinto_ventana(laberinto* lab, int fila_foco, int col_foco);
+void imprimir_vista_general(laberinto* lab, const struct mapa_vista* mapa, int bloque);
+void buscar_celda(laberinto* lab, int tipo, int* fila, int* col);
 
 /* Generación de laberintos */
 void generar_aleatorio(laberinto* lab);
@@ -43,6 +55,7 @@ void generar_con_backtracking(laberinto* lab);
 void generar_desde_grafo(laberinto* lab);
 
 /* Resolución y análisis */
+void laberinto_a_grafo(laberinto* lab, grafo_matriz* grafo);
 int* resolver_laberinto(laberinto* lab, int algoritmo, int* longitud);
 int verificar_solucion(laberinto* lab);
 int contar_caminos_posibles(laberinto* lab);
@@ -52,6 +65,7 @@ int obtener_nombre_aleatorio(char* buffer);
 void convertir_coordenadas(int nodo, int* fila, int* columna);
 int convertir_a_nodo(int fila, int columna);
 int es_valida(int fila, int columna);
+uint64_t huella_celdas(laberinto* lab);
 void animar_solucion(laberinto* lab, int* camino, int longitud);
 
 #endif // LABERINTO_H
\ No newline at end of file
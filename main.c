@@ -12,6 +12,19 @@
 #include "algoritmos.h"
 #include "laberinto.h"
 #include "archivos.h"
+#include "compacto.h"
+#include "imagen.h"
+#include "pantalla.h"
+#include "traza.h"
+#include "paquete.h"
+#include "contadores.h"
+#include "memoria.h"
+#include "distancias.h"
+#include "contraccion.h"
+#include "callejones.h"
+#include "jerarquico.h"
+#include "medicion.h"
+#include "cli.h"
 #include "config.h"
 #include "memes.h"
 
@@ -25,11 +38,18 @@ void demostrar_algoritmos(void);
 void cargar_laberinto_existente(void);
 void manejar_archivos(void);
 void mostrar_informacion_sistema(void);
+void ver_laberinto_actual(laberinto* lab);
+
+#define REPETICIONES_COMPARACION 15   // Ejecuciones por algoritmo al comparar
 
 // Variables globales
 laberinto* laberinto_actual = NULL;
 
-int main(void) {
+int main(int argc, char* argv[]) {
+    if (argc > 1) {
+        return ejecutar_cli(argc, argv);  // Modo sin menús (ver cli.c)
+    }
+    
     srand(time(NULL));    // Inicializa generador aleatorio
     int opcion;           // Opción del menú
     
@@ -56,8 +76,7 @@ int main(void) {
             case 5: manejar_archivos(); break;
             case 6: 
                 if (laberinto_actual != NULL) {
-                    imprimir_laberinto(laberinto_actual);
-                    pausa();
+                    ver_laberinto_actual(laberinto_actual);
                 }
                 break;
             case 7: mostrar_informacion_sistema(); break;
@@ -74,6 +93,9 @@ int main(void) {
         destruir_laberinto(laberinto_actual);
     }
     
+    printf("Pico de memoria dinámica: %zu bytes | Pico de RSS: %ld KB\n",
+           bytes_pico_memoria(), pico_rss_kb());
+    
     return 0;
 }
 
@@ -126,6 +148,62 @@ void pausa(void) {
     getchar();    // Espera entrada
 }
 
+/*
+ * ver_laberinto_actual
+ * Muestra el laberinto completo si cabe en la terminal; si no, una
+ * ventana desplazable alrededor de un foco o una vista general reducida.
+ */
+void ver_laberinto_actual(laberinto* lab) {
+    int alto, ancho;             // Celdas visibles en la terminal
+    int fila, col;               // Celda foco de la ventana
+    int vista_general = 0;       // 1 = bloques reducidos
+    int bloque = 0;              // Tamaño de bloque (0 = automático)
+    mapa_vista* mapa = NULL;     // Paredes en bits para la vista general
+    char comando[16];            // Entrada del usuario
+    
+    celdas_visibles(LINEAS_RESERVADAS_VISTA, &alto, &ancho);
+    if (lab->filas <= alto && lab->columnas <= ancho) {
+        imprimir_laberinto(lab);    // Cabe completo
+        pausa();
+        return;
+    }
+    
+    buscar_celda(lab, INICIO, &fila, &col);
+    mapa = crear_mapa_vista(lab);   // Las celdas no cambian mientras se mira
+    
+    do {
+        limpiar_pantalla();
+        celdas_visibles(LINEAS_RESERVADAS_VISTA, &alto, &ancho);
+        
+        if (vista_general && mapa != NULL) {
+            imprimir_vista_general(lab, mapa, bloque);
+        } else {
+            imprimir_laberinto_ventana(lab, fila, col);
+        }
+        
+        printf("\n[w/a/s/d] Mover  [v] Ventana/Vista general  [+/-] Bloque  [0] Volver: ");
+        if (fgets(comando, sizeof(comando), stdin) == NULL) break;
+        
+        switch (comando[0]) {
+            case 'w': fila -= alto / 2; break;     // Media pantalla hacia arriba
+            case 's': fila += alto / 2; break;     // Media pantalla hacia abajo
+            case 'a': col -= ancho / 2; break;     // Media pantalla a la izquierda
+            case 'd': col += ancho / 2; break;     // Media pantalla a la derecha
+            case 'v': vista_general = !vista_general; break;
+            case '+': bloque = (bloque <= 0) ? 2 : bloque + 1; break;
+            case '-': bloque = (bloque > 1) ? bloque - 1 : 0; break;
+        }
+        
+        // Mantiene el foco dentro del laberinto
+        if (fila < 0) fila = 0;
+        if (fila >= lab->filas) fila = lab->filas - 1;
+        if (col < 0) col = 0;
+        if (col >= lab->columnas) col = lab->columnas - 1;
+    } while (comando[0] != '0');
+    
+    destruir_mapa_vista(mapa);
+}
+
 /*
  * generar_nuevo_laberinto
  * Interfaz para generar nuevo laberinto.
@@ -209,6 +287,14 @@ void analizar_laberinto_actual(laberinto* lab) {
         printf("6. Encontrar caminos críticos\n");
         printf("7. Ver estadísticas\n");
         printf("8. Exportar a SVG\n");
+        printf("9. Resolver con representación compacta\n");
+        printf("10. Exportar a imagen (PBM/PGM/PNG)\n");
+        printf("11. Grabar traza de Dijkstra y reproducir\n");
+        printf("12. Contadores de instrumentación\n");
+        printf("13. Pista hacia la salida desde una celda\n");
+        printf("14. Grafo de pasillos contraído\n");
+        printf("15. Rellenar callejones sin salida\n");
+        printf("16. Búsqueda jerárquica por bloques (HPA*)\n");
         printf("0. Volver al menú principal\n");
         
         printf("\nSeleccione opción: ");
@@ -321,6 +407,7 @@ void analizar_laberinto_actual(laberinto* lab) {
                 }
                 printf("Peso total del árbol: %d\n", peso_total);
                 
+                liberar_aristas(arbol);
                 liberar_grafo_matriz(&grafo);
                 pausa();
                 break;
@@ -405,11 +492,347 @@ void analizar_laberinto_actual(laberinto* lab) {
                 break;
             }
             
-            case 8:
-                exportar_laberinto_svg(lab, lab->nombre);
-                printf("Laberinto exportado a formato SVG.\n");
+            case 8: {
+                int con_solucion, comprimido;
+                printf("\n¿Incluir solución? (0=No, 1=Sí): ");
+                scanf("%d", &con_solucion);
+                getchar();
+                printf("¿Comprimir como .svgz? (0=No, 1=Sí): ");
+                scanf("%d", &comprimido);
+                getchar();
+                
+                int longitud = 0;
+                int* camino = con_solucion ? resolver_laberinto(lab, 2, &longitud) : NULL;
+                
+                if (exportar_laberinto_svg_completo(lab, lab->nombre, camino, longitud, comprimido)) {
+                    printf("Laberinto exportado a formato SVG.\n");
+                }
+                pausa();
+                break;
+            }
+                
+            case 9: {
+                laberinto_compacto compacto;
+                
+                if (!celdas_a_compacto(lab, &compacto)) {
+                    printf("\n" COLOR_ROJO "✗ El laberinto no usa el formato de bloques\n" COLOR_RESET);
+                    pausa();
+                    break;
+                }
+                
+                printf("\n" COLOR_CYAN "=== REPRESENTACIÓN COMPACTA ===\n" COLOR_RESET);
+                printf("Habitaciones: %d x %d\n", compacto.filas, compacto.columnas);
+                printf("Memoria celdas: %zu bytes\n", sizeof(lab->celdas));
+                printf("Memoria compacta: %zu bytes\n", sizeof(compacto.paredes));
+                
+                int longitud;
+                int* camino = resolver_compacto(&compacto, &longitud);
+                
+                if (camino != NULL && longitud > 0) {
+                    printf("\n" COLOR_VERDE "✓ Solución encontrada sobre habitaciones\n" COLOR_RESET);
+                    imprimir_laberinto_con_solucion(lab, camino, longitud);
+                } else {
+                    printf("\n" COLOR_ROJO "✗ No se encontró solución\n" COLOR_RESET);
+                }
                 pausa();
                 break;
+            }
+                
+            case 10: {
+                opciones_imagen opciones;
+                int con_solucion;
+                
+                inicializar_opciones_imagen(&opciones);
+                printf("\nFormato (1=PBM, 2=PGM, 3=PNG): ");
+                scanf("%d", &opciones.formato);
+                getchar();
+                printf("Píxeles por celda (1-%d): ", MAX_PIXELES_CELDA);
+                scanf("%d", &opciones.pixeles_por_celda);
+                getchar();
+                printf("¿Incluir solución? (0=No, 1=Sí): ");
+                scanf("%d", &con_solucion);
+                getchar();
+                printf("¿Mapa de calor por distancia? (0=No, 1=Sí): ");
+                scanf("%d", &opciones.mapa_calor);
+                getchar();
+                
+                if (con_solucion) {
+                    opciones.camino = resolver_laberinto(lab, 2, &opciones.longitud);
+                }
+                
+                exportar_laberinto_imagen(lab, lab->nombre, &opciones);
+                pausa();
+                break;
+            }
+                
+            case 11: {
+                grafo_matriz grafo;
+                char ruta[MAX_NOMBRE + 50];   // Archivo de la traza
+                int distancia;
+                
+                laberinto_a_grafo(lab, &grafo);
+                sprintf(ruta, "%s%s.trz", DIRECTORIO_LABERINTOS, lab->nombre);
+                
+                // Grabación a velocidad completa (sin tablas ni pausas)
+                traza_dijkstra* traza = crear_traza(ruta, grafo.num_nodos, 0, FILAS * COLUMNAS - 1);
+                if (traza == NULL) {
+                    pausa();
+                    break;
+                }
+                
+                clock_t inicio = clock();
+                dijkstra_con_traza(&grafo, 0, FILAS * COLUMNAS - 1, &distancia, traza);
+                double ms = (double)(clock() - inicio) * 1000.0 / CLOCKS_PER_SEC;
+                
+                size_t eventos = traza->total_eventos;
+                int ok = cerrar_traza(traza);
+                destruir_traza(traza);
+                
+                if (!ok) {
+                    printf("\n" COLOR_ROJO "✗ Error al escribir la traza\n" COLOR_RESET);
+                    pausa();
+                    break;
+                }
+                
+                printf("\n" COLOR_VERDE "✓ Traza grabada: %s\n" COLOR_RESET, ruta);
+                printf("Eventos: %zu | Tiempo: %.3f ms | Distancia: %d\n", eventos, ms, distancia);
+                
+                // Reproducción fuera de línea desde el archivo
+                traza = cargar_traza(ruta);
+                if (traza != NULL) {
+                    reproducir_traza(traza);
+                    destruir_traza(traza);
+                }
+                break;
+            }
+            
+            case 12: {
+                if (!instrumentacion_activa()) {
+                    printf("\n" COLOR_AMARILLO "Contadores desactivados: compile con "
+                           "'make debug' o CFLAGS=-DINSTRUMENTAR.\n" COLOR_RESET);
+                    pausa();
+                    break;
+                }
+                
+                contadores_algoritmo contadores;
+                grafo_matriz grafo;
+                int longitud, num_aristas;
+                
+                printf("\n" COLOR_CYAN "=== CONTADORES DE INSTRUMENTACIÓN ===\n\n" COLOR_RESET);
+                
+                reiniciar_contadores();
+                resolver_laberinto(lab, 1, &longitud);
+                obtener_contadores(&contadores);
+                imprimir_contadores("Dijkstra", &contadores);
+                
+                reiniciar_contadores();
+                resolver_laberinto(lab, 2, &longitud);
+                obtener_contadores(&contadores);
+                imprimir_contadores("BFS", &contadores);
+                
+                laberinto_a_grafo(lab, &grafo);
+                reiniciar_contadores();
+                prim(&grafo, &num_aristas);
+                obtener_contadores(&contadores);
+                imprimir_contadores("Prim", &contadores);
+                
+                reiniciar_contadores();
+                liberar_aristas(kruskal(&grafo, &num_aristas));
+                obtener_contadores(&contadores);
+                imprimir_contadores("Kruskal", &contadores);
+                liberar_grafo_matriz(&grafo);
+                
+                // Generadores sobre una copia para no tocar el laberinto actual
+                laberinto* copia = (laberinto*)reservar_memoria(MEM_LABERINTO, sizeof(laberinto));
+                if (copia != NULL) {
+                    const char* generadores[] = {"Generador aleatorio", "Generador perfecto",
+                                                 "Generador backtracking", "Generador desde grafo"};
+                    *copia = *lab;
+                    for (int t = 1; t <= 4; t++) {
+                        reiniciar_contadores();
+                        generar_celdas_segun_tipo(copia, t);
+                        obtener_contadores(&contadores);
+                        imprimir_contadores(generadores[t - 1], &contadores);
+                    }
+                    liberar_memoria(copia);
+                }
+                
+                pausa();
+                break;
+            }
+            
+            case 13: {
+                int fila, col;
+                int camino[MAX_NODOS];
+                
+                printf("\nCelda de partida (fila columna): ");
+                if (scanf("%d %d", &fila, &col) != 2 || !es_valida(fila, col)) {
+                    getchar();
+                    printf("\n" COLOR_ROJO "✗ Celda fuera del laberinto\n" COLOR_RESET);
+                    pausa();
+                    break;
+                }
+                getchar();
+                
+                // Consultas sobre el campo hasta FINAL, sin volver a resolver
+                int nodo = convertir_a_nodo(fila, col);
+                int pasos = distancia_a_salida(lab, nodo);
+                if (pasos < 0) {
+                    printf("\n" COLOR_ROJO "✗ Desde (%d,%d) no se llega a la salida\n" COLOR_RESET,
+                           fila, col);
+                } else {
+                    int longitud = camino_a_salida(lab, nodo, camino);
+                    printf("\n" COLOR_VERDE "✓ A %d pasos de la salida; siguiente paso: %s\n" COLOR_RESET,
+                           pasos, nombre_direccion(direccion_a_salida(lab, nodo)));
+                    imprimir_laberinto_con_solucion(lab, camino, longitud);
+                }
+                pausa();
+                break;
+            }
+            
+            case 14: {
+                int extremos[2] = {0, FILAS * COLUMNAS - 1};
+                int camino[MAX_NODOS];
+                grafo_contraido* contraido = contraer_laberinto(lab, extremos, 2);
+                grafo_matriz* grafo = (grafo_matriz*)reservar_memoria(MEM_GRAFO, sizeof(grafo_matriz));
+                
+                if (contraido == NULL || grafo == NULL) {
+                    printf("\n" COLOR_ROJO "✗ Memoria insuficiente\n" COLOR_RESET);
+                    destruir_grafo_contraido(contraido);
+                    liberar_memoria(grafo);
+                    pausa();
+                    break;
+                }
+                
+                printf("\n" COLOR_CYAN "=== GRAFO DE PASILLOS CONTRAÍDO ===\n" COLOR_RESET);
+                printf("Celdas abiertas: %d\n", contraido->celdas_abiertas);
+                printf("Nodos clave (cruces, callejones, INICIO y FINAL): %d\n",
+                       contraido->num_clave);
+                printf("Pasillos: %d\n", contraido->num_pasillos);
+                if (contraido->num_clave > 0) {
+                    printf("Reducción: %.1fx\n",
+                           (double)contraido->celdas_abiertas / contraido->num_clave);
+                }
+                
+                // Mismas medidas que con el grafo de celdas, sobre num_clave nodos
+                int num_aristas, peso_arbol = 0;
+                arista* arbol = arbol_contraido(contraido, &num_aristas);
+                for (int i = 0; arbol != NULL && i < num_aristas; i++) peso_arbol += arbol[i].peso;
+                liberar_aristas(arbol);
+                printf("Árbol generador mínimo (Kruskal sobre pasillos): %d (%d aristas)\n",
+                       peso_arbol, num_aristas);
+                
+                int celda_a, celda_b;
+                uint64_t t0 = reloj_ns();
+                int diametro = diametro_contraido(contraido, &celda_a, &celda_b);
+                uint64_t t1 = reloj_ns();
+                laberinto_a_grafo(lab, grafo);
+                int inicio_critico, fin_critico;
+                calcular_camino_critico(grafo, &inicio_critico, &fin_critico);
+                uint64_t t2 = reloj_ns();
+                if (celda_a >= 0) {
+                    printf("Camino crítico: (%d,%d) → (%d,%d), %d pasos\n",
+                           celda_a / COLUMNAS, celda_a % COLUMNAS,
+                           celda_b / COLUMNAS, celda_b % COLUMNAS, diametro);
+                }
+                printf("Floyd-Warshall: %.3f ms contraído, %.3f ms con celdas\n",
+                       (t1 - t0) / 1e6, (t2 - t1) / 1e6);
+                
+                int longitud = camino_contraido(contraido, extremos[0], extremos[1], camino);
+                if (longitud > 0) {
+                    printf("\n" COLOR_VERDE "✓ Solución en %d pasos\n" COLOR_RESET, longitud - 1);
+                    imprimir_laberinto_con_solucion(lab, camino, longitud);
+                } else {
+                    printf("\n" COLOR_ROJO "✗ No se encontró solución\n" COLOR_RESET);
+                }
+                
+                destruir_grafo_contraido(contraido);
+                liberar_memoria(grafo);
+                pausa();
+                break;
+            }
+            
+            case 15: {
+                int tapiadas_cola, tapiadas_bits;
+                uint64_t t0 = reloj_ns();
+                laberinto* podado = podar_laberinto(lab, RELLENO_COLA, &tapiadas_cola);
+                uint64_t t1 = reloj_ns();
+                laberinto* podado_bits = podar_laberinto(lab, RELLENO_BITS, &tapiadas_bits);
+                uint64_t t2 = reloj_ns();
+                
+                if (podado == NULL || podado_bits == NULL) {
+                    printf("\n" COLOR_ROJO "✗ Memoria insuficiente\n" COLOR_RESET);
+                    liberar_memoria(podado);
+                    liberar_memoria(podado_bits);
+                    pausa();
+                    break;
+                }
+                
+                int abiertas = contar_caminos_posibles(lab);
+                printf("\n" COLOR_CYAN "=== RELLENO DE CALLEJONES ===\n" COLOR_RESET);
+                printf("Puntas de callejón: %d\n", contar_callejones(lab));
+                printf("Celdas tapiadas: %d de %d abiertas (%.1f%%)\n", tapiadas_cola, abiertas,
+                       abiertas ? 100.0 * tapiadas_cola / abiertas : 0.0);
+                printf("Motor con cola: %.3f ms, tablero de bits: %.3f ms (%s)\n",
+                       (t1 - t0) / 1e6, (t2 - t1) / 1e6,
+                       memcmp(podado->celdas, podado_bits->celdas, sizeof(podado->celdas)) == 0
+                       ? "mismo resultado" : "resultados distintos");
+                
+                // El laberinto podado conserva la solución
+                int longitud;
+                int* camino = resolver_laberinto(podado, 2, &longitud);
+                if (camino != NULL && longitud > 0) {
+                    imprimir_laberinto_con_solucion(podado, camino, longitud);
+                } else {
+                    imprimir_laberinto(podado);
+                }
+                
+                liberar_memoria(podado);
+                liberar_memoria(podado_bits);
+                pausa();
+                break;
+            }
+            
+            case 16: {
+                int camino[MAX_NODOS];
+                uint64_t t0 = reloj_ns();
+                indice_jerarquico* indice = construir_indice_jerarquico(lab, TAM_BLOQUE_JERARQUICO);
+                uint64_t t1 = reloj_ns();
+                
+                if (indice == NULL) {
+                    printf("\n" COLOR_ROJO "✗ Memoria insuficiente\n" COLOR_RESET);
+                    pausa();
+                    break;
+                }
+                
+                printf("\n" COLOR_CYAN "=== BÚSQUEDA JERÁRQUICA ===\n" COLOR_RESET);
+                printf("Bloques: %d x %d de %d celdas de lado\n", indice->filas_bloques,
+                       indice->columnas_bloques, indice->tam_bloque);
+                printf("Entradas: %d, enlaces: %d\n", indice->num_entradas, indice->num_enlaces);
+                printf("Construcción del índice: %.3f ms\n", (t1 - t0) / 1e6);
+                
+                // Misma consulta con el índice ya hecho y con BFS sobre celdas
+                int expandidas, longitud_bfs;
+                uint64_t t2 = reloj_ns();
+                int longitud = camino_jerarquico(indice, 0, FILAS * COLUMNAS - 1, camino, &expandidas);
+                uint64_t t3 = reloj_ns();
+                resolver_laberinto(lab, 2, &longitud_bfs);
+                uint64_t t4 = reloj_ns();
+                printf("Consulta: %.3f ms (%d entradas expandidas), BFS: %.3f ms\n",
+                       (t3 - t2) / 1e6, expandidas, (t4 - t3) / 1e6);
+                
+                if (longitud > 0) {
+                    printf("\n" COLOR_VERDE "✓ Solución en %d pasos (%s)\n" COLOR_RESET, longitud - 1,
+                           longitud == longitud_bfs ? "igual que BFS" : "distinta de BFS");
+                    imprimir_laberinto_con_solucion(lab, camino, longitud);
+                } else {
+                    printf("\n" COLOR_ROJO "✗ No se encontró solución\n" COLOR_RESET);
+                }
+                
+                destruir_indice_jerarquico(indice);
+                pausa();
+                break;
+            }
                 
             case 0:
                 break;
@@ -492,6 +915,14 @@ void demostrar_algoritmos(void) {
                 imprimir_matriz_adyacencia(&grafo);
                 
                 int distancia;
+                int desde, hasta;
+                printf("\nRango de nodos a mostrar (desde hasta, -1 -1 = todos): ");
+                if (scanf("%d %d", &desde, &hasta) != 2 || desde > hasta) {
+                    desde = hasta = -1;
+                }
+                getchar();
+                establecer_rango_estados(desde, hasta);
+                
                 printf("\n" COLOR_AMARILLO "Presione Enter para comenzar...\n" COLOR_RESET);
                 getchar();
                 
@@ -568,6 +999,7 @@ void demostrar_algoritmos(void) {
                 }
                 printf("Peso total: %d\n", peso_total);
                 
+                liberar_aristas(arbol);
                 liberar_grafo_matriz(&grafo);
                 pausa();
                 break;
@@ -604,21 +1036,44 @@ void demostrar_algoritmos(void) {
             }
             
             case 6: {
+                grafo_matriz grafo;
+                
                 printf("\n" COLOR_CYAN "=== COMPARACIÓN DE ALGORITMOS ===\n" COLOR_RESET);
-                printf("\nDijkstra vs BFS:\n");
-                printf("- Dijkstra: Camino más corto con pesos\n");
-                printf("- BFS: Camino más corto sin pesos\n");
-                printf("- Dijkstra es más lento pero más preciso\n");
+                printf("Mediciones reales: %d repeticiones por algoritmo\n", REPETICIONES_COMPARACION);
                 
-                printf("\nPrim vs Kruskal:\n");
-                printf("- Prim: Mejor para grafos densos\n");
-                printf("- Kruskal: Mejor para grafos dispersos\n");
-                printf("- Ambos encuentran árbol generador mínimo\n");
+                if (laberinto_actual != NULL) {
+                    printf("\nCaminos en el laberinto actual (%s):\n", laberinto_actual->nombre);
+                    laberinto_a_grafo(laberinto_actual, &grafo);
+                    comparar_solucionadores(&grafo, 0, FILAS * COLUMNAS - 1,
+                                            REPETICIONES_COMPARACION);
+                }
                 
-                printf("\nRecomendaciones:\n");
-                printf("- Laberintos pequeños: BFS es suficiente\n");
-                printf("- Laberintos grandes: Dijkstra para mejor resultado\n");
-                printf("- Generación: Prim para laberintos perfectos\n");
+                // Grafo aleatorio: del primer nodo no aislado al alcanzable más lejano
+                inicializar_grafo_matriz(&grafo, FILAS * COLUMNAS);
+                generar_grafo_aleatorio(&grafo);
+                
+                int origen, destino = -1;
+                for (origen = 0; origen < grafo.num_nodos && destino == -1; origen++) {
+                    int* alcanzados = bfs(&grafo, origen);
+                    for (int v = 0; v < grafo.num_nodos; v++) {
+                        if (alcanzados[v] != -1 && (destino == -1 ||
+                            heuristica_manhattan(v, origen, NULL) >
+                            heuristica_manhattan(destino, origen, NULL))) {
+                            destino = v;
+                        }
+                    }
+                    if (destino != -1) break;
+                }
+                
+                if (destino != -1) {
+                    printf("\nCaminos en un grafo aleatorio (%d → %d, factor A*: %d):\n",
+                           origen, destino, factor_manhattan_admisible(&grafo));
+                    comparar_solucionadores(&grafo, origen, destino, REPETICIONES_COMPARACION);
+                }
+                liberar_grafo_matriz(&grafo);
+                
+                printf("\nÁrbol generador mínimo (%d nodos):\n", MAX_NODOS);
+                comparar_arboles_generadores(REPETICIONES_COMPARACION);
                 
                 pausa();
                 break;
@@ -667,8 +1122,19 @@ void cargar_laberinto_existente(void) {
         laberinto_actual = NULL;
     }
     
-    // Carga nuevo laberinto
-    laberinto_actual = cargar_laberinto(nombre_archivo);
+    // Carga nuevo laberinto (archivo suelto o paquete)
+    if (existe_laberinto(nombre_archivo)) {
+        laberinto_actual = cargar_laberinto(nombre_archivo);
+    } else {
+        paquete* paq = abrir_paquete(ARCHIVO_PAQUETE);
+        if (paq != NULL) {
+            const entrada_paquete* entrada = buscar_en_paquete(paq, nombre_archivo);
+            if (entrada != NULL) {
+                laberinto_actual = cargar_de_paquete(paq, entrada);
+            }
+            cerrar_paquete(paq);
+        }
+    }
     
     if (laberinto_actual != NULL) {
         printf("\n" COLOR_VERDE "✓ Laberinto cargado exitosamente!\n" COLOR_RESET);
@@ -698,6 +1164,8 @@ void manejar_archivos(void) {
         printf("4. Exportar estadísticas\n");
         printf("5. Exportar a SVG\n");
         printf("6. Verificar integridad de archivos\n");
+        printf("7. Empaquetar laberintos guardados\n");
+        printf("8. Agregar laberinto actual al paquete\n");
         printf("0. Volver al menú principal\n");
         
         printf("\nSeleccione opción: ");
@@ -775,6 +1243,26 @@ void manejar_archivos(void) {
                 pausa();
                 break;
                 
+            case 7:
+                crear_directorio_laberintos();
+                empaquetar_directorio(ARCHIVO_PAQUETE);
+                pausa();
+                break;
+                
+            case 8:
+                if (laberinto_actual != NULL) {
+                    crear_directorio_laberintos();
+                    if (agregar_a_paquete(ARCHIVO_PAQUETE, laberinto_actual)) {
+                        printf("\n" COLOR_VERDE "✓ Laberinto agregado a %s\n" COLOR_RESET, ARCHIVO_PAQUETE);
+                    } else {
+                        printf("\n" COLOR_ROJO "✗ Error al escribir el paquete\n" COLOR_RESET);
+                    }
+                } else {
+                    printf("\nNo hay laberinto actual para empaquetar.\n");
+                }
+                pausa();
+                break;
+                
             case 0:
                 break;
                 
@@ -808,5 +1296,8 @@ void mostrar_informacion_sistema(void) {
     printf("- Exportación a SVG\n");
     printf("- Nombres con memes anarquistas\n");
     
+    printf("\n" COLOR_VERDE "=== MEMORIA ===\n" COLOR_RESET);
+    imprimir_informe_memoria(stdout);
+    
     pausa();
 }
\ No newline at end of file
@@ -0,0 +1,67 @@
+/*
+ * medicion.c
+ * Reloj de alta resolución y estadísticas de tiempos.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdlib.h>
+#include <time.h>
+#include "medicion.h"
+
+/*
+ * reloj_ns
+ * Nanosegundos de CLOCK_MONOTONIC (solo sirve para restar).
+ */
+uint64_t reloj_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/*
+ * comparar_dobles
+ * Comparador para qsort en orden ascendente.
+ */
+static int comparar_dobles(const void* a, const void* b) {
+    double x = *(const double*)a;
+    double y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+/*
+ * percentil
+ * Percentil p (0-100) por rango más cercano sobre muestras ordenadas.
+ */
+double percentil(const double* ordenadas, int n, double p) {
+    if (n <= 0) return 0.0;
+    
+    int rango = (int)(p / 100.0 * n + 0.999999);   // Redondeo hacia arriba
+    if (rango < 1) rango = 1;
+    if (rango > n) rango = n;
+    return ordenadas[rango - 1];
+}
+
+/*
+ * resumir_tiempos
+ * Ordena las muestras y calcula mínimo, mediana, p95, media y máximo.
+ */
+void resumir_tiempos(double* muestras, int n, resumen_tiempos* resumen) {
+    double suma = 0.0;
+    
+    resumen->muestras = n;
+    if (n <= 0) {
+        resumen->minimo = resumen->mediana = resumen->p95 = 0.0;
+        resumen->media = resumen->maximo = 0.0;
+        return;
+    }
+    
+    qsort(muestras, n, sizeof(double), comparar_dobles);
+    for (int i = 0; i < n; i++) suma += muestras[i];
+    
+    resumen->minimo = muestras[0];
+    resumen->maximo = muestras[n - 1];
+    resumen->mediana = (n % 2) ? muestras[n / 2] : (muestras[n / 2 - 1] + muestras[n / 2]) / 2.0;
+    resumen->p95 = percentil(muestras, n, 95.0);
+    resumen->media = suma / n;
+}
@@ -0,0 +1,36 @@
+/*
+ * medicion.h
+ * Utilidades de medición: reloj monotónico y resumen de muestras.
+ * Las usan el programa de benchmarks y los informes del sistema.
+ */
+
+#ifndef MEDICION_H
+#define MEDICION_H
+
+#include <stdint.h>
+
+// ============================================================================
+// ESTRUCTURAS DE MEDICIÓN
+// ============================================================================
+
+/*
+ * resumen_tiempos - Estadísticas de una serie de muestras (microsegundos)
+ */
+typedef struct {
+    int muestras;       // Cantidad de muestras
+    double minimo;      // Menor muestra
+    double mediana;     // Percentil 50
+    double p95;         // Percentil 95
+    double media;       // Promedio
+    double maximo;      // Mayor muestra
+} resumen_tiempos;
+
+// ============================================================================
+// PROTOTIPOS DE FUNCIONES
+// ============================================================================
+
+uint64_t reloj_ns(void);
+double percentil(const double* ordenadas, int n, double p);
+void resumir_tiempos(double* muestras, int n, resumen_tiempos* resumen);
+
+#endif // MEDICION_H
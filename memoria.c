@@ -0,0 +1,232 @@
+/*
+ * memoria.c
+ * Capa de reservas con contabilidad por subsistema.
+ * Cada bloque lleva una cabecera con su tamaño y subsistema, así
+ * liberar_memoria sabe qué restar sin que el llamador lo indique.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+#include "memoria.h"
+#include "grafo.h"
+#include "laberinto.h"
+#include "compacto.h"
+
+/*
+ * cabecera_bloque - Prefijo oculto de cada reserva
+ * La unión fuerza la alineación más estricta de los tipos básicos.
+ */
+typedef union {
+    struct {
+        size_t bytes;       // Bytes pedidos
+        int subsistema;     // Subsistema dueño
+    } info;
+    long double alinear_real;
+    long long alinear_entero;
+    void* alinear_puntero;
+} cabecera_bloque;
+
+static estadistica_memoria estadisticas[NUM_SUBSISTEMAS];   // Por subsistema
+static size_t bytes_vivos = 0;          // Total vivo
+static size_t bytes_pico_total = 0;     // Máximo total vivo
+
+static const char* nombres_subsistemas[NUM_SUBSISTEMAS] = {
+    "laberintos", "grafos", "algoritmos", "archivos",
+    "compresión", "paquetes", "trazas", "pantalla", "servidor"
+};
+
+/*
+ * Arreglos locales de cada algoritmo (mismas expresiones que en su código).
+ */
+static const estimacion_pila tabla_pila[] = {
+    {"Dijkstra",               3 * MAX_NODOS * sizeof(int)},
+    {"BFS",                    2 * MAX_NODOS * sizeof(int)},
+    {"A*",                     MAX_NODOS * (sizeof(int) + 1)},
+    {"ALT",                    MAX_NODOS * (sizeof(int) + 1)},
+    {"Prim",                   3 * MAX_NODOS * sizeof(int)},
+    {"Kruskal",                sizeof(conjunto_disjunto) + MAX_ARISTAS * sizeof(arista)},
+    {"Generador aleatorio",    FILAS * COLUMNAS * 2 * sizeof(int)},
+    {"Generador perfecto",     FILAS * COLUMNAS * 3 * sizeof(int)},
+    {"Generador backtracking", sizeof(laberinto_compacto) + MAX_HABITACIONES * (sizeof(int) + 1)},
+    {"Generador desde grafo",  FILAS * COLUMNAS * (4 * 3 + 2) * sizeof(int)},
+};
+
+// ==================== RESERVAS ====================
+
+/*
+ * contabilizar
+ * Suma (o resta) bytes a un subsistema y actualiza los picos.
+ */
+static void contabilizar(int subsistema, size_t bytes, int reservar) {
+    estadistica_memoria* e = &estadisticas[subsistema];
+    
+    if (reservar) {
+        e->reservas++;
+        e->bytes_totales += bytes;
+        e->bytes_actuales += bytes;
+        bytes_vivos += bytes;
+        if (e->bytes_actuales > e->bytes_pico) e->bytes_pico = e->bytes_actuales;
+        if (bytes_vivos > bytes_pico_total) bytes_pico_total = bytes_vivos;
+    } else {
+        e->liberaciones++;
+        e->bytes_actuales -= bytes;
+        bytes_vivos -= bytes;
+    }
+}
+
+/*
+ * reservar_memoria
+ * malloc con cabecera de contabilidad.
+ */
+void* reservar_memoria(int subsistema, size_t bytes) {
+    cabecera_bloque* cabecera = (cabecera_bloque*)malloc(sizeof(cabecera_bloque) + bytes);
+    if (!cabecera) return NULL;
+    
+    cabecera->info.bytes = bytes;
+    cabecera->info.subsistema = subsistema;
+    contabilizar(subsistema, bytes, 1);
+    return cabecera + 1;    // Datos tras la cabecera
+}
+
+/*
+ * reservar_memoria_cero
+ * Igual que calloc: reserva cantidad * tamano bytes en cero.
+ */
+void* reservar_memoria_cero(int subsistema, size_t cantidad, size_t tamano) {
+    if (tamano != 0 && cantidad > (size_t)-1 / tamano) return NULL;  // Desborde
+    
+    void* bloque = reservar_memoria(subsistema, cantidad * tamano);
+    if (bloque) memset(bloque, 0, cantidad * tamano);
+    return bloque;
+}
+
+/*
+ * redimensionar_memoria
+ * Igual que realloc; con bloque NULL reserva uno nuevo.
+ */
+void* redimensionar_memoria(int subsistema, void* bloque, size_t bytes) {
+    if (bloque == NULL) return reservar_memoria(subsistema, bytes);
+    
+    cabecera_bloque* vieja = (cabecera_bloque*)bloque - 1;
+    size_t bytes_previos = vieja->info.bytes;
+    int dueno = vieja->info.subsistema;
+    
+    cabecera_bloque* nueva = (cabecera_bloque*)realloc(vieja, sizeof(cabecera_bloque) + bytes);
+    if (!nueva) return NULL;    // El bloque original sigue válido
+    
+    contabilizar(dueno, bytes_previos, 0);
+    nueva->info.bytes = bytes;
+    contabilizar(dueno, bytes, 1);
+    return nueva + 1;
+}
+
+/*
+ * liberar_memoria
+ * free para bloques de reservar_memoria (acepta NULL).
+ */
+void liberar_memoria(void* bloque) {
+    if (bloque == NULL) return;
+    
+    cabecera_bloque* cabecera = (cabecera_bloque*)bloque - 1;
+    contabilizar(cabecera->info.subsistema, cabecera->info.bytes, 0);
+    free(cabecera);
+}
+
+// ==================== CONSULTAS ====================
+
+/*
+ * obtener_estadistica_memoria
+ * Copia la contabilidad de un subsistema.
+ */
+void obtener_estadistica_memoria(int subsistema, estadistica_memoria* destino) {
+    *destino = estadisticas[subsistema];
+}
+
+/*
+ * bytes_pico_memoria
+ * Máximo de bytes dinámicos vivos a la vez (todos los subsistemas).
+ */
+size_t bytes_pico_memoria(void) {
+    return bytes_pico_total;
+}
+
+/*
+ * reiniciar_pico_memoria
+ * Lleva los picos a los bytes vivos actuales (para medir una sola operación).
+ */
+void reiniciar_pico_memoria(void) {
+    for (int s = 0; s < NUM_SUBSISTEMAS; s++) {
+        estadisticas[s].bytes_pico = estadisticas[s].bytes_actuales;
+    }
+    bytes_pico_total = bytes_vivos;
+}
+
+/*
+ * estimaciones_pila
+ * Tabla de pila por algoritmo; retorna la cantidad de filas.
+ */
+int estimaciones_pila(const estimacion_pila** tabla) {
+    *tabla = tabla_pila;
+    return (int)(sizeof(tabla_pila) / sizeof(tabla_pila[0]));
+}
+
+/*
+ * pila_estimada
+ * Bytes de pila estimados para un algoritmo de la tabla (0 si no está).
+ */
+size_t pila_estimada(const char* algoritmo) {
+    for (size_t i = 0; i < sizeof(tabla_pila) / sizeof(tabla_pila[0]); i++) {
+        if (strcmp(tabla_pila[i].algoritmo, algoritmo) == 0) return tabla_pila[i].bytes;
+    }
+    return 0;
+}
+
+/*
+ * bytes_vivos_memoria
+ * Bytes dinámicos vivos en este momento (todos los subsistemas).
+ */
+size_t bytes_vivos_memoria(void) {
+    return bytes_vivos;
+}
+
+/*
+ * pico_rss_kb
+ * Pico de memoria residente del proceso en KB (-1 si no se sabe).
+ */
+long pico_rss_kb(void) {
+    struct rusage uso;
+    if (getrusage(RUSAGE_SELF, &uso) != 0) return -1;
+    return uso.ru_maxrss;   // KB en Linux
+}
+
+// ==================== INFORMES ====================
+
+/*
+ * imprimir_informe_memoria
+ * Tabla por subsistema, estimación de pila y pico de RSS.
+ */
+void imprimir_informe_memoria(FILE* salida) {
+    const estimacion_pila* pila;
+    int num_pila = estimaciones_pila(&pila);
+    
+    fprintf(salida, "%-12s %9s %9s %12s %12s\n",
+            "Subsistema", "Reservas", "Vivas", "Bytes vivos", "Pico");
+    for (int s = 0; s < NUM_SUBSISTEMAS; s++) {
+        const estadistica_memoria* e = &estadisticas[s];
+        fprintf(salida, "%-12s %9llu %9llu %12zu %12zu\n", nombres_subsistemas[s],
+                (unsigned long long)e->reservas,
+                (unsigned long long)(e->reservas - e->liberaciones),
+                e->bytes_actuales, e->bytes_pico);
+    }
+    fprintf(salida, "Pico de memoria dinámica: %zu bytes\n", bytes_pico_total);
+    
+    fprintf(salida, "\nPila estimada por algoritmo (%dx%d):\n", FILAS, COLUMNAS);
+    for (int i = 0; i < num_pila; i++) {
+        fprintf(salida, "  %-24s %10.1f KB\n", pila[i].algoritmo, pila[i].bytes / 1024.0);
+    }
+    
+    fprintf(salida, "\nPico de RSS del proceso: %ld KB\n", pico_rss_kb());
+}
@@ -0,0 +1,70 @@
+/*
+ * memoria.h
+ * Contabilidad de memoria: bytes y reservas por subsistema, pico de
+ * memoria dinámica, estimación de pila por algoritmo y pico de RSS.
+ */
+
+#ifndef MEMORIA_H
+#define MEMORIA_H
+
+#include <stdio.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// ============================================================================
+// SUBSISTEMAS
+// ============================================================================
+
+#define MEM_LABERINTO 0     // Estructuras laberinto
+#define MEM_GRAFO 1         // Nodos de listas de adyacencia
+#define MEM_ALGORITMOS 2    // Resultados y matrices auxiliares
+#define MEM_ARCHIVOS 3      // Buffers de lectura, SVG e imágenes
+#define MEM_COMPRESION 4    // Compresores deflate y archivos gzip
+#define MEM_PAQUETES 5      // Paquetes e índices
+#define MEM_TRAZAS 6        // Trazas y estado del reproductor
+#define MEM_PANTALLA 7      // Buffer de cuadro de la terminal
+#define MEM_SERVIDOR 8      // Caché y conexiones del servidor
+#define NUM_SUBSISTEMAS 9
+
+/*
+ * estadistica_memoria - Contabilidad de un subsistema
+ */
+typedef struct {
+    uint64_t reservas;      // Reservas realizadas
+    uint64_t liberaciones;  // Liberaciones realizadas
+    size_t bytes_actuales;  // Bytes vivos
+    size_t bytes_pico;      // Máximo de bytes vivos
+    uint64_t bytes_totales; // Bytes reservados en total
+} estadistica_memoria;
+
+/*
+ * estimacion_pila - Arreglos locales de un algoritmo
+ */
+typedef struct {
+    const char* algoritmo;  // Nombre del algoritmo
+    size_t bytes;           // Bytes de los arreglos en pila
+} estimacion_pila;
+
+// ============================================================================
+// PROTOTIPOS DE FUNCIONES
+// ============================================================================
+
+/* Reserva con contabilidad (liberar siempre con liberar_memoria) */
+void* reservar_memoria(int subsistema, size_t bytes);
+void* reservar_memoria_cero(int subsistema, size_t cantidad, size_t tamano);
+void* redimensionar_memoria(int subsistema, void* bloque, size_t bytes);
+void liberar_memoria(void* bloque);
+
+/* Consultas */
+void obtener_estadistica_memoria(int subsistema, estadistica_memoria* destino);
+size_t bytes_pico_memoria(void);
+size_t bytes_vivos_memoria(void);
+void reiniciar_pico_memoria(void);
+int estimaciones_pila(const estimacion_pila** tabla);
+size_t pila_estimada(const char* algoritmo);
+long pico_rss_kb(void);
+
+/* Informes */
+void imprimir_informe_memoria(FILE* salida);
+
+#endif // MEMORIA_H
@@ -0,0 +1,488 @@
+/*
+ * pantalla.c
+ * Renderizador de terminal compartido por las funciones de impresión.
+ * Un cuadro se arma en un buffer que se reutiliza entre llamadas y se
+ * escribe de una vez; los colores solo se emiten cuando cambian.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include "pantalla.h"
+#include "memoria.h"
+
+// Glifos del laberinto
+#define GLIFO_PARED "*️⃣"
+
+static marco_pantalla marco = {NULL, 0, 0, COLOR_RESET};   // Buffer compartido
+
+// ==================== FUNCIONES AUXILIARES ====================
+
+/*
+ * asegurar_capacidad
+ * Crece el buffer (al doble) hasta que quepan 'extra' bytes más.
+ * Retorna 0 si no hay memoria.
+ */
+static int asegurar_capacidad(size_t extra) {
+    if (marco.usados + extra <= marco.capacidad) return 1;
+    
+    size_t nueva = marco.capacidad ? marco.capacidad : CAPACIDAD_INICIAL_MARCO;
+    while (marco.usados + extra > nueva) nueva *= 2;
+    
+    char* datos = (char*)redimensionar_memoria(MEM_PANTALLA, marco.datos, nueva);
+    if (!datos) return 0;
+    
+    marco.datos = datos;
+    marco.capacidad = nueva;
+    return 1;
+}
+
+// ==================== CONSTRUCCIÓN DEL CUADRO ====================
+
+/*
+ * iniciar_marco
+ * Vacía el buffer para armar un cuadro nuevo.
+ * El color vuelve al estado normal de la terminal.
+ */
+void iniciar_marco(void) {
+    marco.usados = 0;
+    marco.color_actual = COLOR_RESET;
+}
+
+/*
+ * marco_texto
+ * Agrega texto literal al cuadro.
+ */
+void marco_texto(const char* texto) {
+    size_t n = strlen(texto);
+    if (!asegurar_capacidad(n)) return;
+    
+    memcpy(marco.datos + marco.usados, texto, n);
+    marco.usados += n;
+}
+
+/*
+ * marco_formato
+ * Agrega texto con formato (como printf) al cuadro.
+ */
+void marco_formato(const char* formato, ...) {
+    va_list args;
+    
+    va_start(args, formato);
+    int n = vsnprintf(NULL, 0, formato, args);   // Mide el texto
+    va_end(args);
+    
+    if (n < 0 || !asegurar_capacidad((size_t)n + 1)) return;
+    
+    va_start(args, formato);
+    vsnprintf(marco.datos + marco.usados, (size_t)n + 1, formato, args);
+    va_end(args);
+    marco.usados += (size_t)n;
+}
+
+/*
+ * marco_color
+ * Cambia el color del texto siguiente.
+ * No escribe nada si el color ya está activo.
+ */
+void marco_color(const char* color) {
+    if (marco.color_actual == color || strcmp(marco.color_actual, color) == 0) return;
+    
+    marco_texto(color);
+    marco.color_actual = color;
+}
+
+/*
+ * marco_celda
+ * Agrega el símbolo de una celda (dos columnas de ancho).
+ * Los espacios no cambian el color: se ven igual con cualquiera.
+ */
+void marco_celda(int tipo) {
+    switch (tipo) {
+        case INICIO:
+            marco_color(COLOR_VERDE);
+            marco_texto("E ");           // Entrada (verde)
+            break;
+        case FINAL:
+            marco_color(COLOR_ROJO);
+            marco_texto("S ");           // Salida (rojo)
+            break;
+        case PARED:
+            marco_color(COLOR_BLANCO);
+            marco_texto(GLIFO_PARED " ");  // Pared (blanco)
+            break;
+        case VISITADO:
+            marco_color(COLOR_AMARILLO);
+            marco_texto(". ");           // Visitado (amarillo)
+            break;
+        case SOLUCION:
+            marco_color(COLOR_VERDE);
+            marco_texto("· ");           // Solución (verde)
+            break;
+        default:
+            marco_texto("  ");           // Camino (espacio)
+            break;
+    }
+}
+
+/*
+ * marco_celda_en
+ * Mueve el cursor a una celda ya dibujada y la reemplaza.
+ * 'linea_base' es la línea de terminal (desde 1) de la fila 0.
+ */
+void marco_celda_en(int linea_base, int fila, int col, int tipo) {
+    marco_formato("\033[%d;%dH", linea_base + fila, COLUMNA_PRIMERA_CELDA + col * ANCHO_CELDA);
+    marco_celda(tipo);
+}
+
+/*
+ * marco_leyenda
+ * Agrega la leyenda de símbolos.
+ */
+void marco_leyenda(int con_solucion) {
+    marco_color(COLOR_VERDE);
+    marco_texto("E");
+    marco_color(COLOR_RESET);
+    marco_texto("=Entrada  ");
+    marco_color(COLOR_ROJO);
+    marco_texto("S");
+    marco_color(COLOR_RESET);
+    marco_texto("=Salida  ");
+    
+    if (con_solucion) {
+        marco_color(COLOR_VERDE);
+        marco_texto("·");
+        marco_color(COLOR_RESET);
+        marco_texto("=Solución  ");
+    } else {
+        marco_texto("  =Camino  ");
+    }
+    
+    marco_color(COLOR_BLANCO);
+    marco_texto(GLIFO_PARED);
+    marco_color(COLOR_RESET);
+    marco_texto("=Pared\n\n");
+}
+
+/*
+ * marco_region
+ * Agrega las filas [f0, f1) y columnas [c0, c1) con bordes al cuadro.
+ * 'marcas' (por nodo, o NULL) indica celdas de solución a superponer.
+ */
+static void marco_region(laberinto* lab, const unsigned char* marcas,
+                         int f0, int f1, int c0, int c1) {
+    // Borde superior
+    marco_texto("  ");
+    marco_color(COLOR_BLANCO);
+    for (int j = c0; j < c1; j++) {
+        marco_texto(GLIFO_PARED GLIFO_PARED);  // Dos caracteres por celda
+    }
+    marco_texto(GLIFO_PARED "\n");
+    
+    for (int i = f0; i < f1; i++) {
+        marco_texto("  ");
+        marco_color(COLOR_BLANCO);
+        marco_texto(GLIFO_PARED);             // Borde izquierdo
+        
+        for (int j = c0; j < c1; j++) {
+            int tipo = lab->celdas[i][j];
+            
+            // La solución no tapa entrada ni salida
+            if (marcas != NULL && marcas[i * COLUMNAS + j] && tipo != INICIO && tipo != FINAL) {
+                tipo = SOLUCION;
+            }
+            marco_celda(tipo);
+        }
+        
+        marco_color(COLOR_BLANCO);
+        marco_texto(GLIFO_PARED "\n");        // Borde derecho
+    }
+    
+    // Borde inferior
+    marco_texto("  ");
+    marco_color(COLOR_BLANCO);
+    for (int j = c0; j < c1; j++) {
+        marco_texto(GLIFO_PARED GLIFO_PARED);
+    }
+    marco_texto(GLIFO_PARED "\n");
+    marco_color(COLOR_RESET);
+}
+
+/*
+ * marco_laberinto
+ * Agrega la rejilla completa con bordes al cuadro.
+ */
+void marco_laberinto(laberinto* lab, const unsigned char* marcas) {
+    marco_region(lab, marcas, 0, lab->filas, 0, lab->columnas);
+}
+
+/*
+ * recortar_ventana
+ * Calcula el inicio de una ventana de 'tam' centrada en 'foco'
+ * sin salirse de [0, total). Ajusta 'tam' si el total es menor.
+ */
+int recortar_ventana(int foco, int* tam, int total) {
+    if (*tam > total) *tam = total;
+    if (*tam < 1) *tam = 1;
+    
+    int inicio = foco - *tam / 2;
+    if (inicio > total - *tam) inicio = total - *tam;
+    if (inicio < 0) inicio = 0;
+    return inicio;
+}
+
+/*
+ * marco_ventana
+ * Agrega solo la ventana de alto x ancho celdas alrededor del foco.
+ * El costo depende del tamaño de la ventana, no del laberinto.
+ */
+void marco_ventana(laberinto* lab, const unsigned char* marcas,
+                   int fila_foco, int col_foco, int alto, int ancho) {
+    int f0 = recortar_ventana(fila_foco, &alto, lab->filas);
+    int c0 = recortar_ventana(col_foco, &ancho, lab->columnas);
+    
+    marco_formato("Ventana: filas %d-%d, columnas %d-%d (foco %d,%d)\n",
+                  f0, f0 + alto - 1, c0, c0 + ancho - 1, fila_foco, col_foco);
+    marco_region(lab, marcas, f0, f0 + alto, c0, c0 + ancho);
+}
+
+/*
+ * contar_bits
+ * Cuenta bits en 1 de una palabra de 64 bits en paralelo (SWAR).
+ */
+static int contar_bits(uint64_t x) {
+    x = x - ((x >> 1) & 0x5555555555555555ULL);
+    x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+    x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return (int)((x * 0x0101010101010101ULL) >> 56);
+}
+
+/*
+ * contar_rango
+ * Cuenta bits en 1 de las columnas [c0, c1) de una fila de palabras.
+ */
+static int contar_rango(const uint64_t* palabras, int c0, int c1) {
+    int total = 0;
+    
+    while (c0 < c1) {
+        int palabra = c0 / 64;
+        int desde = c0 % 64;
+        int hasta = (c1 - palabra * 64 < 64) ? c1 - palabra * 64 : 64;
+        
+        uint64_t mascara = (hasta == 64) ? ~0ULL : ((1ULL << hasta) - 1);
+        mascara &= ~0ULL << desde;
+        total += contar_bits(palabras[palabra] & mascara);
+        
+        c0 = palabra * 64 + hasta;
+    }
+    return total;
+}
+
+/*
+ * crear_mapa_vista
+ * Paredes como bits (una palabra cubre 64 columnas) y posición de la
+ * entrada y la salida. Retorna NULL si falta memoria.
+ */
+mapa_vista* crear_mapa_vista(laberinto* lab) {
+    mapa_vista* mapa = (mapa_vista*)reservar_memoria(MEM_PANTALLA, sizeof(mapa_vista));
+    if (!mapa) return NULL;
+    mapa->paredes = (uint64_t*)reservar_memoria_cero(MEM_PANTALLA, (size_t)FILAS * PALABRAS_FILA,
+                                                     sizeof(uint64_t));
+    if (!mapa->paredes) {
+        liberar_memoria(mapa);
+        return NULL;
+    }
+    mapa->fila_inicio = mapa->col_inicio = -1;
+    mapa->fila_final = mapa->col_final = -1;
+    
+    for (int i = 0; i < lab->filas; i++) {
+        uint64_t* fila = mapa->paredes + (size_t)i * PALABRAS_FILA;
+        for (int j = 0; j < lab->columnas; j++) {
+            int tipo = lab->celdas[i][j];
+            if (tipo == PARED) {
+                fila[j / 64] |= 1ULL << (j % 64);
+            } else if (tipo == INICIO && mapa->fila_inicio < 0) {
+                mapa->fila_inicio = i;
+                mapa->col_inicio = j;
+            } else if (tipo == FINAL && mapa->fila_final < 0) {
+                mapa->fila_final = i;
+                mapa->col_final = j;
+            }
+        }
+    }
+    return mapa;
+}
+
+/*
+ * destruir_mapa_vista
+ * Libera el mapa de crear_mapa_vista (admite NULL).
+ */
+void destruir_mapa_vista(mapa_vista* mapa) {
+    if (mapa == NULL) return;
+    liberar_memoria(mapa->paredes);
+    liberar_memoria(mapa);
+}
+
+/*
+ * en_bloque
+ * Indica si la celda (fila, col) cae en las filas [f0, f1) y columnas [c0, c1).
+ */
+static int en_bloque(int fila, int col, int f0, int f1, int c0, int c1) {
+    return fila >= f0 && fila < f1 && col >= c0 && col < c1;
+}
+
+/*
+ * marco_vista_general
+ * Agrega una vista reducida: cada bloque de k x k celdas es un símbolo
+ * según su densidad de paredes. Entrada y salida se muestran encima.
+ * El mapa sale de crear_mapa_vista y no se recorre el laberinto.
+ */
+void marco_vista_general(laberinto* lab, const mapa_vista* mapa, int bloque) {
+    static const char* densidades[] = {"  ", "░░", "▒▒", "▓▓", "██"};
+    
+    if (bloque < 1) bloque = 1;
+    
+    int filas_bloque = (lab->filas + bloque - 1) / bloque;
+    int columnas_bloque = (lab->columnas + bloque - 1) / bloque;
+    
+    marco_formato("Vista general: bloques de %d x %d (%d x %d)\n",
+                  bloque, bloque, filas_bloque, columnas_bloque);
+    
+    for (int bi = 0; bi < filas_bloque; bi++) {
+        int f0 = bi * bloque;
+        int f1 = (f0 + bloque < lab->filas) ? f0 + bloque : lab->filas;
+        
+        marco_texto("  ");
+        for (int bj = 0; bj < columnas_bloque; bj++) {
+            int c0 = bj * bloque;
+            int c1 = (c0 + bloque < lab->columnas) ? c0 + bloque : lab->columnas;
+            int cuenta = 0;
+            
+            for (int i = f0; i < f1; i++) {
+                cuenta += contar_rango(mapa->paredes + (size_t)i * PALABRAS_FILA, c0, c1);
+            }
+            
+            // Entrada y salida tienen prioridad sobre la densidad; si las
+            // dos caen en el bloque gana la primera en orden de filas
+            int hay_inicio = en_bloque(mapa->fila_inicio, mapa->col_inicio, f0, f1, c0, c1);
+            int hay_final = en_bloque(mapa->fila_final, mapa->col_final, f0, f1, c0, c1);
+            int especial = CAMINO;
+            if (hay_inicio && hay_final) {
+                int antes = mapa->fila_inicio * COLUMNAS + mapa->col_inicio <
+                            mapa->fila_final * COLUMNAS + mapa->col_final;
+                especial = antes ? INICIO : FINAL;
+            } else if (hay_inicio) {
+                especial = INICIO;
+            } else if (hay_final) {
+                especial = FINAL;
+            }
+            
+            if (especial != CAMINO) {
+                marco_celda(especial);
+            } else {
+                int nivel = (cuenta * 4 + (f1 - f0) * (c1 - c0) - 1) / ((f1 - f0) * (c1 - c0));
+                marco_color(COLOR_BLANCO);
+                marco_texto(densidades[nivel]);
+            }
+        }
+        marco_color(COLOR_RESET);
+        marco_texto("\n");
+    }
+}
+
+/*
+ * tamano_terminal
+ * Obtiene filas y columnas de la terminal (24 x 80 si no se puede).
+ */
+void tamano_terminal(int* filas, int* columnas) {
+    struct winsize ventana;
+    
+    *filas = 24;
+    *columnas = 80;
+    if (ioctl(STDOUT_FILENO, TIOCGWINSZ, &ventana) == 0 && ventana.ws_row > 0) {
+        *filas = ventana.ws_row;
+        *columnas = ventana.ws_col;
+    }
+}
+
+/*
+ * celdas_visibles
+ * Celdas que caben en la terminal dejando 'lineas_reservadas' libres.
+ */
+void celdas_visibles(int lineas_reservadas, int* alto, int* ancho) {
+    int filas, columnas;
+    
+    tamano_terminal(&filas, &columnas);
+    *alto = filas - lineas_reservadas - 2;                       // Sin bordes
+    *ancho = (columnas - COLUMNA_PRIMERA_CELDA - 2) / ANCHO_CELDA;
+    if (*alto < 1) *alto = 1;
+    if (*ancho < 1) *ancho = 1;
+}
+
+// ==================== SALIDA ====================
+
+/*
+ * volcar_marco
+ * Escribe el cuadro completo con una sola llamada a write.
+ * Vacía antes stdout para respetar el orden con printf.
+ */
+void volcar_marco(void) {
+    size_t escritos = 0;
+    
+    marco_color(COLOR_RESET);   // La terminal queda en color normal
+    fflush(stdout);
+    
+    while (escritos < marco.usados) {
+        ssize_t n = write(STDOUT_FILENO, marco.datos + escritos, marco.usados - escritos);
+        if (n <= 0) break;      // Error de escritura: se descarta el resto
+        escritos += (size_t)n;
+    }
+    marco.usados = 0;
+}
+
+// ==================== RELOJ ====================
+
+/*
+ * tiempo_monotonico_ms
+ * Milisegundos de un reloj que no retrocede (CLOCK_MONOTONIC).
+ */
+long tiempo_monotonico_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+/*
+ * dormir_hasta_ms
+ * Duerme hasta el instante indicado del reloj monotónico.
+ * Retorna de inmediato si el instante ya pasó.
+ */
+void dormir_hasta_ms(long instante) {
+    long restante = instante - tiempo_monotonico_ms();
+    if (restante <= 0) return;
+    
+    struct timespec espera;
+    espera.tv_sec = restante / 1000;
+    espera.tv_nsec = (restante % 1000) * 1000000;
+    while (nanosleep(&espera, &espera) != 0) {
+        // Interrumpido por una señal: continúa con lo que falta
+    }
+}
+
+/*
+ * marcar_camino
+ * Marca en 'marcas' (una entrada por nodo) los nodos del camino.
+ */
+void marcar_camino(unsigned char* marcas, int* camino, int longitud) {
+    memset(marcas, 0, MAX_NODOS);
+    for (int i = 0; i < longitud; i++) {
+        marcas[camino[i]] = 1;
+    }
+}
@@ -0,0 +1,84 @@
+/*
+ * pantalla.h
+ * Renderizado de laberintos en terminal con un solo buffer por cuadro.
+ * Arma todo el texto en memoria y lo escribe con una sola llamada.
+ */
+
+#ifndef PANTALLA_H
+#define PANTALLA_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "laberinto.h"
+
+// ============================================================================
+// BUFFER DE CUADRO
+// ============================================================================
+
+#define CAPACIDAD_INICIAL_MARCO 16384   // Bytes iniciales del buffer
+
+// Disposición de la rejilla: sangría de 2 columnas + borde, 2 columnas por celda
+#define COLUMNA_PRIMERA_CELDA 4
+#define ANCHO_CELDA 2
+
+#define PALABRAS_FILA ((COLUMNAS + 63) / 64)   // Palabras de 64 bits por fila
+
+/*
+ * marco_pantalla - Buffer reutilizable de un cuadro de terminal
+ * Recuerda el último color emitido para no repetir secuencias ANSI.
+ */
+typedef struct {
+    char* datos;                // Bytes del cuadro
+    size_t usados;              // Bytes ocupados
+    size_t capacidad;           // Bytes reservados
+    const char* color_actual;   // Último color emitido
+} marco_pantalla;
+
+/*
+ * mapa_vista - Lo que la vista general necesita del laberinto
+ * Se arma una vez por laberinto (hay que rehacerlo si cambian las
+ * celdas) y se reutiliza en cada cuadro.
+ */
+typedef struct mapa_vista {
+    uint64_t* paredes;          // FILAS filas de PALABRAS_FILA palabras
+    int fila_inicio, col_inicio;    // Entrada (-1 si no hay)
+    int fila_final, col_final;      // Salida (-1 si no hay)
+} mapa_vista;
+
+// ============================================================================
+// PROTOTIPOS DE FUNCIONES
+// ============================================================================
+
+/* Construcción del cuadro */
+void iniciar_marco(void);
+void marco_texto(const char* texto);
+void marco_formato(const char* formato, ...);
+void marco_color(const char* color);
+void marco_celda(int tipo);
+void marco_laberinto(laberinto* lab, const unsigned char* marcas);
+void marco_ventana(laberinto* lab, const unsigned char* marcas,
+                   int fila_foco, int col_foco, int alto, int ancho);
+void marco_vista_general(laberinto* lab, const mapa_vista* mapa, int bloque);
+void marco_leyenda(int con_solucion);
+void marco_celda_en(int linea_base, int fila, int col, int tipo);
+
+/* Vista general */
+mapa_vista* crear_mapa_vista(laberinto* lab);
+void destruir_mapa_vista(mapa_vista* mapa);
+
+/* Salida */
+void volcar_marco(void);
+
+/* Terminal */
+void tamano_terminal(int* filas, int* columnas);
+void celdas_visibles(int lineas_reservadas, int* alto, int* ancho);
+
+/* Reloj para animaciones */
+long tiempo_monotonico_ms(void);
+void dormir_hasta_ms(long instante);
+
+/* Auxiliares */
+void marcar_camino(unsigned char* marcas, int* camino, int longitud);
+int recortar_ventana(int foco, int* tam, int total);
+
+#endif // PANTALLA_H
@@ -0,0 +1,474 @@
+/*
+ * paquete.c
+ * Archivo único con sección de datos de solo-agregar e índice.
+ * Lectura con una apertura y un mmap para todo el paquete.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "paquete.h"
+#include "archivos.h"
+#include "memoria.h"
+
+// ==================== FUNCIONES AUXILIARES ====================
+
+/*
+ * hash_nombre
+ * Calcula hash FNV-1a de 32 bits de un nombre.
+ * Se usa para ordenar y buscar en el índice.
+ */
+uint32_t hash_nombre(const char* nombre) {
+    uint32_t hash = 2166136261u;  // Base FNV
+
+    for (const unsigned char* p = (const unsigned char*)nombre; *p; p++) {
+        hash ^= *p;              // Mezcla byte
+        hash *= 16777619u;       // Primo FNV
+    }
+
+    return hash;
+}
+
+/*
+ * comparar_entradas
+ * Función de comparación para qsort y búsqueda.
+ * Ordena por hash y luego por nombre.
+ */
+static int comparar_entradas(const void* a, const void* b) {
+    const entrada_paquete* ea = (const entrada_paquete*)a;
+    const entrada_paquete* eb = (const entrada_paquete*)b;
+
+    if (ea->hash != eb->hash) return (ea->hash < eb->hash) ? -1 : 1;
+    return strcmp(ea->nombre, eb->nombre);
+}
+
+/*
+ * comparar_entradas_recientes
+ * Como comparar_entradas, pero entre nombres iguales pone primero la
+ * copia más nueva (los datos solo se agregan, así que es el mayor offset).
+ */
+static int comparar_entradas_recientes(const void* a, const void* b) {
+    int orden = comparar_entradas(a, b);
+    if (orden != 0) return orden;
+
+    uint64_t oa = ((const entrada_paquete*)a)->offset;
+    uint64_t ob = ((const entrada_paquete*)b)->offset;
+    return (oa > ob) ? -1 : (oa < ob);
+}
+
+// ==================== LECTURA ====================
+
+/*
+ * abrir_paquete
+ * Abre y mapea un paquete completo en memoria.
+ * Valida cabecera e índice antes de retornarlo.
+ */
+paquete* abrir_paquete(const char* ruta) {
+    int descriptor = open(ruta, O_RDONLY);  // Una sola apertura
+    if (descriptor < 0) return NULL;
+
+    struct stat info;
+    if (fstat(descriptor, &info) != 0 || (size_t)info.st_size < sizeof(cabecera_paquete)) {
+        close(descriptor);
+        return NULL;
+    }
+
+    size_t tamano = (size_t)info.st_size;
+    void* mapa = mmap(NULL, tamano, PROT_READ, MAP_PRIVATE, descriptor, 0);
+    if (mapa == MAP_FAILED) {
+        close(descriptor);
+        return NULL;
+    }
+
+    const cabecera_paquete* cabecera = (const cabecera_paquete*)mapa;
+
+    // Verifica magia, versión y que el índice esté alineado y quepa en el archivo
+    if (memcmp(cabecera->magia, MAGIA_PAQUETE, 8) != 0 ||
+        cabecera->version != VERSION_PAQUETE ||
+        cabecera->offset_indice < sizeof(cabecera_paquete) ||
+        cabecera->offset_indice % ALINEACION_INDICE != 0 ||
+        cabecera->offset_indice > tamano ||
+        (tamano - cabecera->offset_indice) / sizeof(entrada_paquete) < cabecera->num_entradas) {
+        munmap(mapa, tamano);
+        close(descriptor);
+        return NULL;
+    }
+
+    paquete* paq = (paquete*)reservar_memoria(MEM_PAQUETES, sizeof(paquete));
+    if (!paq) {
+        munmap(mapa, tamano);
+        close(descriptor);
+        return NULL;
+    }
+
+    paq->descriptor = descriptor;
+    paq->mapa = (const unsigned char*)mapa;
+    paq->tamano = tamano;
+    paq->cabecera = cabecera;
+    paq->indice = (const entrada_paquete*)(paq->mapa + cabecera->offset_indice);
+
+    return paq;
+}
+
+/*
+ * cerrar_paquete
+ * Libera el mapeo y el descriptor del paquete.
+ * Acepta NULL sin hacer nada.
+ */
+void cerrar_paquete(paquete* paq) {
+    if (paq) {
+        munmap((void*)paq->mapa, paq->tamano);  // Libera mapeo
+        close(paq->descriptor);                 // Cierra archivo
+        liberar_memoria(paq);
+    }
+}
+
+/*
+ * buscar_en_paquete
+ * Busca un laberinto por nombre con búsqueda binaria.
+ * Retorna NULL si no está en el índice.
+ */
+const entrada_paquete* buscar_en_paquete(paquete* paq, const char* nombre) {
+    entrada_paquete clave;
+
+    memset(&clave, 0, sizeof(clave));
+    strncpy(clave.nombre, nombre, MAX_NOMBRE - 1);  // Nombre a buscar
+    clave.hash = hash_nombre(clave.nombre);
+
+    return (const entrada_paquete*)bsearch(&clave, paq->indice,
+                                           paq->cabecera->num_entradas,
+                                           sizeof(entrada_paquete), comparar_entradas);
+}
+
+/*
+ * cargar_de_paquete
+ * Crea un laberinto a partir de una entrada del índice.
+ * Copia las celdas directamente desde el mapa, sin parsear.
+ */
+laberinto* cargar_de_paquete(paquete* paq, const entrada_paquete* entrada) {
+    // Valida dimensiones y límites de los datos
+    if (entrada->filas == 0 || entrada->filas > FILAS ||
+        entrada->columnas == 0 || entrada->columnas > COLUMNAS ||
+        entrada->tamano != (uint64_t)entrada->filas * entrada->columnas ||
+        entrada->offset < sizeof(cabecera_paquete) ||
+        entrada->offset + entrada->tamano > paq->cabecera->offset_indice) {
+        return NULL;
+    }
+
+    laberinto* lab = (laberinto*)reservar_memoria(MEM_LABERINTO, sizeof(laberinto));
+    if (!lab) return NULL;
+
+    memset(lab, 0, sizeof(laberinto));  // Celdas fuera de rango como pared
+    memcpy(lab->nombre, entrada->nombre, MAX_NOMBRE);
+    lab->nombre[MAX_NOMBRE - 1] = '\0';
+    lab->filas = (int)entrada->filas;
+    lab->columnas = (int)entrada->columnas;
+    lab->tiene_solucion = entrada->tiene_solucion;
+    lab->pasos_solucion = entrada->pasos_solucion;
+
+    const unsigned char* datos = paq->mapa + entrada->offset;  // Celdas en el mapa
+
+    for (int i = 0; i < lab->filas; i++) {
+        for (int j = 0; j < lab->columnas; j++) {
+            lab->celdas[i][j] = datos[i * lab->columnas + j];  // Un byte por celda
+        }
+    }
+
+    return lab;
+}
+
+/*
+ * listar_paquete
+ * Muestra todas las entradas del índice con sus metadatos.
+ * No toca la sección de datos.
+ */
+void listar_paquete(paquete* paq) {
+    uint32_t total = paq->cabecera->num_entradas;
+
+    printf(COLOR_CYAN "\n=== LABERINTOS EN PAQUETE ===\n" COLOR_RESET);
+
+    for (uint32_t i = 0; i < total; i++) {
+        const entrada_paquete* e = &paq->indice[i];
+        printf("%u. %s (%ux%u, solución: %s, pasos: %d)\n",
+               i + 1, e->nombre, e->filas, e->columnas,
+               e->tiene_solucion ? "SÍ" : "NO", e->pasos_solucion);
+    }
+
+    if (total == 0) {
+        printf("El paquete está vacío.\n");
+    } else {
+        printf("\nTotal: %u laberintos\n", total);
+    }
+}
+
+// ==================== ESCRITURA ====================
+
+/*
+ * leer_indice_existente
+ * Lee cabecera e índice de un paquete abierto para escritura.
+ * Retorna el índice en memoria dinámica (o NULL si está vacío).
+ */
+static entrada_paquete* leer_indice_existente(FILE* archivo, cabecera_paquete* cabecera,
+                                              int capacidad_extra) {
+    entrada_paquete* indice = (entrada_paquete*)reservar_memoria(MEM_PAQUETES,
+        (cabecera->num_entradas + capacidad_extra) * sizeof(entrada_paquete));
+    if (!indice) return NULL;
+
+    if (cabecera->num_entradas > 0) {
+        if (fseek(archivo, (long)cabecera->offset_indice, SEEK_SET) != 0 ||
+            fread(indice, sizeof(entrada_paquete), cabecera->num_entradas, archivo) !=
+                cabecera->num_entradas) {
+            liberar_memoria(indice);
+            return NULL;
+        }
+    }
+
+    return indice;
+}
+
+/*
+ * escribir_indice
+ * Alinea el fin de los datos, escribe el índice y lo lleva a disco antes
+ * de tocar la cabecera: si algo falla a mitad, la cabecera vieja sigue
+ * apuntando a un índice intacto.
+ */
+static int escribir_indice(FILE* archivo, cabecera_paquete* cabecera,
+                           const entrada_paquete* indice, uint32_t num_entradas,
+                           uint64_t fin_datos) {
+    static const unsigned char ceros[ALINEACION_INDICE];
+    uint64_t offset_indice = (fin_datos + ALINEACION_INDICE - 1) /
+                             ALINEACION_INDICE * ALINEACION_INDICE;
+
+    if (fseek(archivo, (long)fin_datos, SEEK_SET) != 0 ||
+        fwrite(ceros, 1, offset_indice - fin_datos, archivo) != offset_indice - fin_datos ||
+        fwrite(indice, sizeof(entrada_paquete), num_entradas, archivo) != num_entradas ||
+        fflush(archivo) != 0 || fsync(fileno(archivo)) != 0) {
+        return 0;
+    }
+
+    cabecera->num_entradas = num_entradas;
+    cabecera->offset_indice = offset_indice;
+    return fseek(archivo, 0, SEEK_SET) == 0 &&
+           fwrite(cabecera, sizeof(*cabecera), 1, archivo) == 1 &&
+           fflush(archivo) == 0 && fsync(fileno(archivo)) == 0;
+}
+
+/*
+ * agregar_laberintos_a_paquete
+ * Agrega varios laberintos tras el fin del archivo (el índice viejo no
+ * se pisa) y reescribe el índice una sola vez; nombres repetidos se
+ * reemplazan. Las copias reemplazadas y los índices viejos quedan como
+ * bytes muertos; cuando superan a los vivos el paquete se compacta.
+ */
+int agregar_laberintos_a_paquete(const char* ruta, laberinto** labs, int cantidad) {
+    cabecera_paquete cabecera;
+    FILE* archivo = fopen(ruta, "r+b");  // Paquete existente
+
+    if (archivo != NULL) {
+        if (fread(&cabecera, sizeof(cabecera), 1, archivo) != 1 ||
+            memcmp(cabecera.magia, MAGIA_PAQUETE, 8) != 0 ||
+            cabecera.version != VERSION_PAQUETE) {
+            printf("Error: %s no es un paquete de laberintos válido\n", ruta);
+            fclose(archivo);
+            return 0;
+        }
+    } else {
+        archivo = fopen(ruta, "w+b");  // Paquete nuevo
+        if (archivo == NULL) {
+            printf("Error: No se pudo crear el paquete %s\n", ruta);
+            return 0;
+        }
+        memset(&cabecera, 0, sizeof(cabecera));
+        memcpy(cabecera.magia, MAGIA_PAQUETE, 8);
+        cabecera.version = VERSION_PAQUETE;
+        cabecera.offset_indice = sizeof(cabecera_paquete);
+        fwrite(&cabecera, sizeof(cabecera), 1, archivo);   // Paquete vacío válido
+    }
+
+    entrada_paquete* indice = leer_indice_existente(archivo, &cabecera, cantidad);
+    if (!indice) {
+        fclose(archivo);
+        return 0;
+    }
+
+    uint32_t num_entradas = cabecera.num_entradas;
+    unsigned char fila_bytes[COLUMNAS];       // Buffer de una fila
+    int ok = fseek(archivo, 0, SEEK_END) == 0;
+    long fin = ftell(archivo);
+    uint64_t offset = (fin < 0) ? 0 : (uint64_t)fin;   // Datos nuevos tras el índice viejo
+    if (fin < 0) ok = 0;
+
+    for (int k = 0; k < cantidad && ok; k++) {
+        laberinto* lab = labs[k];
+        entrada_paquete* nueva = &indice[num_entradas++];
+
+        memset(nueva, 0, sizeof(*nueva));
+        snprintf(nueva->nombre, sizeof(nueva->nombre), "%s", lab->nombre);
+        nueva->hash = hash_nombre(nueva->nombre);
+        nueva->filas = (uint32_t)lab->filas;
+        nueva->columnas = (uint32_t)lab->columnas;
+        nueva->tiene_solucion = lab->tiene_solucion;
+        nueva->pasos_solucion = lab->pasos_solucion;
+        nueva->offset = offset;
+        nueva->tamano = (uint64_t)lab->filas * lab->columnas;
+
+        // Escribe las celdas como bytes, fila por fila
+        for (int i = 0; i < lab->filas && ok; i++) {
+            for (int j = 0; j < lab->columnas; j++) {
+                fila_bytes[j] = (unsigned char)lab->celdas[i][j];
+            }
+            ok = fwrite(fila_bytes, 1, lab->columnas, archivo) == (size_t)lab->columnas;
+        }
+        offset += nueva->tamano;
+    }
+
+    // Ordena viejas y nuevas juntas y deja la copia más reciente de cada nombre
+    uint64_t vivos = 0;
+    uint32_t unicas = 0;
+    qsort(indice, num_entradas, sizeof(entrada_paquete), comparar_entradas_recientes);
+    for (uint32_t k = 0; k < num_entradas; k++) {
+        if (unicas > 0 && comparar_entradas(&indice[unicas - 1], &indice[k]) == 0) continue;
+        indice[unicas++] = indice[k];
+        vivos += indice[k].tamano;
+    }
+
+    ok = ok && escribir_indice(archivo, &cabecera, indice, unicas, offset);
+    if (fclose(archivo) != 0) ok = 0;
+    liberar_memoria(indice);
+
+    // Compacta cuando los bytes que ya no referencia el índice (copias
+    // reemplazadas, índices viejos) superan a los vivos
+    uint64_t datos = offset - sizeof(cabecera_paquete);
+    if (ok && datos > 2 * vivos && !compactar_paquete(ruta)) {
+        printf("Aviso: no se pudo compactar %s\n", ruta);
+    }
+
+    return ok;
+}
+
+/*
+ * agregar_a_paquete
+ * Agrega un solo laberinto al paquete.
+ * Wrapper de agregar_laberintos_a_paquete.
+ */
+int agregar_a_paquete(const char* ruta, laberinto* lab) {
+    return agregar_laberintos_a_paquete(ruta, &lab, 1);
+}
+
+/*
+ * empaquetar_directorio
+ * Agrega al paquete todos los laberintos .txt del directorio.
+ * Omite los archivos de estadísticas.
+ */
+int empaquetar_directorio(const char* ruta) {
+    DIR* directorio = opendir(DIRECTORIO_LABERINTOS);
+    if (directorio == NULL) {
+        printf("No se pudo abrir el directorio %s\n", DIRECTORIO_LABERINTOS);
+        return 0;
+    }
+
+    int capacidad = 16;    // Capacidad inicial del arreglo
+    int cantidad = 0;
+    laberinto** labs = (laberinto**)reservar_memoria(MEM_PAQUETES, capacidad * sizeof(laberinto*));
+    struct dirent* entrada;
+
+    while (labs && (entrada = readdir(directorio)) != NULL) {
+        size_t largo = strlen(entrada->d_name);
+
+        // Solo .txt que no sean estadísticas
+        if (largo < 5 || strcmp(entrada->d_name + largo - 4, ".txt") != 0 ||
+            strstr(entrada->d_name, "_estadisticas.txt") != NULL) {
+            continue;
+        }
+
+        laberinto* lab = cargar_laberinto(entrada->d_name);
+        if (!lab) continue;
+
+        if (cantidad == capacidad) {
+            capacidad *= 2;
+            laberinto** nuevos = (laberinto**)redimensionar_memoria(MEM_PAQUETES, labs,
+                                                                    capacidad * sizeof(laberinto*));
+            if (!nuevos) {
+                destruir_laberinto(lab);
+                break;
+            }
+            labs = nuevos;
+        }
+        labs[cantidad++] = lab;
+    }
+    closedir(directorio);
+
+    int ok = (labs != NULL) && agregar_laberintos_a_paquete(ruta, labs, cantidad);
+
+    for (int i = 0; i < cantidad; i++) {
+        destruir_laberinto(labs[i]);
+    }
+    liberar_memoria(labs);
+
+    if (ok) printf("Paquete actualizado: %s (%d laberintos agregados)\n", ruta, cantidad);
+    return ok ? cantidad : 0;
+}
+
+/*
+ * compactar_paquete
+ * Copia solo los datos que referencia el índice a "<ruta>.tmp" y lo
+ * renombra sobre el paquete, así que nunca queda un paquete a medias.
+ * Retorna 1 si tuvo éxito.
+ */
+int compactar_paquete(const char* ruta) {
+    paquete* paq = abrir_paquete(ruta);
+    if (!paq) return 0;
+
+    uint32_t total = paq->cabecera->num_entradas;
+    size_t largo = strlen(ruta) + sizeof(".tmp");
+    char* temporal = (char*)reservar_memoria(MEM_PAQUETES, largo);
+    entrada_paquete* indice = (entrada_paquete*)reservar_memoria(MEM_PAQUETES,
+        (total ? total : 1) * sizeof(entrada_paquete));
+    FILE* archivo = NULL;
+
+    if (temporal && indice) {
+        snprintf(temporal, largo, "%s.tmp", ruta);
+        archivo = fopen(temporal, "w+b");
+    }
+    if (!archivo) {
+        liberar_memoria(indice);
+        liberar_memoria(temporal);
+        cerrar_paquete(paq);
+        return 0;
+    }
+
+    cabecera_paquete cabecera = *paq->cabecera;
+    cabecera.num_entradas = 0;
+    cabecera.offset_indice = sizeof(cabecera_paquete);
+    int ok = fwrite(&cabecera, sizeof(cabecera), 1, archivo) == 1;
+    uint64_t offset = sizeof(cabecera_paquete);
+
+    // El orden del índice se conserva: solo cambian los offsets
+    for (uint32_t k = 0; k < total && ok; k++) {
+        const entrada_paquete* vieja = &paq->indice[k];
+        ok = vieja->offset >= sizeof(cabecera_paquete) &&
+             vieja->offset + vieja->tamano <= paq->cabecera->offset_indice &&
+             fwrite(paq->mapa + vieja->offset, 1, vieja->tamano, archivo) == vieja->tamano;
+        indice[k] = *vieja;
+        indice[k].offset = offset;
+        offset += vieja->tamano;
+    }
+
+    ok = ok && escribir_indice(archivo, &cabecera, indice, total, offset);
+    if (fclose(archivo) != 0) ok = 0;
+    cerrar_paquete(paq);
+
+    if (ok) ok = rename(temporal, ruta) == 0;
+    if (!ok) remove(temporal);
+
+    liberar_memoria(indice);
+    liberar_memoria(temporal);
+    return ok;
+}
@@ -0,0 +1,81 @@
+/*
+ * paquete.h
+ * Paquete de laberintos: un solo archivo con datos e índice.
+ * Permite listar y cargar miles de laberintos con un solo mmap.
+ */
+
+#ifndef PAQUETE_H
+#define PAQUETE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "laberinto.h"
+
+// ============================================================================
+// FORMATO DEL PAQUETE
+// ============================================================================
+
+#define MAGIA_PAQUETE "LABPAQ01"
+#define VERSION_PAQUETE 1
+
+/*
+ * cabecera_paquete - Inicio del archivo (enteros en orden nativo)
+ * Los datos van a continuación; el índice queda al final, en un offset
+ * múltiplo de ALINEACION_INDICE para poder leerlo directo del mapa.
+ */
+typedef struct {
+    char magia[8];              // "LABPAQ01"
+    uint32_t version;           // Versión del formato
+    uint32_t num_entradas;      // Entradas en el índice
+    uint64_t offset_indice;     // Posición del índice (= fin de datos)
+} cabecera_paquete;
+
+/*
+ * entrada_paquete - Metadatos de un laberinto dentro del paquete
+ * El índice se guarda ordenado por (hash, nombre).
+ */
+typedef struct {
+    char nombre[MAX_NOMBRE];    // Nombre del laberinto
+    uint32_t hash;              // Hash FNV-1a del nombre
+    uint32_t filas;             // Número de filas
+    uint32_t columnas;          // Número de columnas
+    int32_t tiene_solucion;     // 1 si tiene solución
+    int32_t pasos_solucion;     // Pasos en solución óptima
+    uint64_t offset;            // Posición de las celdas (1 byte por celda)
+    uint64_t tamano;            // Bytes de celdas
+} entrada_paquete;
+
+#define ALINEACION_INDICE offsetof(struct { char c; entrada_paquete e; }, e)  // _Alignof en C99
+
+/*
+ * paquete - Paquete abierto en memoria (solo lectura)
+ */
+typedef struct {
+    int descriptor;                 // Descriptor del archivo
+    const unsigned char* mapa;      // Archivo completo mapeado
+    size_t tamano;                  // Tamaño del mapeo
+    const cabecera_paquete* cabecera;   // Cabecera dentro del mapa
+    const entrada_paquete* indice;      // Índice dentro del mapa
+} paquete;
+
+// ============================================================================
+// PROTOTIPOS DE FUNCIONES
+// ============================================================================
+
+/* Lectura */
+paquete* abrir_paquete(const char* ruta);
+void cerrar_paquete(paquete* paq);
+const entrada_paquete* buscar_en_paquete(paquete* paq, const char* nombre);
+laberinto* cargar_de_paquete(paquete* paq, const entrada_paquete* entrada);
+void listar_paquete(paquete* paq);
+
+/* Escritura (solo se agregan datos al final) */
+int agregar_laberintos_a_paquete(const char* ruta, laberinto** labs, int cantidad);
+int agregar_a_paquete(const char* ruta, laberinto* lab);
+int empaquetar_directorio(const char* ruta);
+int compactar_paquete(const char* ruta);
+
+/* Funciones auxiliares */
+uint32_t hash_nombre(const char* nombre);
+
+#endif // PAQUETE_H
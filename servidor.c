@@ -0,0 +1,729 @@
+/*
+ * servidor.c
+ * Servidor de consultas en un socket Unix con caché LRU.
+ * Cada laberinto se lee y se analiza una vez; las consultas siguientes
+ * usan los campos de distancia y componentes ya calculados.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <string.h>
+#include <strings.h>
+#include <errno.h>
+#include <signal.h>
+#include <unistd.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include "servidor.h"
+#include "archivos.h"
+#include "paquete.h"
+#include "consultas.h"
+#include "distancias.h"
+#include "medicion.h"
+#include "memoria.h"
+
+// ==================== ESTRUCTURAS DERIVADAS ====================
+
+/*
+ * recorrer_anchura
+ * BFS sobre los vecinos de la entrada (ver recorrer_anchura_vecinos).
+ * Desde una pared no se alcanza nada.
+ */
+static void recorrer_anchura(const entrada_cache* e, int origen, int* distancia, int* anterior) {
+    int cola[MAX_NODOS];   // Cola de nodos por visitar
+
+    recorrer_anchura_vecinos(e->vecinos, origen, distancia, anterior, cola);
+    if (e->componente[origen] < 0) distancia[origen] = -1;  // Origen en una pared
+}
+
+/*
+ * preparar_entrada
+ * Calcula vecinos, componentes y los campos de distancia desde
+ * INICIO y hasta FINAL de un laberinto recién cargado.
+ */
+static void preparar_entrada(entrada_cache* e) {
+    laberinto* lab = &e->lab;
+    int fila, col;
+
+    // Vecinos abiertos y paredes
+    calcular_vecinos(lab, e->vecinos);
+    e->paredes = 0;
+    for (int i = 0; i < FILAS; i++) {
+        for (int j = 0; j < COLUMNAS; j++) {
+            int nodo = i * COLUMNAS + j;
+            e->componente[nodo] = -1;
+            if (lab->celdas[i][j] == PARED) {
+                if (i < lab->filas && j < lab->columnas) e->paredes++;
+            } else {
+                e->componente[nodo] = 0;  // Abierta, sin etiquetar todavía
+            }
+        }
+    }
+
+    // Componentes: un BFS por cada celda abierta sin etiqueta
+    int distancia[MAX_NODOS];
+    e->num_componentes = 0;
+    for (int nodo = 0; nodo < MAX_NODOS; nodo++) {
+        if (e->componente[nodo] != 0) continue;
+        e->num_componentes++;
+        recorrer_anchura(e, nodo, distancia, NULL);
+        for (int v = 0; v < MAX_NODOS; v++) {
+            if (distancia[v] >= 0) e->componente[v] = e->num_componentes;
+        }
+    }
+
+    // Campos de distancia de la entrada y la salida
+    buscar_celda(lab, INICIO, &fila, &col);
+    e->nodo_inicio = fila * COLUMNAS + col;
+    buscar_celda(lab, FINAL, &fila, &col);
+    e->nodo_final = fila * COLUMNAS + col;
+    recorrer_anchura(e, e->nodo_inicio, e->distancia_inicio, e->anterior_inicio);
+    preparar_campo_distancias(lab);
+
+    lab->tiene_solucion = (e->distancia_inicio[e->nodo_final] >= 0);
+    lab->pasos_solucion = lab->tiene_solucion ? e->distancia_inicio[e->nodo_final] : 0;
+}
+
+// ==================== CARGA DESDE DISCO ====================
+
+/*
+ * cargar_origen
+ * Busca el nombre en DIRECTORIO_LABERINTOS (con o sin .txt) y luego
+ * en el paquete. Deja en origen el archivo usado y su mtime.
+ */
+static int cargar_origen(const char* nombre, laberinto* lab, char* origen,
+                         struct stat* info, const char** error) {
+    char ruta[MAX_RUTA_ORIGEN];
+
+    if (nombre[0] == '\0' || nombre[0] == '.' || strchr(nombre, '/') != NULL ||
+        strlen(nombre) >= MAX_NOMBRE) {
+        *error = "nombre inválido";
+        return 0;
+    }
+
+    // Archivo de texto
+    snprintf(ruta, sizeof(ruta), "%s%s", DIRECTORIO_LABERINTOS, nombre);
+    if (stat(ruta, info) != 0 || !S_ISREG(info->st_mode)) {
+        snprintf(ruta, sizeof(ruta), "%s%s.txt", DIRECTORIO_LABERINTOS, nombre);
+    }
+    if (stat(ruta, info) == 0 && S_ISREG(info->st_mode)) {
+        size_t tamano;
+        char* datos = leer_archivo_completo(ruta, &tamano);
+        if (datos == NULL) {
+            *error = "no se pudo leer el archivo";
+            return 0;
+        }
+        int ok = parsear_laberinto_texto(datos, tamano, lab, error);
+        liberar_memoria(datos);
+        if (!ok) return 0;
+        strcpy(origen, ruta);
+        return 1;
+    }
+
+    // Entrada del paquete
+    if (stat(ARCHIVO_PAQUETE, info) == 0) {
+        paquete* paq = abrir_paquete(ARCHIVO_PAQUETE);
+        const entrada_paquete* entrada = paq ? buscar_en_paquete(paq, nombre) : NULL;
+        laberinto* cargado = entrada ? cargar_de_paquete(paq, entrada) : NULL;
+        if (paq != NULL) cerrar_paquete(paq);
+        if (cargado != NULL) {
+            memcpy(lab, cargado, sizeof(laberinto));
+            destruir_laberinto(cargado);
+            strcpy(origen, ARCHIVO_PAQUETE);
+            return 1;
+        }
+    }
+
+    *error = "laberinto no encontrado";
+    return 0;
+}
+
+/*
+ * origen_vigente
+ * Compara mtime y tamaño actuales del origen con los de la carga.
+ */
+static int origen_vigente(const entrada_cache* e) {
+    struct stat info;
+
+    if (stat(e->origen, &info) != 0) return 0;
+    return info.st_mtim.tv_sec == e->modificado.tv_sec &&
+           info.st_mtim.tv_nsec == e->modificado.tv_nsec &&
+           (long long)info.st_size == e->tamano_origen;
+}
+
+// ==================== CACHÉ LRU ====================
+
+/*
+ * crear_cache_laberintos / destruir_cache_laberintos
+ */
+cache_laberintos* crear_cache_laberintos(int capacidad) {
+    cache_laberintos* cache = (cache_laberintos*)reservar_memoria_cero(MEM_SERVIDOR, 1,
+                                                                       sizeof(cache_laberintos));
+    if (!cache) return NULL;
+
+    cache->entradas = (entrada_cache*)reservar_memoria_cero(MEM_SERVIDOR, (size_t)capacidad,
+                                                            sizeof(entrada_cache));
+    if (!cache->entradas) {
+        liberar_memoria(cache);
+        return NULL;
+    }
+    cache->capacidad = capacidad;
+    return cache;
+}
+
+void destruir_cache_laberintos(cache_laberintos* cache) {
+    if (cache) {
+        liberar_memoria(cache->entradas);
+        liberar_memoria(cache);
+    }
+}
+
+/*
+ * obtener_de_cache
+ * Retorna la entrada del nombre, cargándola si falta o si su origen
+ * cambió. Al llenarse desaloja la usada hace más tiempo.
+ */
+entrada_cache* obtener_de_cache(cache_laberintos* cache, const char* nombre,
+                                const char** error) {
+    uint32_t hash = hash_nombre(nombre);
+    entrada_cache* destino = NULL;     // Entrada a (re)cargar
+    entrada_cache* libre = NULL;       // Primera entrada sin uso
+    entrada_cache* antigua = NULL;     // Menos usada recientemente
+
+    for (int i = 0; i < cache->capacidad; i++) {
+        entrada_cache* e = &cache->entradas[i];
+        if (!e->en_uso) {
+            if (libre == NULL) libre = e;
+            continue;
+        }
+        if (e->hash == hash && strcmp(e->clave, nombre) == 0) {
+            if (origen_vigente(e)) {
+                cache->aciertos++;
+                e->ultimo_uso = ++cache->reloj;
+                return e;
+            }
+            destino = e;  // Archivo modificado: se recarga en su lugar
+            break;
+        }
+        if (antigua == NULL || e->ultimo_uso < antigua->ultimo_uso) antigua = e;
+    }
+
+    // Carga primero: un nombre inexistente no debe desalojar nada
+    laberinto lab;
+    char origen[MAX_RUTA_ORIGEN];
+    struct stat info;
+    if (!cargar_origen(nombre, &lab, origen, &info, error)) {
+        if (destino != NULL) {
+            destino->en_uso = 0;  // El origen desapareció o quedó inválido
+            cache->ocupadas--;
+        }
+        return NULL;
+    }
+    cache->fallos++;
+
+    if (destino == NULL) {
+        destino = libre ? libre : antigua;
+        if (destino->en_uso) {
+            cache->desalojos++;
+        } else {
+            cache->ocupadas++;
+        }
+    }
+
+    destino->en_uso = 1;
+    strcpy(destino->clave, nombre);
+    destino->hash = hash;
+    destino->ultimo_uso = ++cache->reloj;
+    strcpy(destino->origen, origen);
+    destino->modificado = info.st_mtim;
+    destino->tamano_origen = (long long)info.st_size;
+    destino->lab = lab;
+    preparar_entrada(destino);
+    return destino;
+}
+
+/*
+ * olvidar_de_cache
+ * Quita un nombre de la caché; retorna 1 si estaba.
+ */
+static int olvidar_de_cache(cache_laberintos* cache, const char* nombre) {
+    uint32_t hash = hash_nombre(nombre);
+
+    for (int i = 0; i < cache->capacidad; i++) {
+        entrada_cache* e = &cache->entradas[i];
+        if (e->en_uso && e->hash == hash && strcmp(e->clave, nombre) == 0) {
+            e->en_uso = 0;
+            cache->ocupadas--;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// ==================== PROTOCOLO ====================
+
+/*
+ * respuesta_servidor - Línea de respuesta que crece según haga falta
+ */
+typedef struct {
+    char* datos;
+    size_t usados;
+    size_t capacidad;
+} respuesta_servidor;
+
+static void responder(respuesta_servidor* r, const char* formato, ...) {
+    va_list args;
+
+    for (;;) {
+        size_t libre = r->capacidad - r->usados;
+        va_start(args, formato);
+        int n = vsnprintf(r->datos + r->usados, libre, formato, args);
+        va_end(args);
+        if (n < 0) return;
+        if ((size_t)n < libre) {
+            r->usados += (size_t)n;
+            return;
+        }
+        char* mayor = (char*)redimensionar_memoria(MEM_SERVIDOR, r->datos, r->capacidad * 2);
+        if (mayor == NULL) return;  // Se envía truncada
+        r->datos = mayor;
+        r->capacidad *= 2;
+    }
+}
+
+/*
+ * responder_camino
+ * "OK <pasos> f,c f,c ..." a partir de un arreglo de nodos.
+ */
+static void responder_camino(respuesta_servidor* r, const int* nodos, int longitud) {
+    responder(r, "OK %d", longitud - 1);
+    for (int k = 0; k < longitud; k++) {
+        responder(r, " %d,%d", nodos[k] / COLUMNAS, nodos[k] % COLUMNAS);
+    }
+}
+
+/*
+ * leer_celda
+ * Convierte dos tokens fila y columna en un nodo abierto.
+ */
+static int leer_celda(const entrada_cache* e, const char* fila, const char* col, int* nodo) {
+    char* fin_f;
+    char* fin_c;
+
+    if (fila == NULL || col == NULL) return 0;
+    long f = strtol(fila, &fin_f, 10);
+    long c = strtol(col, &fin_c, 10);
+    if (*fin_f != '\0' || *fin_c != '\0' || f < 0 || f >= e->lab.filas ||
+        c < 0 || c >= e->lab.columnas) {
+        return 0;
+    }
+    *nodo = (int)(f * COLUMNAS + c);
+    return e->componente[*nodo] >= 0;
+}
+
+/*
+ * consultar_camino
+ * Usa el árbol desde INICIO o el campo hasta FINAL cuando se puede;
+ * si no, un BFS sobre los vecinos ya calculados.
+ */
+static void consultar_camino(respuesta_servidor* r, entrada_cache* e, int origen, int destino) {
+    int nodos[MAX_NODOS];
+    int longitud = 0;
+
+    if (e->componente[origen] != e->componente[destino]) {
+        responder(r, "OK -1");
+        return;
+    }
+
+    if (origen == e->nodo_inicio) {
+        for (int v = destino; v != -1; v = e->anterior_inicio[v]) nodos[longitud++] = v;
+        for (int i = 0; i < longitud / 2; i++) {
+            int t = nodos[i];
+            nodos[i] = nodos[longitud - 1 - i];
+            nodos[longitud - 1 - i] = t;
+        }
+    } else if (destino == e->nodo_final) {
+        longitud = camino_a_salida(&e->lab, origen, nodos);  // Direcciones del campo
+    } else {
+        int distancia[MAX_NODOS], anterior[MAX_NODOS];
+        recorrer_anchura(e, destino, distancia, anterior);  // Árbol hacia el destino
+        for (int v = origen; v != -1; v = anterior[v]) nodos[longitud++] = v;
+    }
+
+    responder_camino(r, nodos, longitud);
+}
+
+/*
+ * servidor_local - Estado de una ejecución del servidor
+ */
+typedef struct {
+    cache_laberintos* cache;        // Laberintos en memoria
+    respuesta_servidor respuesta;   // Buffer de la línea en curso
+    uint64_t consultas;             // Líneas atendidas
+    uint64_t ns_totales;            // Tiempo total atendiendo
+    uint64_t ns_maximo;             // Consulta más lenta
+} servidor_local;
+
+#define ACCION_SEGUIR 0     // Esperar la próxima línea
+#define ACCION_CERRAR 1     // Cerrar esta conexión
+#define ACCION_APAGAR 2     // Detener el servidor
+
+/*
+ * atender_linea
+ * Interpreta una consulta y deja la respuesta (sin '\n') en el buffer.
+ * Comandos: RESOLVER, CAMINO, DISTANCIA, PISTA, ESTADISTICAS, CACHE, OLVIDAR,
+ * AYUDA, SALIR y APAGAR. Los nombres no llevan espacios.
+ */
+static int atender_linea(servidor_local* s, char* linea) {
+    respuesta_servidor* r = &s->respuesta;
+    char* contexto = NULL;
+    const char* error = NULL;
+    char* comando = strtok_r(linea, " \t", &contexto);
+    char* nombre = strtok_r(NULL, " \t", &contexto);
+    char* args[4];
+
+    for (int k = 0; k < 4; k++) args[k] = strtok_r(NULL, " \t", &contexto);
+    r->usados = 0;
+
+    if (comando == NULL) {
+        responder(r, "ERROR línea vacía");
+    } else if (strcasecmp(comando, "SALIR") == 0) {
+        responder(r, "OK adiós");
+        return ACCION_CERRAR;
+    } else if (strcasecmp(comando, "APAGAR") == 0) {
+        responder(r, "OK apagando");
+        return ACCION_APAGAR;
+    } else if (strcasecmp(comando, "AYUDA") == 0) {
+        responder(r, "OK RESOLVER n | CAMINO n f1 c1 f2 c2 | DISTANCIA n f c | PISTA n f c | "
+                     "ESTADISTICAS n | OLVIDAR n | CACHE | SALIR | APAGAR");
+    } else if (strcasecmp(comando, "CACHE") == 0) {
+        cache_laberintos* c = s->cache;
+        responder(r, "OK capacidad=%d ocupadas=%d aciertos=%llu fallos=%llu desalojos=%llu "
+                     "consultas=%llu latencia_media_us=%.2f latencia_max_us=%.2f",
+                  c->capacidad, c->ocupadas, (unsigned long long)c->aciertos,
+                  (unsigned long long)c->fallos, (unsigned long long)c->desalojos,
+                  (unsigned long long)s->consultas,
+                  s->consultas ? s->ns_totales / 1000.0 / s->consultas : 0.0,
+                  s->ns_maximo / 1000.0);
+    } else if (strcasecmp(comando, "OLVIDAR") != 0 && strcasecmp(comando, "RESOLVER") != 0 &&
+               strcasecmp(comando, "CAMINO") != 0 && strcasecmp(comando, "DISTANCIA") != 0 &&
+               strcasecmp(comando, "PISTA") != 0 && strcasecmp(comando, "ESTADISTICAS") != 0) {
+        responder(r, "ERROR comando desconocido: %s", comando);
+    } else if (nombre == NULL) {
+        responder(r, "ERROR falta el nombre del laberinto");
+    } else if (strcasecmp(comando, "OLVIDAR") == 0) {
+        responder(r, olvidar_de_cache(s->cache, nombre) ? "OK" : "OK no estaba en caché");
+    } else {
+        entrada_cache* e = obtener_de_cache(s->cache, nombre, &error);
+        int origen, destino;
+
+        if (e == NULL) {
+            responder(r, "ERROR %s", error);
+        } else if (strcasecmp(comando, "RESOLVER") == 0) {
+            consultar_camino(r, e, e->nodo_inicio, e->nodo_final);
+        } else if (strcasecmp(comando, "CAMINO") == 0) {
+            if (!leer_celda(e, args[0], args[1], &origen) ||
+                !leer_celda(e, args[2], args[3], &destino)) {
+                responder(r, "ERROR se esperan dos celdas abiertas: f1 c1 f2 c2");
+            } else {
+                consultar_camino(r, e, origen, destino);
+            }
+        } else if (strcasecmp(comando, "DISTANCIA") == 0) {
+            if (!leer_celda(e, args[0], args[1], &origen)) {
+                responder(r, "ERROR se espera una celda abierta: f c");
+            } else {
+                responder(r, "OK desde_inicio=%d hasta_final=%d componente=%d",
+                          e->distancia_inicio[origen], distancia_a_salida(&e->lab, origen),
+                          e->componente[origen]);
+            }
+        } else if (strcasecmp(comando, "PISTA") == 0) {
+            if (!leer_celda(e, args[0], args[1], &origen)) {
+                responder(r, "ERROR se espera una celda abierta: f c");
+            } else {
+                int direccion = direccion_a_salida(&e->lab, origen);
+                responder(r, "OK %d %s", distancia_a_salida(&e->lab, origen),
+                          nombre_direccion(direccion));
+                if (direccion != SIN_DIRECCION) {
+                    int siguiente = origen + PASO_VECINO(direccion);
+                    responder(r, " %d,%d", siguiente / COLUMNAS, siguiente % COLUMNAS);
+                }
+            }
+        } else {  // ESTADISTICAS
+            int celdas = e->lab.filas * e->lab.columnas;
+            responder(r, "OK nombre=%s filas=%d columnas=%d paredes=%d caminos=%d "
+                         "componentes=%d tiene_solucion=%d pasos=%d",
+                      e->lab.nombre, e->lab.filas, e->lab.columnas, e->paredes,
+                      celdas - e->paredes, e->num_componentes, e->lab.tiene_solucion,
+                      e->lab.pasos_solucion);
+        }
+    }
+
+    return ACCION_SEGUIR;
+}
+
+// ==================== SOCKETS ====================
+
+static volatile sig_atomic_t detener_servidor = 0;
+
+static void manejar_senal(int senal) {
+    (void)senal;
+    detener_servidor = 1;
+}
+
+/*
+ * enviar_todo
+ * write() hasta mandar todos los bytes o fallar.
+ */
+static int enviar_todo(int descriptor, const char* datos, size_t n) {
+    while (n > 0) {
+        ssize_t escritos = write(descriptor, datos, n);
+        if (escritos < 0) {
+            if (errno == EINTR) continue;
+            return 0;
+        }
+        datos += escritos;
+        n -= (size_t)escritos;
+    }
+    return 1;
+}
+
+/*
+ * direccion_socket
+ * Llena la dirección Unix; falla si la ruta no entra en sun_path.
+ */
+static int direccion_socket(const char* ruta, struct sockaddr_un* direccion) {
+    memset(direccion, 0, sizeof(*direccion));
+    direccion->sun_family = AF_UNIX;
+    if (strlen(ruta) >= sizeof(direccion->sun_path)) {
+        fprintf(stderr, "Error: ruta de socket demasiado larga: %s\n", ruta);
+        return 0;
+    }
+    strcpy(direccion->sun_path, ruta);
+    return 1;
+}
+
+/*
+ * cliente_servidor - Conexión abierta y su línea incompleta
+ */
+typedef struct {
+    int descriptor;                 // -1 si el lugar está libre
+    size_t usados;                  // Bytes pendientes en buffer
+    char buffer[BUFFER_CLIENTE];    // Datos recibidos sin '\n' todavía
+} cliente_servidor;
+
+/*
+ * atender_cliente
+ * Lee lo disponible y responde cada línea completa.
+ * Retorna la acción más fuerte pedida por las líneas.
+ */
+static int atender_cliente(servidor_local* s, cliente_servidor* cliente) {
+    ssize_t leidos = read(cliente->descriptor, cliente->buffer + cliente->usados,
+                          BUFFER_CLIENTE - cliente->usados);
+    if (leidos <= 0) {
+        return (leidos < 0 && errno == EINTR) ? ACCION_SEGUIR : ACCION_CERRAR;
+    }
+    cliente->usados += (size_t)leidos;
+
+    size_t inicio = 0;
+    int accion = ACCION_SEGUIR;
+    char* salto;
+    while (accion == ACCION_SEGUIR &&
+           (salto = memchr(cliente->buffer + inicio, '\n', cliente->usados - inicio)) != NULL) {
+        char* linea = cliente->buffer + inicio;
+        *salto = '\0';
+        if (salto > linea && salto[-1] == '\r') salto[-1] = '\0';
+        inicio = (size_t)(salto - cliente->buffer) + 1;
+
+        uint64_t t0 = reloj_ns();
+        accion = atender_linea(s, linea);
+        uint64_t duracion = reloj_ns() - t0;
+        s->consultas++;
+        s->ns_totales += duracion;
+        if (duracion > s->ns_maximo) s->ns_maximo = duracion;
+
+        responder(&s->respuesta, "\n");
+        if (!enviar_todo(cliente->descriptor, s->respuesta.datos, s->respuesta.usados)) {
+            return ACCION_CERRAR;
+        }
+    }
+
+    // Conserva la línea incompleta al principio del buffer
+    memmove(cliente->buffer, cliente->buffer + inicio, cliente->usados - inicio);
+    cliente->usados -= inicio;
+    if (cliente->usados == BUFFER_CLIENTE) {
+        static const char demasiado[] = "ERROR línea demasiado larga\n";
+        enviar_todo(cliente->descriptor, demasiado, sizeof(demasiado) - 1);
+        return ACCION_CERRAR;
+    }
+    return accion;
+}
+
+/*
+ * ejecutar_servidor
+ * Escucha en ruta_socket hasta APAGAR, SIGINT o SIGTERM.
+ * Un solo hilo con poll(); las consultas son cortas y no bloquean.
+ */
+int ejecutar_servidor(const char* ruta_socket, int capacidad) {
+    struct sockaddr_un direccion;
+    struct sigaction accion_senal;
+    servidor_local s;
+
+    if (!direccion_socket(ruta_socket, &direccion)) return 1;
+
+    int escucha = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (escucha < 0) {
+        perror("socket");
+        return 1;
+    }
+    unlink(ruta_socket);  // Socket de una ejecución anterior
+    if (bind(escucha, (struct sockaddr*)&direccion, sizeof(direccion)) != 0 ||
+        listen(escucha, 16) != 0) {
+        perror(ruta_socket);
+        close(escucha);
+        return 1;
+    }
+
+    // SIGINT/SIGTERM terminan el bucle; SIGPIPE no mata al servidor
+    memset(&accion_senal, 0, sizeof(accion_senal));
+    accion_senal.sa_handler = manejar_senal;
+    sigemptyset(&accion_senal.sa_mask);
+    sigaction(SIGINT, &accion_senal, NULL);
+    sigaction(SIGTERM, &accion_senal, NULL);
+    signal(SIGPIPE, SIG_IGN);
+
+    memset(&s, 0, sizeof(s));
+    s.cache = crear_cache_laberintos(capacidad);
+    s.respuesta.capacidad = BUFFER_CLIENTE;
+    s.respuesta.datos = (char*)reservar_memoria(MEM_SERVIDOR, s.respuesta.capacidad);
+    cliente_servidor* clientes = (cliente_servidor*)reservar_memoria(MEM_SERVIDOR,
+        MAX_CLIENTES_SERVIDOR * sizeof(cliente_servidor));
+    if (!s.cache || !s.respuesta.datos || !clientes) {
+        fprintf(stderr, "Error: sin memoria para el servidor\n");
+        detener_servidor = 1;
+    } else {
+        for (int k = 0; k < MAX_CLIENTES_SERVIDOR; k++) clientes[k].descriptor = -1;
+        fprintf(stderr, "Servidor escuchando en %s (caché de %d laberintos)\n",
+                ruta_socket, capacidad);
+    }
+
+    while (!detener_servidor) {
+        struct pollfd eventos[1 + MAX_CLIENTES_SERVIDOR];
+        int indices[1 + MAX_CLIENTES_SERVIDOR];   // Cliente de cada evento
+        int n = 0;
+
+        eventos[n].fd = escucha;
+        eventos[n].events = POLLIN;
+        indices[n++] = -1;
+        for (int k = 0; k < MAX_CLIENTES_SERVIDOR; k++) {
+            if (clientes[k].descriptor < 0) continue;
+            eventos[n].fd = clientes[k].descriptor;
+            eventos[n].events = POLLIN;
+            indices[n++] = k;
+        }
+
+        if (poll(eventos, (nfds_t)n, -1) < 0) {
+            if (errno == EINTR) continue;
+            perror("poll");
+            break;
+        }
+
+        // Conexión nueva: se rechaza si no hay lugar
+        if (eventos[0].revents & POLLIN) {
+            int nuevo = accept(escucha, NULL, NULL);
+            if (nuevo >= 0) {
+                int k;
+                for (k = 0; k < MAX_CLIENTES_SERVIDOR && clientes[k].descriptor >= 0; k++) {}
+                if (k == MAX_CLIENTES_SERVIDOR) {
+                    static const char lleno[] = "ERROR servidor lleno\n";
+                    enviar_todo(nuevo, lleno, sizeof(lleno) - 1);
+                    close(nuevo);
+                } else {
+                    clientes[k].descriptor = nuevo;
+                    clientes[k].usados = 0;
+                }
+            }
+        }
+
+        for (int i = 1; i < n && !detener_servidor; i++) {
+            if (!(eventos[i].revents & (POLLIN | POLLHUP | POLLERR))) continue;
+            cliente_servidor* cliente = &clientes[indices[i]];
+            int accion = atender_cliente(&s, cliente);
+            if (accion != ACCION_SEGUIR) {
+                close(cliente->descriptor);
+                cliente->descriptor = -1;
+            }
+            if (accion == ACCION_APAGAR) detener_servidor = 1;
+        }
+    }
+
+    // Cierre ordenado
+    if (clientes != NULL) {
+        for (int k = 0; k < MAX_CLIENTES_SERVIDOR; k++) {
+            if (clientes[k].descriptor >= 0) close(clientes[k].descriptor);
+        }
+    }
+    close(escucha);
+    unlink(ruta_socket);
+
+    if (s.cache != NULL) {
+        fprintf(stderr, "Servidor detenido: %llu consultas, %llu aciertos, %llu fallos\n",
+                (unsigned long long)s.consultas, (unsigned long long)s.cache->aciertos,
+                (unsigned long long)s.cache->fallos);
+    }
+    liberar_memoria(clientes);
+    liberar_memoria(s.respuesta.datos);
+    destruir_cache_laberintos(s.cache);
+    detener_servidor = 0;
+    return 0;
+}
+
+/*
+ * consultar_servidor
+ * Envía cada línea de entrada y copia su respuesta a salida.
+ * Espera la respuesta antes de mandar la siguiente línea.
+ */
+int consultar_servidor(const char* ruta_socket, FILE* entrada, FILE* salida) {
+    struct sockaddr_un direccion;
+    char linea[BUFFER_CLIENTE];
+    char bloque[BUFFER_CLIENTE];
+
+    if (!direccion_socket(ruta_socket, &direccion)) return 1;
+
+    int descriptor = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (descriptor < 0 ||
+        connect(descriptor, (struct sockaddr*)&direccion, sizeof(direccion)) != 0) {
+        fprintf(stderr, "Error: no hay servidor en %s\n", ruta_socket);
+        if (descriptor >= 0) close(descriptor);
+        return 1;
+    }
+    signal(SIGPIPE, SIG_IGN);
+
+    int abierto = 1;
+    while (abierto && fgets(linea, sizeof(linea), entrada) != NULL) {
+        size_t largo = strlen(linea);
+        if (largo == 0 || (largo == 1 && linea[0] == '\n')) continue;
+        if (linea[largo - 1] != '\n') linea[largo++] = '\n';  // Pisa el '\0'
+        if (!enviar_todo(descriptor, linea, largo)) break;
+
+        // Copia la respuesta hasta su '\n'
+        for (;;) {
+            ssize_t leidos = read(descriptor, bloque, sizeof(bloque));
+            if (leidos < 0 && errno == EINTR) continue;
+            if (leidos <= 0) {
+                abierto = 0;
+                break;
+            }
+            fwrite(bloque, 1, (size_t)leidos, salida);
+            if (bloque[leidos - 1] == '\n') break;
+        }
+    }
+
+    close(descriptor);
+    fflush(salida);
+    return 0;
+}
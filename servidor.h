@@ -0,0 +1,74 @@
+/*
+ * servidor.h
+ * Servidor local en un socket Unix con caché LRU de laberintos.
+ * Responde consultas de una línea sin releer ni reconstruir el grafo.
+ */
+
+#ifndef SERVIDOR_H
+#define SERVIDOR_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <time.h>
+#include "laberinto.h"
+
+// ============================================================================
+// DEFINICIONES DEL SERVIDOR
+// ============================================================================
+
+#define MAX_CLIENTES_SERVIDOR 32       // Conexiones simultáneas
+#define BUFFER_CLIENTE 4096            // Bytes pendientes por conexión
+#define MAX_RUTA_ORIGEN (MAX_NOMBRE + 64)
+
+/*
+ * entrada_cache - Laberinto en memoria con sus estructuras derivadas
+ * Los campos se calculan una vez al cargar y se reusan en cada consulta;
+ * el campo hasta FINAL vive en lab (ver distancias.h).
+ */
+typedef struct {
+    int en_uso;                         // 1 si la entrada tiene datos
+    char clave[MAX_NOMBRE];             // Nombre pedido (archivo o entrada del paquete)
+    uint32_t hash;                      // hash_nombre(clave)
+    uint64_t ultimo_uso;                // Reloj lógico para desalojo LRU
+    char origen[MAX_RUTA_ORIGEN];       // Archivo del que se cargó
+    struct timespec modificado;         // mtime del origen al cargar
+    long long tamano_origen;            // Tamaño del origen al cargar
+    laberinto lab;                      // Celdas y metadatos
+    unsigned char vecinos[MAX_NODOS];   // Bits VECINO_* de cada celda
+    int nodo_inicio;                    // Celda INICIO
+    int nodo_final;                     // Celda FINAL
+    int distancia_inicio[MAX_NODOS];    // Pasos desde INICIO (-1 inalcanzable)
+    int anterior_inicio[MAX_NODOS];     // Árbol BFS desde INICIO
+    int componente[MAX_NODOS];          // Componente conexa (-1 en paredes)
+    int num_componentes;                // Componentes de celdas abiertas
+    int paredes;                        // Celdas de pared
+} entrada_cache;
+
+/*
+ * cache_laberintos - Entradas con desalojo del menos usado recientemente
+ */
+typedef struct {
+    entrada_cache* entradas;    // Arreglo de capacidad entradas
+    int capacidad;              // Entradas reservadas
+    int ocupadas;               // Entradas en uso
+    uint64_t reloj;             // Se incrementa en cada acceso
+    uint64_t aciertos;          // Consultas resueltas desde memoria
+    uint64_t fallos;            // Consultas que cargaron del disco
+    uint64_t desalojos;         // Entradas reemplazadas
+} cache_laberintos;
+
+// ============================================================================
+// PROTOTIPOS DE FUNCIONES
+// ============================================================================
+
+/* Caché */
+cache_laberintos* crear_cache_laberintos(int capacidad);
+void destruir_cache_laberintos(cache_laberintos* cache);
+entrada_cache* obtener_de_cache(cache_laberintos* cache, const char* nombre,
+                                const char** error);
+
+/* Servidor y cliente */
+int ejecutar_servidor(const char* ruta_socket, int capacidad);
+int consultar_servidor(const char* ruta_socket, FILE* entrada, FILE* salida);
+
+#endif // SERVIDOR_H
@@ -0,0 +1,447 @@
+/*
+ * traza.c
+ * Trazas binarias de Dijkstra.
+ * La grabación solo copia eventos a un buffer; el reproductor aplica o
+ * deshace eventos para reconstruir el estado de cualquier iteración.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "traza.h"
+#include "algoritmos.h"
+#include "memoria.h"
+
+// ==================== GRABACIÓN ====================
+
+/*
+ * crear_traza
+ * Crea una traza nueva. Con ruta, los eventos se escriben a ese archivo
+ * en bloques; con ruta NULL quedan todos en memoria.
+ */
+traza_dijkstra* crear_traza(const char* ruta, int num_nodos, int inicio, int fin) {
+    traza_dijkstra* traza = (traza_dijkstra*)reservar_memoria_cero(MEM_TRAZAS, 1,
+                                                                     sizeof(traza_dijkstra));
+    if (!traza) return NULL;
+    
+    memcpy(traza->cabecera.magia, MAGIA_TRAZA, 8);
+    traza->cabecera.num_nodos = num_nodos;
+    traza->cabecera.inicio = inicio;
+    traza->cabecera.fin = fin;
+    
+    traza->capacidad = BUFFER_EVENTOS_TRAZA;
+    traza->eventos = (evento_traza*)reservar_memoria(MEM_TRAZAS,
+                                                     traza->capacidad * sizeof(evento_traza));
+    if (!traza->eventos) {
+        liberar_memoria(traza);
+        return NULL;
+    }
+    
+    if (ruta != NULL) {
+        traza->archivo = fopen(ruta, "wb");
+        if (traza->archivo == NULL) {
+            printf("Error al crear archivo de traza: %s\n", ruta);
+            liberar_memoria(traza->eventos);
+            liberar_memoria(traza);
+            return NULL;
+        }
+        fwrite(&traza->cabecera, sizeof(cabecera_traza), 1, traza->archivo);
+    }
+    
+    return traza;
+}
+
+/*
+ * vaciar_traza
+ * Escribe los eventos en memoria al archivo de la traza.
+ */
+static void vaciar_traza(traza_dijkstra* traza) {
+    if (traza->archivo == NULL || traza->num_eventos == 0) return;
+    
+    fwrite(traza->eventos, sizeof(evento_traza), traza->num_eventos, traza->archivo);
+    traza->num_eventos = 0;
+}
+
+/*
+ * registrar_evento
+ * Agrega un evento. Si el buffer se llena se vacía al archivo,
+ * o crece al doble si la traza es solo en memoria.
+ */
+void registrar_evento(traza_dijkstra* traza, int tipo, int nodo, int distancia,
+                      int anterior, int distancia_previa, int anterior_previo) {
+    if (traza->num_eventos == traza->capacidad) {
+        if (traza->archivo != NULL) {
+            vaciar_traza(traza);
+        } else {
+            size_t nueva = traza->capacidad * 2;
+            evento_traza* eventos = (evento_traza*)redimensionar_memoria(MEM_TRAZAS,
+                                        traza->eventos, nueva * sizeof(evento_traza));
+            if (!eventos) return;   // Sin memoria: se pierde el evento
+            traza->eventos = eventos;
+            traza->capacidad = nueva;
+        }
+    }
+    
+    evento_traza* evento = &traza->eventos[traza->num_eventos++];
+    evento->tipo = tipo;
+    evento->nodo = nodo;
+    evento->distancia = distancia;
+    evento->anterior = anterior;
+    evento->distancia_previa = distancia_previa;
+    evento->anterior_previo = anterior_previo;
+    traza->total_eventos++;
+}
+
+/*
+ * cerrar_traza
+ * Escribe los eventos pendientes y cierra el archivo (si hay).
+ * Retorna 1 si todo se escribió correctamente.
+ */
+int cerrar_traza(traza_dijkstra* traza) {
+    if (traza->archivo == NULL) return 1;
+    
+    vaciar_traza(traza);
+    int ok = (ferror(traza->archivo) == 0);
+    ok = (fclose(traza->archivo) == 0) && ok;
+    traza->archivo = NULL;
+    return ok;
+}
+
+/*
+ * destruir_traza
+ * Libera la traza (cierra el archivo si sigue abierto).
+ */
+void destruir_traza(traza_dijkstra* traza) {
+    if (traza == NULL) return;
+    
+    cerrar_traza(traza);
+    liberar_memoria(traza->eventos);
+    liberar_memoria(traza);
+}
+
+// ==================== LECTURA ====================
+
+/*
+ * evento_valido
+ * Verifica el tipo y que los nodos del evento estén en [0, num_nodos);
+ * los anteriores y el nodo de EVENTO_TERMINAR también pueden ser -1.
+ */
+static int evento_valido(const evento_traza* evento, int num_nodos) {
+    switch (evento->tipo) {
+        case EVENTO_SELECCIONAR:
+            return evento->nodo >= 0 && evento->nodo < num_nodos;
+        case EVENTO_RELAJAR:
+            return evento->nodo >= 0 && evento->nodo < num_nodos &&
+                   evento->anterior >= -1 && evento->anterior < num_nodos &&
+                   evento->anterior_previo >= -1 && evento->anterior_previo < num_nodos;
+        case EVENTO_TERMINAR:
+            return evento->nodo >= -1 && evento->nodo < num_nodos;
+        default:
+            return 0;
+    }
+}
+
+/*
+ * cargar_traza
+ * Lee un archivo de traza completo a memoria para reproducirlo.
+ * Rechaza cabeceras y eventos fuera de rango: el reproductor indexa
+ * sus tablas directamente con esos nodos.
+ */
+traza_dijkstra* cargar_traza(const char* ruta) {
+    FILE* archivo = fopen(ruta, "rb");
+    if (archivo == NULL) {
+        printf("Error al abrir archivo de traza: %s\n", ruta);
+        return NULL;
+    }
+    
+    traza_dijkstra* traza = (traza_dijkstra*)reservar_memoria_cero(MEM_TRAZAS, 1,
+                                                                     sizeof(traza_dijkstra));
+    if (!traza) {
+        fclose(archivo);
+        return NULL;
+    }
+    
+    // Cantidad de eventos según el tamaño del archivo
+    const cabecera_traza* cabecera = &traza->cabecera;
+    long tamano = -1;
+    if (fread(&traza->cabecera, sizeof(cabecera_traza), 1, archivo) == 1 &&
+        fseek(archivo, 0, SEEK_END) == 0) {
+        tamano = ftell(archivo);
+    }
+    
+    if (tamano < (long)sizeof(cabecera_traza) ||
+        (tamano - (long)sizeof(cabecera_traza)) % sizeof(evento_traza) != 0 ||
+        memcmp(cabecera->magia, MAGIA_TRAZA, 8) != 0 ||
+        cabecera->num_nodos <= 0 || cabecera->num_nodos > MAX_NODOS ||
+        cabecera->inicio < 0 || cabecera->inicio >= cabecera->num_nodos ||
+        cabecera->fin < 0 || cabecera->fin >= cabecera->num_nodos ||
+        fseek(archivo, (long)sizeof(cabecera_traza), SEEK_SET) != 0) {
+        printf("Error: el archivo no es una traza válida\n");
+        fclose(archivo);
+        liberar_memoria(traza);
+        return NULL;
+    }
+    
+    size_t cantidad = (size_t)(tamano - (long)sizeof(cabecera_traza)) / sizeof(evento_traza);
+    traza->capacidad = cantidad > 0 ? cantidad : 1;
+    traza->eventos = (evento_traza*)reservar_memoria(MEM_TRAZAS,
+                                                     traza->capacidad * sizeof(evento_traza));
+    if (!traza->eventos) {
+        fclose(archivo);
+        liberar_memoria(traza);
+        return NULL;
+    }
+    
+    traza->num_eventos = fread(traza->eventos, sizeof(evento_traza), cantidad, archivo);
+    traza->total_eventos = traza->num_eventos;
+    fclose(archivo);
+    
+    int valida = (traza->num_eventos == cantidad);
+    for (size_t e = 0; e < traza->num_eventos && valida; e++) {
+        valida = evento_valido(&traza->eventos[e], cabecera->num_nodos);
+    }
+    if (!valida) {
+        printf("Error: la traza tiene eventos incompletos o fuera de rango\n");
+        destruir_traza(traza);
+        return NULL;
+    }
+    
+    return traza;
+}
+
+// ==================== REPRODUCCIÓN ====================
+
+/*
+ * estado_reproduccion - Estado del algoritmo en una posición de la traza
+ */
+typedef struct {
+    int* distancia;           // Distancias en la posición actual
+    int* anterior;            // Anteriores en la posición actual
+    int* visitado;            // Nodos procesados
+    size_t posicion;          // Eventos aplicados [0, posicion)
+    size_t* iteraciones;      // Índice del evento SELECCIONAR de cada iteración
+    int num_iteraciones;      // Iteraciones en la traza
+} estado_reproduccion;
+
+/*
+ * aplicar_evento
+ * Avanza el estado aplicando un evento.
+ */
+static void aplicar_evento(estado_reproduccion* estado, const evento_traza* evento) {
+    if (evento->tipo == EVENTO_SELECCIONAR) {
+        estado->visitado[evento->nodo] = 1;
+    } else if (evento->tipo == EVENTO_RELAJAR) {
+        estado->distancia[evento->nodo] = evento->distancia;
+        estado->anterior[evento->nodo] = evento->anterior;
+    }
+}
+
+/*
+ * deshacer_evento
+ * Retrocede el estado usando los valores previos del evento.
+ */
+static void deshacer_evento(estado_reproduccion* estado, const evento_traza* evento) {
+    if (evento->tipo == EVENTO_SELECCIONAR) {
+        estado->visitado[evento->nodo] = 0;
+    } else if (evento->tipo == EVENTO_RELAJAR) {
+        estado->distancia[evento->nodo] = evento->distancia_previa;
+        estado->anterior[evento->nodo] = evento->anterior_previo;
+    }
+}
+
+/*
+ * ir_a_iteracion
+ * Deja el estado al final de la iteración k (0 = estado inicial).
+ * Solo aplica o deshace los eventos entre la posición actual y la nueva.
+ */
+static void ir_a_iteracion(traza_dijkstra* traza, estado_reproduccion* estado, int k) {
+    size_t destino;
+    
+    if (k <= 0) {
+        destino = 0;
+    } else if (k < estado->num_iteraciones) {
+        destino = estado->iteraciones[k];    // Justo antes de la siguiente selección
+    } else {
+        destino = traza->num_eventos;
+    }
+    
+    while (estado->posicion < destino) {
+        aplicar_evento(estado, &traza->eventos[estado->posicion++]);
+    }
+    while (estado->posicion > destino) {
+        deshacer_evento(estado, &traza->eventos[--estado->posicion]);
+    }
+}
+
+/*
+ * mostrar_iteracion
+ * Describe los eventos de la iteración k como lo hace el modo interactivo.
+ */
+static void mostrar_iteracion(traza_dijkstra* traza, estado_reproduccion* estado, int k) {
+    if (k == 0) {
+        printf("\n" COLOR_CYAN "=== ESTADO INICIAL ===\n" COLOR_RESET);
+        printf("Nodo inicial: %d, Nodo final: %d\n",
+               traza->cabecera.inicio, traza->cabecera.fin);
+        return;
+    }
+    
+    size_t desde = estado->iteraciones[k - 1];
+    size_t hasta = (k < estado->num_iteraciones) ? estado->iteraciones[k] : traza->num_eventos;
+    int actualizados = 0;
+    
+    printf("\n" COLOR_MAGENTA "=== ITERACIÓN %d de %d ===\n" COLOR_RESET, k, estado->num_iteraciones);
+    
+    for (size_t e = desde; e < hasta; e++) {
+        const evento_traza* evento = &traza->eventos[e];
+        
+        if (evento->tipo == EVENTO_SELECCIONAR) {
+            printf("Nodo seleccionado (distancia mínima): %d\n", evento->nodo);
+            printf("Distancia acumulada hasta %d: %d\n", evento->nodo, evento->distancia);
+        } else if (evento->tipo == EVENTO_RELAJAR) {
+            char previa[12];    // Distancia anterior como texto
+            
+            if (evento->distancia_previa == INFINITO) {
+                strcpy(previa, "INF");
+            } else {
+                sprintf(previa, "%d", evento->distancia_previa);
+            }
+            printf("  → Actualizando nodo %d: %s → %d (vía %d)\n",
+                   evento->nodo, previa, evento->distancia, evento->anterior);
+            actualizados++;
+        } else if (evento->tipo == EVENTO_TERMINAR) {
+            printf(COLOR_VERDE "Fin del algoritmo: " COLOR_RESET "nodo %d, destino alcanzado: %s\n",
+                   evento->nodo, (evento->nodo == traza->cabecera.fin) ? "SÍ" : "NO");
+        }
+    }
+    
+    if (actualizados == 0) {
+        printf("  No se actualizaron vecinos en esta iteración\n");
+    }
+}
+
+/*
+ * mostrar_cambios
+ * Tabla solo con los nodos que cambiaron en la iteración k.
+ */
+static void mostrar_cambios(traza_dijkstra* traza, estado_reproduccion* estado, int k) {
+    if (k == 0) {
+        int inicio = traza->cabecera.inicio;
+        imprimir_cambios_dijkstra(estado->distancia, estado->anterior, estado->visitado,
+                                  -1, 0, &inicio, 1);
+        return;
+    }
+    
+    size_t desde = estado->iteraciones[k - 1];
+    size_t hasta = (k < estado->num_iteraciones) ? estado->iteraciones[k] : traza->num_eventos;
+    int* cambiados = (int*)reservar_memoria(MEM_TRAZAS, (hasta - desde) * sizeof(int));
+    int num_cambiados = 0;
+    if (!cambiados) return;
+    
+    for (size_t e = desde; e < hasta; e++) {
+        if (traza->eventos[e].tipo != EVENTO_TERMINAR) {
+            cambiados[num_cambiados++] = traza->eventos[e].nodo;
+        }
+    }
+    
+    imprimir_cambios_dijkstra(estado->distancia, estado->anterior, estado->visitado,
+                              traza->eventos[desde].nodo, k, cambiados, num_cambiados);
+    liberar_memoria(cambiados);
+}
+
+/*
+ * reproducir_traza
+ * Visor interactivo: avanza y retrocede por iteraciones y regenera
+ * la tabla de estado (completa o solo cambios) a pedido.
+ */
+void reproducir_traza(traza_dijkstra* traza) {
+    int n = traza->cabecera.num_nodos;
+    estado_reproduccion estado;
+    char comando[32];               // Entrada del usuario
+    int actual = 0;                 // Iteración mostrada
+    
+    if (traza->total_eventos != traza->num_eventos) {
+        printf("La traza se grabó a archivo; cárguela con cargar_traza para reproducirla\n");
+        return;
+    }
+    
+    estado.distancia = (int*)reservar_memoria(MEM_TRAZAS, n * sizeof(int));
+    estado.anterior = (int*)reservar_memoria(MEM_TRAZAS, n * sizeof(int));
+    estado.visitado = (int*)reservar_memoria_cero(MEM_TRAZAS, n, sizeof(int));
+    estado.iteraciones = (size_t*)reservar_memoria(MEM_TRAZAS,
+                                                   (traza->num_eventos + 1) * sizeof(size_t));
+    if (!estado.distancia || !estado.anterior || !estado.visitado || !estado.iteraciones) {
+        liberar_memoria(estado.distancia);
+        liberar_memoria(estado.anterior);
+        liberar_memoria(estado.visitado);
+        liberar_memoria(estado.iteraciones);
+        return;
+    }
+    
+    // Estado inicial, igual que en Dijkstra
+    for (int i = 0; i < n; i++) {
+        estado.distancia[i] = INFINITO;
+        estado.anterior[i] = -1;
+    }
+    estado.distancia[traza->cabecera.inicio] = 0;
+    estado.posicion = 0;
+    
+    // Índice de iteraciones: una por evento de selección
+    estado.num_iteraciones = 0;
+    for (size_t e = 0; e < traza->num_eventos; e++) {
+        if (traza->eventos[e].tipo == EVENTO_SELECCIONAR) {
+            estado.iteraciones[estado.num_iteraciones++] = e;
+        }
+    }
+    
+    printf("\n" COLOR_CYAN "=== REPRODUCTOR DE TRAZA DIJKSTRA ===\n" COLOR_RESET);
+    printf("Nodos: %d | Eventos: %zu (%zu bytes) | Iteraciones: %d\n",
+           n, traza->num_eventos, traza->num_eventos * sizeof(evento_traza),
+           estado.num_iteraciones);
+    mostrar_iteracion(traza, &estado, 0);
+    
+    do {
+        printf("\n[n] Siguiente  [p] Anterior  [i N] Ir a iteración  [t] Tabla  [c] Cambios\n"
+               "[r A B] Rango de nodos (r sin valores = todos)  [0] Salir: ");
+        if (fgets(comando, sizeof(comando), stdin) == NULL) break;
+        
+        int destino = actual;
+        switch (comando[0]) {
+            case 'n': destino = actual + 1; break;
+            case 'p': destino = actual - 1; break;
+            case 'i': destino = atoi(comando + 1); break;
+            case 't': {
+                int nodo_actual = (actual > 0) ? traza->eventos[estado.iteraciones[actual - 1]].nodo : -1;
+                imprimir_estado_dijkstra(n, estado.distancia, estado.anterior,
+                                         estado.visitado, nodo_actual, actual);
+                continue;
+            }
+            case 'c': {
+                mostrar_cambios(traza, &estado, actual);
+                continue;
+            }
+            case 'r': {
+                int desde, hasta;
+                if (sscanf(comando + 1, "%d %d", &desde, &hasta) == 2 && desde <= hasta) {
+                    establecer_rango_estados(desde, hasta);
+                } else {
+                    establecer_rango_estados(-1, -1);
+                }
+                continue;
+            }
+            default: continue;
+        }
+        
+        if (destino < 0) destino = 0;
+        if (destino > estado.num_iteraciones) destino = estado.num_iteraciones;
+        if (destino == actual) continue;
+        
+        ir_a_iteracion(traza, &estado, destino);
+        actual = destino;
+        mostrar_iteracion(traza, &estado, actual);
+    } while (comando[0] != '0');
+    
+    liberar_memoria(estado.distancia);
+    liberar_memoria(estado.anterior);
+    liberar_memoria(estado.visitado);
+    liberar_memoria(estado.iteraciones);
+}
@@ -0,0 +1,79 @@
+/*
+ * traza.h
+ * Grabación de trazas binarias de Dijkstra y reproductor fuera de línea.
+ * El algoritmo solo agrega eventos; las tablas se regeneran al reproducir.
+ */
+
+#ifndef TRAZA_H
+#define TRAZA_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include "grafo.h"
+
+// ============================================================================
+// FORMATO DE LA TRAZA
+// ============================================================================
+
+#define MAGIA_TRAZA "TRZDIJ01"
+#define BUFFER_EVENTOS_TRAZA 4096      // Eventos en memoria antes de escribir
+
+// Tipos de evento
+#define EVENTO_SELECCIONAR 1   // Nodo extraído con distancia mínima
+#define EVENTO_RELAJAR 2       // Distancia de un vecino mejorada
+#define EVENTO_TERMINAR 3      // Fin del algoritmo (nodo = último elegido o -1)
+
+/*
+ * evento_traza - Un evento del algoritmo (24 bytes)
+ * Guarda también los valores previos para poder retroceder.
+ */
+typedef struct {
+    int32_t tipo;              // EVENTO_*
+    int32_t nodo;              // Nodo afectado
+    int32_t distancia;         // Distancia nueva (o actual al seleccionar)
+    int32_t anterior;          // Anterior nuevo
+    int32_t distancia_previa;  // Distancia antes del evento
+    int32_t anterior_previo;   // Anterior antes del evento
+} evento_traza;
+
+/*
+ * cabecera_traza - Inicio del archivo de traza
+ */
+typedef struct {
+    char magia[8];             // "TRZDIJ01"
+    int32_t num_nodos;         // Nodos del grafo
+    int32_t inicio;            // Nodo inicial
+    int32_t fin;               // Nodo destino
+    int32_t reservado;         // Alineación
+} cabecera_traza;
+
+/*
+ * traza_dijkstra - Traza en grabación o cargada para reproducir
+ * Sin archivo, todos los eventos quedan en memoria (el arreglo crece).
+ * Con archivo, el arreglo es un buffer que se vacía al llenarse.
+ */
+typedef struct {
+    cabecera_traza cabecera;   // Datos del grafo
+    evento_traza* eventos;     // Eventos en memoria
+    size_t num_eventos;        // Eventos en memoria
+    size_t capacidad;          // Capacidad del arreglo
+    size_t total_eventos;      // Eventos registrados en total
+    FILE* archivo;             // Destino (o NULL)
+} traza_dijkstra;
+
+// ============================================================================
+// PROTOTIPOS DE FUNCIONES
+// ============================================================================
+
+/* Grabación */
+traza_dijkstra* crear_traza(const char* ruta, int num_nodos, int inicio, int fin);
+void registrar_evento(traza_dijkstra* traza, int tipo, int nodo, int distancia,
+                      int anterior, int distancia_previa, int anterior_previo);
+int cerrar_traza(traza_dijkstra* traza);
+void destruir_traza(traza_dijkstra* traza);
+
+/* Lectura y reproducción */
+traza_dijkstra* cargar_traza(const char* ruta);
+void reproducir_traza(traza_dijkstra* traza);
+
+#endif // TRAZA_H